@@ -53,6 +53,59 @@
  override the default. In pure ISO mode, anything other than
  SingleThreaded will cause a compiler error.
  
+ SIGLY_SHARD_COUNT			- Number of per-thread lock shards used by MultiThreadedSharded.
+ Defaults to 16.
+ 
+ SIGLY_CACHE_LINE_SIZE		- Cache line size used to pad per-thread data so that threads
+ do not share cache lines. Defaults to 64.
+ 
+ SIGLY_ENABLE_TRACING		- Records the start and end of every emission and slot call, with
+ the signal, the connection, the thread and a timestamp, into a
+ ring of SIGLY_TRACE_BUFFER_SIZE events (default 16384) per thread.
+ Recording takes no lock and does not allocate after a thread's
+ first event. Trace::writeChromeJson() exports the events for
+ chrome://tracing or Perfetto.
+ 
+ SIGLY_ENABLE_RECORDING		- Provides Recorder, which writes the emissions of the signals given
+ to its record() function, with an id, a timestamp and the bytes of
+ their arguments, to a file mapped into memory; and Replayer, which
+ emits the records of such a file again into signals bound to the
+ same ids, spaced as recorded or as fast as possible. Arguments must
+ be trivially copyable, and files are read on the platform that
+ wrote them. In pure ISO mode the file is written when the Recorder
+ is destroyed.
+ 
+ SIGLY_ENABLE_SHARED_MEMORY	- Provides SharedMemoryEmitter and SharedMemoryPump, which carry the
+ emissions of signals to signals of another process through a ring
+ in POSIX shared memory, with the same record() and bind() calls as
+ Recorder and Replayer. Emitting copies the arguments into the ring
+ without a lock or a system call; only waking a pump asleep in
+ wait() takes one (a futex on Linux). Arguments must be trivially
+ copyable. Requires POSIX threads, and -lrt with older C libraries.
+ 
+ SIGLY_THIN_LOCK_SPIN		- Number of times MultiThreadedThin retries a held lock before the
+ waiting thread goes to sleep. Defaults to 100.
+ 
+ SIGLY_THIN_LOCK_DEFLATE_AFTER	- Number of consecutive uncontended releases after which
+ MultiThreadedThin frees its OS mutex. Defaults to 64.
+ 
+ SIGLY_EXTERN_TEMPLATES		- Declares the connection bookkeeping of the default policy and the
+ common signals Signal0<>, Signal1<int>, Signal1<bool>, Signal1<float>
+ and Signal1<double> as extern templates, so that the files including
+ sigly.h do not compile them again. Exactly one file must also define
+ SIGLY_INSTANTIATE_TEMPLATES before including sigly.h to compile them.
+ Other signatures can be shared the same way, after including sigly.h:
+ SIGLY_INSTANCE class sigly::Signal2<int, float>;
+ Extern templates are a C++11 feature that gcc, clang and MSVC also
+ accept in C++03 mode.
+ 
+ SIGLY_ENABLE_REGISTRY		- Links every signal and every object that inherits HasSlots into a
+ process-wide list, guarded by one mutex that is taken when they are
+ created and destroyed. Registry::collect() then sums their
+ connections and memoryUsage() into a MemoryStats, and
+ Registry::visit() reports them one by one. Each object grows by
+ six words.
+ 
  PLATFORM NOTES
  
  Win32						- On Win32, the WIN32 symbol must be #defined. Most mainstream
@@ -97,12 +150,216 @@
  mutex collisions (and hence context switches) only happen if they are
  absolutely essential. However, on some platforms, creating a lot of
  mutexes can slow down the whole OS, so use this option with care.
+ 
+ MultiThreadedSharded		- Like MultiThreadedLocal, but each signal and each object that
+ inherits HasSlots owns SIGLY_SHARD_COUNT mutexes, each on its own
+ cache line. Emitting a signal only locks the shard of the emitting
+ thread, so concurrent emissions of the same signal from different
+ cores neither serialize nor bounce a shared cache line. Connecting
+ and disconnecting lock every shard, which makes them proportionally
+ slower. Each object is about SIGLY_SHARD_COUNT cache lines large, so
+ reserve this policy for hot signals emitted from many threads.
+ 
+ MultiThreadedThin			- Each signal and each object that inherits HasSlots has its own lock,
+ as with MultiThreadedLocal, but the lock is a single atomic word
+ besides the vtable pointer every policy has (two words in all), and it
+ costs nothing to construct or destroy. An OS mutex is only allocated
+ when a thread has to wait for the lock, and it is freed again once the
+ lock has been released SIGLY_THIN_LOCK_DEFLATE_AFTER times without
+ contention. Use it when many short-lived objects are
+ rarely, if ever, locked from two threads at once.
+ 
+ MultiThreadedReadMostly	- For signals that are emitted far more often than they are
+ connected or disconnected. Emission takes no lock and writes no
+ memory shared with other threads: it reads an array of the
+ connections that every change republishes under a sequence
+ counter. Changes lock like MultiThreadedLocal, and the receivers
+ and connections they remove are released only after every
+ emission that started before the change has returned. That
+ waiting makes them much slower. A change made from inside a slot
+ does not wait; what it removed is freed when the outermost
+ emission of that thread returns. A receiver destroyed from inside
+ a slot must therefore not have slots running on other threads.
+ 
+ Lean<policy>				- Wraps any of the above policies and allocates the wrapped mutex only
+ when it is first locked. Signals declared with a Lean policy carry
+ two pointers instead of the mutex. HasSlots<Lean<policy> > is
+ specialised for objects that exist in large numbers and are
+ connected to few signals, see OBJECT SIZES below.
+ 
+ Custom policies must provide lock()/unlock() for exclusive access and
+ lockShared()/unlockShared() for emission; the latter may simply forward
+ to the former.
+ 
+ 
+ 
+ DISCONNECTION AND DESTRUCTION
+ 
+ Locks are always taken in the same order: a signal's lock before the lock
+ of a receiver. Except with MultiThreadedSharded, emission unlocks the signal
+ while each slot runs, so a slot may connect or disconnect slots or destroy
+ receivers, including its own, and other threads may use the signal at the
+ same time. Connections removed during an emission are freed when the last
+ emission of the signal returns.
+ 
+ HasSlots::disconnectAll(), which the HasSlots destructor calls, removes
+ every connection and then waits until the slot calls already running on
+ other threads have returned. It never waits for calls on its own thread.
+ Because base class destructors run after the derived ones, a receiver
+ whose slots use its own members should call disconnectAll() in its
+ own destructor.
+ 
+ For the same reason, copying a receiver does not connect the copy: the
+ HasSlots part is copied before the derived members are, and a signal
+ emitted on another thread meanwhile would call into a half-built object.
+ Once the copy is complete, copy.copyConnections(original) connects it to
+ every slot the original is connected to.
+ 
+ To tear down many receivers at once, HasSlots<policy>::disconnectAll(first,
+ last) and HasSlots<policy>::destroyAll(first, last) take a range of receiver
+ pointers. Each signal connected to any of them is then locked and scanned
+ once, rather than once per receiver.
+ 
+ connect() adds a connection even if the same slot of the same receiver is
+ connected already, and the slot then runs once per connection.
+ connectUnique() skips such duplicates and returns false, and
+ disconnect(receiver, slot) removes one slot without the receiver's others.
+ The first call to either builds a hash index of the signal's connections,
+ after which both take constant time however many receivers are connected.
+ Slots are matched by the bytes of their member function pointer, so name
+ them through the same class in connect() and disconnect().
+ 
+ DISPATCH ORDER
+ 
+ Slots are called in the order they were connected. When that order does not
+ matter, setDispatchOrder(GROUPED_ORDER) keeps together the connections of the
+ same receiver class and signature, so that a signal with many kinds of
+ receivers does not jump between different code for every slot. Emission
+ also fetches the next connection into the cache while a slot runs.
+ 
+ A slot that emits a signal normally runs that signal's slots before it
+ returns, so long cascades of signals nest deeply on the stack. Signals
+ marked with setTrampolined(true) instead queue the emissions made from the
+ slots of other trampolined signals, with copies of their arguments, and the
+ outermost emission runs them one after the other once its own slots have
+ returned: cascades then run breadth first, in constant stack space.
+ Destroying a signal, on any thread, drops the emissions still queued for
+ it, and waits for those that other threads are running.
+ 
+ THREAD AFFINITY
+ 
+ A receiver can be tied to the thread of an EventLoop with moveToEventLoop().
+ Slots connected to it with connect(receiver, slot, QUEUED_CONNECTION) are
+ then posted to that loop, with copies of the arguments, and run when the
+ loop's thread calls processEvents() or exec(). AUTO_CONNECTION calls the slot
+ directly when the signal is emitted on the loop's thread and posts it
+ otherwise, so cross-thread emissions never run the receiver's code on the
+ emitting thread. Destroying a receiver drops the calls still queued for it.
+ 
+ moveToExecutor() ties a receiver to any Executor instead. A Strand runs the
+ calls posted to it one at a time, in order, on the threads of a ThreadPool:
+ the slots of the receivers sharing a strand never overlap and need no lock,
+ while different strands keep every thread of the pool busy. Connect such
+ receivers with QUEUED_CONNECTION or AUTO_CONNECTION; a direct connection
+ still runs the slot on the emitting thread.
+ 
+ BOUNDED QUEUES
+ 
+ The queue of an EventLoop, ThreadPool or Strand grows as long as its calls
+ are posted faster than they run. setQueueBound(capacity, policy) keeps it
+ to capacity calls: BLOCK_EMITTER makes the emitting thread wait for room,
+ DROP_NEWEST drops the call being posted and DROP_OLDEST the oldest queued
+ one. COALESCE keeps at most one call per connection, the latest, in the
+ place of the first, and drops the calls of other connections once full;
+ connect(receiver, slot, mode, key) makes the connections given the same
+ key coalesce together. Destroying or stopping the executor drops the calls
+ of the emitters still waiting for room. Bound a Strand per receiver to
+ bound that receiver alone. queueStats() counts the calls dropped,
+ coalesced and blocked and the most ever queued.
+ 
+ LATENCY BUDGETS
+ 
+ One slow slot delays every slot after it and the code that emitted the
+ signal. A LatencyBudget(microseconds, strikes, pool) given to signals with
+ setLatencyBudget() times their slot calls, and a connection whose slot
+ overruns the budget strikes times in a row is demoted: from then on its
+ calls are posted to the ThreadPool, with copies of the arguments, and the
+ budget emits demoted(signal, receiver). The pool runs a receiver's calls
+ on whichever of its threads is free, possibly several at once. Signals
+ without a budget do not read the clock.
+ 
+ SHARED PAYLOADS
+ 
+ Queued connections copy the arguments of every emission for every receiver.
+ To deliver a large buffer without copying it, emit a Payload: its copies
+ share one reference-counted buffer, which is freed after the last receiver
+ has run. A PayloadPool hands out buffers of one size and takes them back
+ when they are released. Fill a buffer through buffer() before emitting it;
+ once shared it is read-only. A Payload cannot be recorded or sent through
+ shared memory.
+ 
+ PROPERTIES
+ 
+ Property<T> holds a value and emits changed(value) when it is set to a
+ different one, and changedFrom(old, value) for slots that need the previous
+ value too. Setting an equal value emits nothing, so receivers do not redo
+ work for assignments that change nothing. Values are compared with ==, or
+ with the equality given as the third template argument; BitwiseEqual
+ compares the bytes of plain structures.
+ 
+ REACTIVE VALUES
+ 
+ Computed<T> holds a value computed by a member function from Properties,
+ other Computed values or signals given to dependsOn(). A change of an input
+ only marks the values that depend on it dirty. They are recomputed when read
+ with get(), or, for those with slots connected to their changed signal, once
+ the change is over, in dependency order. A value that two inputs share is
+ thus recomputed once, and never sees one input changed and the other not
+ yet. Changes made while a ReactiveBatch exists are propagated together when
+ the outermost batch ends.
+ 
+ TIMERS
+ 
+ A Scheduler emits a signal after a delay, with after(delay, signal, args...),
+ or periodically, with every(period, signal, args...), and returns a
+ TimerHandle that cancel() takes. Time is counted in ticks, one millisecond
+ by default. Drive it with advance(ticks), with update() from a loop of your
+ own, or by calling exec() on a thread of its own. Starting and cancelling a
+ timer take constant time, and timers are reused, so that programs with many
+ timeouts do not allocate for each of them. Cancel the timers of a signal
+ before destroying it.
+ 
+ OBJECT SIZES
+ 
+ HasSlots<SingleThreaded>	- A vtable pointer, an std::set header, a bool, a call
+ counter and an executor pointer.
+ 
+ HasSlots<MultiThreaded*>	- The same plus the policy's mutex (a pthread_mutex_t or
+ CRITICAL_SECTION, 40 bytes on x86-64 Linux), or SIGLY_SHARD_COUNT
+ cache lines for MultiThreadedSharded.
+ 
+ HasSlots<Lean<policy> >		- Exactly two pointers (sizeof(void *) * 2) for every policy, plus
+ the six words of the registry entry when SIGLY_ENABLE_REGISTRY is
+ defined. The first connection allocates one block holding the
+ wrapped policy's mutex, the std::set of senders and the executor; it
+ is released with the object.
+ 
+ Signals report connectionCount() and receivers senderCount(). Both also
+ report memoryUsage(), the bytes they own including the connections and the
+ container nodes, whose size is estimated since it depends on the standard
+ library. Neither call locks the object.
  */
 #ifndef SIGLY_H__
 #define SIGLY_H__
 
 #include <set>
 #include <list>
+#include <map>
+#include <vector>
+#include <algorithm>
+#include <new>
+#include <cstddef>
+#include <cstring>
 
 #if defined(SIGLY_PURE_ISO) || (!defined(WIN32) && !defined(__GNUG__) && !defined(SIGLY_USE_POSIX_THREADS))
 #       define _SIGLY_SINGLE_THREADED
@@ -112,6 +369,7 @@
 #elif defined(__GNUG__) || defined(SIGLY_USE_POSIX_THREADS)
 #       define _SIGLY_HAS_POSIX_THREADS
 #       include <pthread.h>
+#       include <sched.h>
 #else
 #       define _SIGLY_SINGLE_THREADED
 #endif
@@ -124,9 +382,221 @@
 #       endif
 #endif
 
+#ifdef SIGLY_INSTANTIATE_TEMPLATES
+#       define SIGLY_INSTANCE template
+#       ifndef SIGLY_EXTERN_TEMPLATES
+#               define SIGLY_EXTERN_TEMPLATES
+#       endif
+#else
+#       define SIGLY_INSTANCE extern template
+#endif
+
+#ifndef SIGLY_SHARD_COUNT
+#       define SIGLY_SHARD_COUNT 16
+#endif
+
+#ifndef SIGLY_CACHE_LINE_SIZE
+#       define SIGLY_CACHE_LINE_SIZE 64
+#endif
+
+#include <ctime>
+
+#ifdef SIGLY_ENABLE_SHARED_MEMORY
+#       ifndef _SIGLY_HAS_POSIX_THREADS
+#               error SIGLY_ENABLE_SHARED_MEMORY requires POSIX shared memory
+#       endif
+#       ifdef __linux__
+#               include <linux/futex.h>
+#               include <sys/syscall.h>
+#       endif
+#endif
+
+#if defined(SIGLY_ENABLE_RECORDING) || defined(SIGLY_ENABLE_SHARED_MEMORY)
+#       include <cstdio>
+#       include <string>
+#       ifdef _SIGLY_HAS_POSIX_THREADS
+#               include <fcntl.h>
+#               include <sys/mman.h>
+#               include <sys/stat.h>
+#               include <unistd.h>
+#       endif
+#endif
+
+#ifdef SIGLY_ENABLE_TRACING
+#       include <ostream>
+#       ifndef SIGLY_TRACE_BUFFER_SIZE
+#               define SIGLY_TRACE_BUFFER_SIZE 16384
+#       endif
+#       define _SIGLY_TRACE(type, signal, connection) _trace_buffer::record(_trace_buffer::type, signal, connection)
+#else
+#       define _SIGLY_TRACE(type, signal, connection)
+#endif
+
+#ifdef SIGLY_ENABLE_REGISTRY
+#       define _SIGLY_REGISTER(signal) m_entry.link(this, signal, &linksOf, &bytesOf)
+#       define _SIGLY_UNREGISTER() m_entry.unlink()
+#else
+#       define _SIGLY_REGISTER(signal)
+#       define _SIGLY_UNREGISTER()
+#endif
+
+#ifndef SIGLY_THIN_LOCK_SPIN
+#       define SIGLY_THIN_LOCK_SPIN 100
+#endif
+
+#ifndef SIGLY_THIN_LOCK_DEFLATE_AFTER
+#       define SIGLY_THIN_LOCK_DEFLATE_AFTER 64
+#endif
+
+#if defined(_SIGLY_HAS_WIN32_THREADS)
+#       define _SIGLY_THREAD_LOCAL __declspec(thread)
+#elif defined(_SIGLY_HAS_POSIX_THREADS)
+#       define _SIGLY_THREAD_LOCAL __thread
+#else
+#       define _SIGLY_THREAD_LOCAL
+#endif
+
+#if defined(__GNUC__) && !defined(SIGLY_PURE_ISO)
+#       define _SIGLY_PREFETCH(address) __builtin_prefetch(address)
+#else
+#       define _SIGLY_PREFETCH(address)
+#endif
+
 
 namespace sigly {
 	
+	// Atomically increments the value and returns the incremented value.
+	inline long _atomic_increment(volatile long *value) {
+#if defined(_SIGLY_HAS_WIN32_THREADS)
+		return InterlockedIncrement(value);
+#elif defined(_SIGLY_HAS_POSIX_THREADS)
+		return __sync_add_and_fetch(value, 1);
+#else
+		return ++(*value);
+#endif
+	}
+	
+	// Atomically decrements the value and returns the decremented value.
+	inline long _atomic_decrement(volatile long *value) {
+#if defined(_SIGLY_HAS_WIN32_THREADS)
+		return InterlockedDecrement(value);
+#elif defined(_SIGLY_HAS_POSIX_THREADS)
+		return __sync_sub_and_fetch(value, 1);
+#else
+		return --(*value);
+#endif
+	}
+	
+	// Atomically stores desired and returns the previous value. This is a
+	// full barrier.
+	inline long _atomic_exchange(volatile long *target, long desired) {
+#if defined(_SIGLY_HAS_WIN32_THREADS)
+		return InterlockedExchange(target, desired);
+#elif defined(_SIGLY_HAS_POSIX_THREADS) && defined(__ATOMIC_SEQ_CST)
+		return __atomic_exchange_n(target, desired, __ATOMIC_SEQ_CST);
+#elif defined(_SIGLY_HAS_POSIX_THREADS)
+		__sync_synchronize();
+		return __sync_lock_test_and_set(target, desired);
+#else
+		long previous = *target;
+		*target = desired;
+		return previous;
+#endif
+	}
+	
+	// Atomically stores desired and returns the previous pointer. This is a
+	// full barrier.
+	inline void *_atomic_exchange(void *volatile *target, void *desired) {
+#if defined(_SIGLY_HAS_WIN32_THREADS)
+		return InterlockedExchangePointer(target, desired);
+#elif defined(_SIGLY_HAS_POSIX_THREADS) && defined(__ATOMIC_SEQ_CST)
+		return __atomic_exchange_n(target, desired, __ATOMIC_SEQ_CST);
+#elif defined(_SIGLY_HAS_POSIX_THREADS)
+		__sync_synchronize();
+		return __sync_lock_test_and_set(target, desired);
+#else
+		void *previous = *target;
+		*target = desired;
+		return previous;
+#endif
+	}
+	
+	// Atomically replaces *target with desired if it equals expected and
+	// returns the value *target held before the call.
+	inline long _atomic_compare_exchange(volatile long *target, long expected, long desired) {
+#if defined(_SIGLY_HAS_WIN32_THREADS)
+		return InterlockedCompareExchange(target, desired, expected);
+#elif defined(_SIGLY_HAS_POSIX_THREADS)
+		return __sync_val_compare_and_swap(target, expected, desired);
+#else
+		long previous = *target;
+		
+		if (previous == expected) {
+			*target = desired;
+		}
+		
+		return previous;
+#endif
+	}
+	
+	// Atomically replaces *target with desired if it equals expected and
+	// returns the value *target held before the call.
+	inline void *_atomic_compare_exchange(void *volatile *target, void *expected, void *desired) {
+#if defined(_SIGLY_HAS_WIN32_THREADS)
+		return InterlockedCompareExchangePointer(target, desired, expected);
+#elif defined(_SIGLY_HAS_POSIX_THREADS)
+		return __sync_val_compare_and_swap(target, expected, desired);
+#else
+		void *previous = *target;
+		
+		if (previous == expected) {
+			*target = desired;
+		}
+		
+		return previous;
+#endif
+	}
+	
+	// Reads a value written by the other atomic operations.
+	inline long _atomic_load(volatile long const *source) {
+#if defined(_SIGLY_HAS_POSIX_THREADS) && defined(__ATOMIC_ACQUIRE)
+		return __atomic_load_n(source, __ATOMIC_ACQUIRE);
+#elif defined(_SIGLY_HAS_POSIX_THREADS)
+		long value = *source;
+		__sync_synchronize();
+		return value;
+#else
+		return *source;
+#endif
+	}
+	
+	// Reads a pointer published by _atomic_compare_exchange.
+	inline void *_atomic_load(void *volatile const *source) {
+#if defined(_SIGLY_HAS_POSIX_THREADS) && defined(__ATOMIC_ACQUIRE)
+		return __atomic_load_n(source, __ATOMIC_ACQUIRE);
+#elif defined(_SIGLY_HAS_POSIX_THREADS)
+		void *value = *source;
+		__sync_synchronize();
+		return value;
+#else
+		return *source;
+#endif
+	}
+	
+	// Publishes a value to _atomic_load on other threads without a locked
+	// instruction, for values that only the calling thread writes. Volatile
+	// stores already have release semantics with MSVC.
+	inline void _atomic_store(volatile long *target, long value) {
+#if defined(_SIGLY_HAS_POSIX_THREADS) && defined(__ATOMIC_RELEASE)
+		__atomic_store_n(target, value, __ATOMIC_RELEASE);
+#elif defined(_SIGLY_HAS_POSIX_THREADS)
+		__sync_synchronize();
+		*target = value;
+#else
+		*target = value;
+#endif
+	}
+	
 	class SingleThreaded {
 	public:
 		SingleThreaded() {
@@ -140,6 +610,12 @@ namespace sigly {
 		
 		virtual void unlock() {
 		}
+		
+		virtual void lockShared() {
+		}
+		
+		virtual void unlockShared() {
+		}
 	};
 	
 #ifdef _SIGLY_HAS_WIN32_THREADS
@@ -169,6 +645,14 @@ namespace sigly {
 			LeaveCriticalSection(get_critsec());
 		}
 		
+		virtual void lockShared() {
+			lock();
+		}
+		
+		virtual void unlockShared() {
+			unlock();
+		}
+		
 	private:
 		CRITICAL_SECTION *get_critsec() {
 			static CRITICAL_SECTION g_critsec;
@@ -198,9 +682,67 @@ namespace sigly {
 			LeaveCriticalSection(&m_critsec);
 		}
 		
+		virtual void lockShared() {
+			lock();
+		}
+		
+		virtual void unlockShared() {
+			unlock();
+		}
+		
+	private:
+		CRITICAL_SECTION m_critsec;
+	};
+	
+	// Mutex and condition variable pair used internally where a thread has to
+	// sleep until another one signals it.
+	class _monitor {
+	public:
+		_monitor() {
+			InitializeCriticalSection(&m_critsec);
+			InitializeConditionVariable(&m_condition);
+		}
+		
+		~_monitor() {
+			DeleteCriticalSection(&m_critsec);
+		}
+		
+		void lock() {
+			EnterCriticalSection(&m_critsec);
+		}
+		
+		void unlock() {
+			LeaveCriticalSection(&m_critsec);
+		}
+		
+		void wait() {
+			SleepConditionVariableCS(&m_condition, &m_critsec, INFINITE);
+		}
+		
+		// Waits at most the given number of microseconds.
+		void wait(double microseconds) {
+			SleepConditionVariableCS(&m_condition, &m_critsec, (DWORD)(microseconds / 1000.0) + 1);
+		}
+		
+		void notifyOne() {
+			WakeConditionVariable(&m_condition);
+		}
+		
+		void notifyAll() {
+			WakeAllConditionVariable(&m_condition);
+		}
+		
 	private:
+		_monitor(const _monitor &);
+		_monitor &operator=(const _monitor &);
+		
 		CRITICAL_SECTION m_critsec;
+		CONDITION_VARIABLE m_condition;
 	};
+	
+	inline void _thread_yield() {
+		SwitchToThread();
+	}
 #endif // _SIGLY_HAS_WIN32_THREADS
 	
 #ifdef _SIGLY_HAS_POSIX_THREADS
@@ -208,7 +750,6 @@ namespace sigly {
 	class MultiThreadedGlobal {
 	public:
 		MultiThreadedGlobal() {
-			pthread_mutex_init(get_mutex(), NULL);
 		}
 		
 		MultiThreadedGlobal(const MultiThreadedGlobal &) {
@@ -225,8 +766,33 @@ namespace sigly {
 			pthread_mutex_unlock(get_mutex());
 		}
 		
+		virtual void lockShared() {
+			lock();
+		}
+		
+		virtual void unlockShared() {
+			unlock();
+		}
+		
 	private:
-		pthread_mutex_t *get_mutex() {
+		// Initialized once and recursive, like the critical section of the
+		// Windows version, since connecting locks the signal and then the
+		// receiver, which share this mutex.
+		static pthread_mutex_t *get_mutex() {
+			static pthread_once_t once = PTHREAD_ONCE_INIT;
+			pthread_once(&once, &initialize);
+			return mutex();
+		}
+		
+		static void initialize() {
+			pthread_mutexattr_t attributes;
+			pthread_mutexattr_init(&attributes);
+			pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_RECURSIVE);
+			pthread_mutex_init(mutex(), &attributes);
+			pthread_mutexattr_destroy(&attributes);
+		}
+		
+		static pthread_mutex_t *mutex() {
 			static pthread_mutex_t g_mutex;
 			return &g_mutex;
 		}
@@ -254,1861 +820,10964 @@ namespace sigly {
 			pthread_mutex_unlock(&m_mutex);
 		}
 		
+		virtual void lockShared() {
+			lock();
+		}
+		
+		virtual void unlockShared() {
+			unlock();
+		}
+		
 	private:
 		pthread_mutex_t m_mutex;
 	};
-#endif // _SIGLY_HAS_POSIX_THREADS
 	
-	template<class mt_policy>
-	class lock_block {
+	// Mutex and condition variable pair used internally where a thread has to
+	// sleep until another one signals it.
+	class _monitor {
 	public:
-		mt_policy *m_mutex;
+		_monitor() {
+			pthread_mutex_init(&m_mutex, NULL);
+#ifdef __APPLE__
+			pthread_cond_init(&m_condition, NULL);
+#else
+			// Timed waits measure the monotonic clock, so that setting the
+			// time of day neither shortens nor stretches them.
+			pthread_condattr_t attributes;
+			pthread_condattr_init(&attributes);
+			pthread_condattr_setclock(&attributes, CLOCK_MONOTONIC);
+			pthread_cond_init(&m_condition, &attributes);
+			pthread_condattr_destroy(&attributes);
+#endif
+		}
 		
-		lock_block(mt_policy *mtx)
-		: m_mutex(mtx) {
-			m_mutex->lock();
+		~_monitor() {
+			pthread_cond_destroy(&m_condition);
+			pthread_mutex_destroy(&m_mutex);
 		}
 		
-		~lock_block() {
-			m_mutex->unlock();
+		void lock() {
+			pthread_mutex_lock(&m_mutex);
+		}
+		
+		void unlock() {
+			pthread_mutex_unlock(&m_mutex);
+		}
+		
+		void wait() {
+			pthread_cond_wait(&m_condition, &m_mutex);
+		}
+		
+		// Waits at most the given number of microseconds. Whole seconds are
+		// counted apart, so that the nanoseconds fit a 32-bit long.
+		void wait(double microseconds) {
+			time_t seconds = (time_t)(microseconds / 1000000.0);
+			long nanoseconds = (long)((microseconds - (double)seconds * 1000000.0) * 1000.0);
+			timespec deadline;
+#ifdef __APPLE__
+			deadline.tv_sec = seconds;
+			deadline.tv_nsec = nanoseconds;
+			pthread_cond_timedwait_relative_np(&m_condition, &m_mutex, &deadline);
+#else
+			clock_gettime(CLOCK_MONOTONIC, &deadline);
+			deadline.tv_sec += seconds;
+			deadline.tv_nsec += nanoseconds;
+			
+			if (deadline.tv_nsec >= 1000000000L) {
+				deadline.tv_nsec -= 1000000000L;
+				++deadline.tv_sec;
+			}
+			
+			pthread_cond_timedwait(&m_condition, &m_mutex, &deadline);
+#endif
+		}
+		
+		void notifyOne() {
+			pthread_cond_signal(&m_condition);
+		}
+		
+		void notifyAll() {
+			pthread_cond_broadcast(&m_condition);
 		}
+		
+	private:
+		_monitor(const _monitor &);
+		_monitor &operator=(const _monitor &);
+		
+		pthread_mutex_t m_mutex;
+		pthread_cond_t m_condition;
 	};
 	
-	template<class mt_policy>
-	class HasSlots;
+	inline void _thread_yield() {
+		sched_yield();
+	}
+#endif // _SIGLY_HAS_POSIX_THREADS
 	
-	template<class mt_policy>
-	class _connection_base0 {
+#ifdef _SIGLY_SINGLE_THREADED
+	class _monitor {
 	public:
-		virtual ~_connection_base0() {}
-		virtual HasSlots<mt_policy>* getdest() const = 0;
-		virtual void shoot() = 0;
-		virtual _connection_base0 *clone() = 0;
-		virtual _connection_base0 *duplicate(HasSlots<mt_policy>* pnewdest) = 0;
+		void lock() {
+		}
+		
+		void unlock() {
+		}
+		
+		void wait() {
+		}
+		
+		void wait(double) {
+		}
+		
+		void notifyOne() {
+		}
+		
+		void notifyAll() {
+		}
 	};
 	
-	template<class arg1_type, class mt_policy>
-	class _connection_base1 {
-	public:
-		virtual ~_connection_base1() {}
-		virtual HasSlots<mt_policy>* getdest() const = 0;
-		virtual void shoot(arg1_type) = 0;
-		virtual _connection_base1<arg1_type, mt_policy>* clone() = 0;
-		virtual _connection_base1<arg1_type, mt_policy>* duplicate(HasSlots<mt_policy>* pnewdest) = 0;
-	};
+	inline void _thread_yield() {
+	}
+#endif // _SIGLY_SINGLE_THREADED
 	
-	template<class arg1_type, class arg2_type, class mt_policy>
-	class _connection_base2 {
+#ifndef _SIGLY_SINGLE_THREADED
+	// Readers (signal emission) only lock the shard of the calling thread, so
+	// emitting from N threads touches N different cache lines. Writers
+	// (connect, disconnect, copy) lock every shard in order.
+	class MultiThreadedSharded {
 	public:
-		virtual ~_connection_base2() {}
-		virtual HasSlots<mt_policy>* getdest() const = 0;
-		virtual void shoot(arg1_type, arg2_type) = 0;
-		virtual _connection_base2<arg1_type, arg2_type, mt_policy>* clone() = 0;
-		virtual _connection_base2<arg1_type, arg2_type, mt_policy>* duplicate(HasSlots<mt_policy>* pnewdest) = 0;
+		MultiThreadedSharded() {
+			init();
+		}
+		
+		MultiThreadedSharded(const MultiThreadedSharded &) {
+			init();
+		}
+		
+		virtual ~MultiThreadedSharded() {
+			for (int i = 0; i < SIGLY_SHARD_COUNT; ++i) {
+				shard(i)->~MultiThreadedLocal();
+			}
+		}
+		
+		virtual void lock() {
+			for (int i = 0; i < SIGLY_SHARD_COUNT; ++i) {
+				shard(i)->lock();
+			}
+		}
+		
+		virtual void unlock() {
+			for (int i = SIGLY_SHARD_COUNT - 1; i >= 0; --i) {
+				shard(i)->unlock();
+			}
+		}
+		
+		virtual void lockShared() {
+			shard(currentShard())->lock();
+		}
+		
+		virtual void unlockShared() {
+			shard(currentShard())->unlock();
+		}
+		
+		// Index of the shard used by the calling thread. Threads are assigned
+		// shards round-robin the first time they emit.
+		static int currentShard() {
+			static volatile long nextShard = 0;
+			static _SIGLY_THREAD_LOCAL int threadShard = 0;
+			
+			if (threadShard == 0) {
+				threadShard = (int)(_atomic_increment(&nextShard) % SIGLY_SHARD_COUNT) + 1;
+			}
+			
+			return threadShard - 1;
+		}
+		
+	private:
+		void init() {
+			size_t offset = (size_t)m_storage % SIGLY_CACHE_LINE_SIZE;
+			m_shards = m_storage + (offset ? SIGLY_CACHE_LINE_SIZE - offset : 0);
+			
+			for (int i = 0; i < SIGLY_SHARD_COUNT; ++i) {
+				new(shard(i)) MultiThreadedLocal();
+			}
+		}
+		
+		MultiThreadedLocal *shard(int i) {
+			return reinterpret_cast<MultiThreadedLocal *>(m_shards + i * SHARD_SIZE);
+		}
+		
+		enum {
+			SHARD_SIZE = ((sizeof(MultiThreadedLocal) + SIGLY_CACHE_LINE_SIZE - 1) / SIGLY_CACHE_LINE_SIZE) * SIGLY_CACHE_LINE_SIZE
+		};
+		
+		char *m_shards;
+		char m_storage[SIGLY_SHARD_COUNT * SHARD_SIZE + SIGLY_CACHE_LINE_SIZE];
 	};
 	
-	template<class arg1_type, class arg2_type, class arg3_type, class mt_policy>
-	class _connection_base3 {
+	// The whole lock is one word next to the vtable pointer: a lock bit and,
+	// once a thread has had to wait for the lock, the address of a monitor
+	// (an OS mutex and condition variable) with the number of threads using
+	// it in the low bits that the monitor's alignment leaves free. A thread
+	// counts itself in the word before it touches the monitor, and only the
+	// lock holder frees it, when nobody uses it, after
+	// SIGLY_THIN_LOCK_DEFLATE_AFTER uncontended releases counted in the
+	// monitor itself. Objects that are never contended never create an OS
+	// object.
+	class MultiThreadedThin {
+	public:
+		MultiThreadedThin(): m_word(NULL) {
+		}
+		
+		MultiThreadedThin(const MultiThreadedThin &): m_word(NULL) {
+		}
+		
+		virtual ~MultiThreadedThin() {
+			_thin_monitor::destroy(monitorOf(load()));
+		}
+		
+		MultiThreadedThin &operator=(const MultiThreadedThin &) {
+			return *this;
+		}
+		
+		virtual void lock() {
+			if (_atomic_compare_exchange(&m_word, NULL, word(LOCKED)) != NULL) {
+				lockContended();
+			}
+		}
+		
+		virtual void unlock() {
+			for (;;) {
+				std::size_t bits = load();
+				_thin_monitor *monitor = monitorOf(bits);
+				
+				if (monitor == NULL) {
+					if (exchange(bits, 0)) {
+						return;
+					}
+				} else if (users(bits) == 0) {
+					if (++monitor->m_quiet >= SIGLY_THIN_LOCK_DEFLATE_AFTER) {
+						if (exchange(bits, 0)) {
+							_thin_monitor::destroy(monitor);
+							return;
+						}
+					} else if (exchange(bits, bits & ~LOCKED)) {
+						return;
+					}
+					
+					--monitor->m_quiet;
+				} else if (users(bits) == MAX_USERS) {
+					_thread_yield();
+				} else if (exchange(bits, (bits & ~LOCKED) + USER)) {
+					// Counted as a user, so the next holder cannot free
+					// the monitor before the waiters have been woken.
+					monitor->lock();
+					monitor->notifyOne();
+					monitor->unlock();
+					leave();
+					return;
+				}
+			}
+		}
+		
+		virtual void lockShared() {
+			lock();
+		}
+		
+		virtual void unlockShared() {
+			unlock();
+		}
+		
+		// Bytes allocated for the OS mutex, while it is inflated.
+		std::size_t heapSize() const {
+			return monitorOf(load()) != NULL ? _thin_monitor::blockSize() : 0;
+		}
+		
+	private:
+		// A monitor aligned so that the low bits of its address are free.
+		class _thin_monitor : public _monitor {
+		public:
+			enum {
+				ALIGNMENT = 128
+			};
+			
+			static std::size_t blockSize() {
+				return sizeof(_thin_monitor) + ALIGNMENT;
+			}
+			
+			// Throws std::bad_alloc.
+			static _thin_monitor *create() {
+				char *block = static_cast<char *>(::operator new(blockSize()));
+				char *aligned = block + ALIGNMENT - (std::size_t)block % ALIGNMENT;
+				_thin_monitor *monitor = new(aligned) _thin_monitor();
+				monitor->m_block = block;
+				return monitor;
+			}
+			
+			static void destroy(_thin_monitor *monitor) {
+				if (monitor != NULL) {
+					void *block = monitor->m_block;
+					monitor->~_thin_monitor();
+					::operator delete(block);
+				}
+			}
+			
+			// Uncontended releases since the last contended lock; only
+			// touched by the lock holder.
+			long m_quiet;
+			
+		private:
+			_thin_monitor(): m_quiet(0), m_block(NULL) {
+			}
+			
+			void *m_block;
+		};
+		
+		enum {
+			LOCKED = 1,
+			USER = 2,
+			MAX_USERS = _thin_monitor::ALIGNMENT / USER - 1,
+			// Waiters leave room in the count for the releases that wake
+			// them.
+			MAX_WAITERS = MAX_USERS / 2
+		};
+		
+		void lockContended() {
+			for (int i = 0; i < SIGLY_THIN_LOCK_SPIN; ++i) {
+				std::size_t bits = load();
+				
+				if ((bits & LOCKED) == 0 && exchange(bits, bits | LOCKED)) {
+					return;
+				}
+			}
+			
+			_thin_monitor *monitor = join();
+			
+			if (monitor == NULL) {
+				return;
+			}
+			
+			monitor->lock();
+			
+			for (;;) {
+				std::size_t bits = load();
+				
+				if ((bits & LOCKED) != 0) {
+					monitor->wait();
+				} else if (exchange(bits, (bits | LOCKED) - USER)) {
+					break;
+				}
+			}
+			
+			monitor->m_quiet = 0;
+			monitor->unlock();
+		}
+		
+		// Counts the calling thread as a user of the monitor, creating it if
+		// the lock has none yet. Returns NULL if the lock could be taken
+		// instead.
+		_thin_monitor *join() {
+			_thin_monitor *created = NULL;
+			
+			for (;;) {
+				std::size_t bits = load();
+				_thin_monitor *monitor = monitorOf(bits);
+				
+				if ((bits & LOCKED) == 0) {
+					if (exchange(bits, bits | LOCKED)) {
+						_thin_monitor::destroy(created);
+						return NULL;
+					}
+				} else if (monitor == NULL) {
+					if (created == NULL) {
+						created = _thin_monitor::create();
+					}
+					
+					if (exchange(bits, (std::size_t)created | USER | LOCKED)) {
+						return created;
+					}
+				} else if (users(bits) >= MAX_WAITERS) {
+					_thread_yield();
+				} else if (exchange(bits, bits + USER)) {
+					_thin_monitor::destroy(created);
+					return monitor;
+				}
+			}
+		}
+		
+		void leave() {
+			for (;;) {
+				std::size_t bits = load();
+				
+				if (exchange(bits, bits - USER)) {
+					return;
+				}
+			}
+		}
+		
+		std::size_t load() const {
+			return (std::size_t)_atomic_load(&m_word);
+		}
+		
+		bool exchange(std::size_t expected, std::size_t desired) {
+			return _atomic_compare_exchange(&m_word, word(expected), word(desired)) == word(expected);
+		}
+		
+		static void *word(std::size_t bits) {
+			return reinterpret_cast<void *>(bits);
+		}
+		
+		static _thin_monitor *monitorOf(std::size_t bits) {
+			return reinterpret_cast<_thin_monitor *>(bits & ~std::size_t(_thin_monitor::ALIGNMENT - 1));
+		}
+		
+		static std::size_t users(std::size_t bits) {
+			return (bits & (_thin_monitor::ALIGNMENT - 1)) / USER;
+		}
+		
+		void *volatile m_word;
+	};
+
+	// Locks like MultiThreadedLocal for connecting and disconnecting, but
+	// emission takes no lock at all: it reads a copy of the connection list
+	// that every change republishes, see _dispatch_traits.
+	class MultiThreadedReadMostly : public MultiThreadedLocal {
+	};
+#endif // _SIGLY_SINGLE_THREADED
+	
+	// Wraps another policy and only allocates it the first time the lock is
+	// taken, so an object that is never locked costs two pointers.
+	template<class mt_policy>
+	class Lean {
+	public:
+		Lean(): m_mutex(NULL) {
+		}
+		
+		Lean(const Lean &): m_mutex(NULL) {
+		}
+		
+		virtual ~Lean() {
+			delete static_cast<mt_policy *>(m_mutex);
+		}
+		
+		Lean &operator=(const Lean &) {
+			return *this;
+		}
+		
+		virtual void lock() {
+			mutex()->lock();
+		}
+		
+		virtual void unlock() {
+			mutex()->unlock();
+		}
+		
+		virtual void lockShared() {
+			mutex()->lockShared();
+		}
+		
+		virtual void unlockShared() {
+			mutex()->unlockShared();
+		}
+		
+		// Bytes allocated for the wrapped policy, once it has been locked.
+		std::size_t heapSize() const {
+			return _atomic_load(&m_mutex) != NULL ? sizeof(mt_policy) : 0;
+		}
+		
+	private:
+		mt_policy *mutex() {
+			void *current = _atomic_load(&m_mutex);
+			
+			if (current == NULL) {
+				mt_policy *created = new mt_policy();
+				current = _atomic_compare_exchange(&m_mutex, NULL, created);
+				
+				if (current == NULL) {
+					current = created;
+				} else {
+					delete created;
+				}
+			}
+			
+			return static_cast<mt_policy *>(current);
+		}
+		
+		void *volatile m_mutex;
+	};
+	
+	// Bytes a policy allocated on top of its own size.
+	inline std::size_t _heap_size(const void *) {
+		return 0;
+	}
+	
+#ifndef _SIGLY_SINGLE_THREADED
+	inline std::size_t _heap_size(const MultiThreadedThin *policy) {
+		return policy->heapSize();
+	}
+#endif // _SIGLY_SINGLE_THREADED
+	
+	template<class mt_policy>
+	std::size_t _heap_size(const Lean<mt_policy> *policy) {
+		return policy->heapSize();
+	}
+	
+	// Estimated heap size of the nodes of a std::list and a std::set of
+	// pointers: the links (plus the colour, padded, for the set) and the
+	// pointer itself.
+	enum {
+		_LIST_NODE_SIZE = 3 * sizeof(void *),
+		_SET_NODE_SIZE = 5 * sizeof(void *)
+	};
+	
+	// Whether emission releases the signal's lock while each slot runs, which
+	// lets a slot connect, disconnect or destroy receivers (including its own)
+	// and lets other threads use the signal meanwhile. Policies whose emission
+	// lock is shared between emitters keep holding it instead, so that emitting
+	// does not write to memory shared by all emitting threads.
+	//
+	// Published policies go further: emission reads an immutable array of
+	// the connections under a sequence counter and takes no lock, and the
+	// connections a change removes are freed after a grace period during
+	// which every emission that could still see them has ended.
+	template<class mt_policy>
+	struct _dispatch_traits {
+		enum {
+			unlock_during_slots = 1,
+			published = 0
+		};
+	};
+	
+#ifndef _SIGLY_SINGLE_THREADED
+	template<>
+	struct _dispatch_traits<MultiThreadedSharded> {
+		enum {
+			unlock_during_slots = 0,
+			published = 0
+		};
+	};
+	
+	template<>
+	struct _dispatch_traits<MultiThreadedReadMostly> {
+		enum {
+			unlock_during_slots = 0,
+			published = 1
+		};
+	};
+#endif // _SIGLY_SINGLE_THREADED
+	
+	template<class mt_policy>
+	struct _dispatch_traits<Lean<mt_policy> > : public _dispatch_traits<mt_policy> {
+	};
+	
+	template<class mt_policy>
+	class lock_block {
+	public:
+		mt_policy *m_mutex;
+		
+		lock_block(mt_policy *mtx)
+		: m_mutex(mtx) {
+			m_mutex->lock();
+		}
+		
+		~lock_block() {
+			m_mutex->unlock();
+		}
+	};
+	
+	template<class mt_policy>
+	class shared_lock_block {
+	public:
+		mt_policy *m_mutex;
+		
+		shared_lock_block(mt_policy *mtx)
+		: m_mutex(mtx) {
+			m_mutex->lockShared();
+		}
+		
+		~shared_lock_block() {
+			m_mutex->unlockShared();
+		}
+	};
+	
+	// Strips references and top-level const from an argument type so that a
+	// copy of the argument can be stored.
+	template<class T>
+	struct _value_type {
+		typedef T type;
+	};
+	
+	template<class T>
+	struct _value_type<const T> {
+		typedef T type;
+	};
+	
+	template<class T>
+	struct _value_type<T &> {
+		typedef T type;
+	};
+	
+	template<class T>
+	struct _value_type<const T &> {
+		typedef T type;
+	};
+	
+	template<class mt_policy>
+	class HasSlots;
+	
+	class Executor;
+	class EventLoop;
+	
+	template<class mt_policy, class iterator>
+	void _disconnect_receivers(iterator first, iterator last);
+	
+	inline std::size_t _hash_bytes(const void *data, std::size_t size, std::size_t hash) {
+		const unsigned char *bytes = static_cast<const unsigned char *>(data);
+		
+		for (std::size_t i = 0; i < size; ++i) {
+			hash = (hash ^ bytes[i]) * 16777619u;
+		}
+		
+		return hash ^ (hash >> 15);
+	}
+	
+	// Chained hash table of values stored with their hash. A lookup scans
+	// the bucket of a hash for entries with the same hash; comparing the
+	// values themselves is left to the caller.
+	template<class value_type>
+	class _hash_index {
+	public:
+		struct entry {
+			std::size_t hash;
+			value_type value;
+		};
+		
+		typedef std::vector<entry> bucket;
+		
+		_hash_index(): m_buckets(8), m_size(0) {
+		}
+		
+		bucket &at(std::size_t hash) {
+			return m_buckets[hash & (m_buckets.size() - 1)];
+		}
+		
+		void insert(std::size_t hash, const value_type &value) {
+			if (m_size >= m_buckets.size()) {
+				grow();
+			}
+			
+			entry added;
+			added.hash = hash;
+			added.value = value;
+			at(hash).push_back(added);
+			++m_size;
+		}
+		
+		void erase(bucket &from, std::size_t i) {
+			from[i] = from.back();
+			from.pop_back();
+			--m_size;
+		}
+		
+		std::size_t bytes() const {
+			return sizeof(*this) + m_buckets.size() * sizeof(bucket) + m_size * sizeof(entry);
+		}
+		
+	private:
+		void grow() {
+			std::vector<bucket> buckets(m_buckets.size() * 2);
+			buckets.swap(m_buckets);
+			
+			for (typename std::vector<bucket>::const_iterator it = buckets.begin(); it != buckets.end(); ++it) {
+				for (typename bucket::const_iterator e = it->begin(); e != it->end(); ++e) {
+					at(e->hash).push_back(*e);
+				}
+			}
+		}
+		
+		std::vector<bucket> m_buckets;
+		std::size_t m_size;
+	};
+	
+	// What every connection provides regardless of its signature. Signals
+	// keep their connections as _connection_base pointers so that all the
+	// bookkeeping lives in _signal_base, compiled once per policy instead
+	// of once per argument list; only shoot() is typed.
+	template<class mt_policy>
+	class _connection_base {
+	public:
+		virtual ~_connection_base() {}
+		virtual HasSlots<mt_policy>* getdest() const = 0;
+		virtual _connection_base *clone() = 0;
+		virtual _connection_base *duplicate(HasSlots<mt_policy>* pnewdest) = 0;
+		
+		// Size of the connection object, for memoryUsage().
+		virtual std::size_t size() const = 0;
+		
+		// Representation of the member function pointer, which identifies the
+		// slot together with getdest().
+		virtual std::size_t method(const void *&bytes) const = 0;
+		
+		// Identifies the connection class, and so the code shoot() runs, for
+		// GROUPED_ORDER.
+		virtual const void *stub() const = 0;
+		
+		// A connection posting the calls of this one to the worker, which
+		// takes ownership of this one, or NULL if it posts them already.
+		virtual _connection_base *demote(Executor *worker) = 0;
+	};
+	
+	template<class mt_policy>
+	class _demoted_connection0;
+	
+	template<class arg1_type, class mt_policy>
+	class _demoted_connection1;
+	
+	template<class arg1_type, class arg2_type, class mt_policy>
+	class _demoted_connection2;
+	
+	template<class arg1_type, class arg2_type, class arg3_type, class mt_policy>
+	class _demoted_connection3;
+	
+	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class mt_policy>
+	class _demoted_connection4;
+	
+	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class mt_policy>
+	class _demoted_connection5;
+	
+	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class mt_policy>
+	class _demoted_connection6;
+	
+	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class arg7_type, class mt_policy>
+	class _demoted_connection7;
+	
+	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class arg7_type, class arg8_type, class mt_policy>
+	class _demoted_connection8;
+	
+	template<class mt_policy>
+	class _connection_base0 : public _connection_base<mt_policy> {
+	public:
+		virtual void shoot() = 0;
+		
+		virtual _connection_base<mt_policy> *demote(Executor *worker) {
+			return new _demoted_connection0<mt_policy>(this, worker);
+		}
+	};
+	
+	template<class arg1_type, class mt_policy>
+	class _connection_base1 : public _connection_base<mt_policy> {
+	public:
+		virtual void shoot(arg1_type) = 0;
+		
+		virtual _connection_base<mt_policy> *demote(Executor *worker) {
+			return new _demoted_connection1<arg1_type, mt_policy>(this, worker);
+		}
+	};
+	
+	template<class arg1_type, class arg2_type, class mt_policy>
+	class _connection_base2 : public _connection_base<mt_policy> {
+	public:
+		virtual void shoot(arg1_type, arg2_type) = 0;
+		
+		virtual _connection_base<mt_policy> *demote(Executor *worker) {
+			return new _demoted_connection2<arg1_type, arg2_type, mt_policy>(this, worker);
+		}
+	};
+	
+	template<class arg1_type, class arg2_type, class arg3_type, class mt_policy>
+	class _connection_base3 : public _connection_base<mt_policy> {
 	public:
-		virtual ~_connection_base3() {}
-		virtual HasSlots<mt_policy>* getdest() const = 0;
 		virtual void shoot(arg1_type, arg2_type, arg3_type) = 0;
-		virtual _connection_base3<arg1_type, arg2_type, arg3_type, mt_policy>* clone() = 0;
-		virtual _connection_base3<arg1_type, arg2_type, arg3_type, mt_policy>* duplicate(HasSlots<mt_policy>* pnewdest) = 0;
+		
+		virtual _connection_base<mt_policy> *demote(Executor *worker) {
+			return new _demoted_connection3<arg1_type, arg2_type, arg3_type, mt_policy>(this, worker);
+		}
 	};
 	
 	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class mt_policy>
-	class _connection_base4 {
+	class _connection_base4 : public _connection_base<mt_policy> {
 	public:
-		virtual ~_connection_base4() {}
-		virtual HasSlots<mt_policy>* getdest() const = 0;
 		virtual void shoot(arg1_type, arg2_type, arg3_type, arg4_type) = 0;
-		virtual _connection_base4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>* clone() = 0;
-		virtual _connection_base4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>* duplicate(HasSlots<mt_policy>* pnewdest) = 0;
+		
+		virtual _connection_base<mt_policy> *demote(Executor *worker) {
+			return new _demoted_connection4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>(this, worker);
+		}
 	};
 	
 	template < class arg1_type, class arg2_type, class arg3_type, class arg4_type,
 	class arg5_type, class mt_policy >
-	class _connection_base5 {
+	class _connection_base5 : public _connection_base<mt_policy> {
 	public:
-		virtual ~_connection_base5() {}
-		virtual HasSlots<mt_policy>* getdest() const = 0;
 		virtual void shoot(arg1_type, arg2_type, arg3_type, arg4_type,
 		                   arg5_type) = 0;
-		virtual _connection_base5 < arg1_type, arg2_type, arg3_type, arg4_type,
-		arg5_type, mt_policy > * clone() = 0;
-		virtual _connection_base5 < arg1_type, arg2_type, arg3_type, arg4_type,
-		arg5_type, mt_policy > * duplicate(HasSlots<mt_policy>* pnewdest) = 0;
+		
+		virtual _connection_base<mt_policy> *demote(Executor *worker) {
+			return new _demoted_connection5<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy>(this, worker);
+		}
+	};
+	
+	template < class arg1_type, class arg2_type, class arg3_type, class arg4_type,
+	class arg5_type, class arg6_type, class mt_policy >
+	class _connection_base6 : public _connection_base<mt_policy> {
+	public:
+		virtual void shoot(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type,
+		                   arg6_type) = 0;
+		
+		virtual _connection_base<mt_policy> *demote(Executor *worker) {
+			return new _demoted_connection6<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy>(this, worker);
+		}
+	};
+	
+	template < class arg1_type, class arg2_type, class arg3_type, class arg4_type,
+	class arg5_type, class arg6_type, class arg7_type, class mt_policy >
+	class _connection_base7 : public _connection_base<mt_policy> {
+	public:
+		virtual void shoot(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type,
+		                   arg6_type, arg7_type) = 0;
+		
+		virtual _connection_base<mt_policy> *demote(Executor *worker) {
+			return new _demoted_connection7<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy>(this, worker);
+		}
+	};
+	
+	template < class arg1_type, class arg2_type, class arg3_type, class arg4_type,
+	class arg5_type, class arg6_type, class arg7_type, class arg8_type, class mt_policy >
+	class _connection_base8 : public _connection_base<mt_policy> {
+	public:
+		virtual void shoot(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type,
+		                   arg6_type, arg7_type, arg8_type) = 0;
+		
+		virtual _connection_base<mt_policy> *demote(Executor *worker) {
+			return new _demoted_connection8<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy>(this, worker);
+		}
+	};
+	
+	// Microseconds from an arbitrary origin.
+	inline double _now() {
+#if defined(_SIGLY_HAS_WIN32_THREADS)
+		// The frequency is fixed at boot. Each thread reads it once, so the
+		// cache needs no synchronization.
+		static _SIGLY_THREAD_LOCAL double microsecondsPerCount = 0.0;
+		LARGE_INTEGER counter;
+		
+		if (microsecondsPerCount == 0.0) {
+			LARGE_INTEGER frequency;
+			QueryPerformanceFrequency(&frequency);
+			microsecondsPerCount = 1000000.0 / (double)frequency.QuadPart;
+		}
+		
+		QueryPerformanceCounter(&counter);
+		return (double)counter.QuadPart * microsecondsPerCount;
+#elif defined(_SIGLY_HAS_POSIX_THREADS)
+		timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return (double)ts.tv_sec * 1000000.0 + (double)ts.tv_nsec / 1000.0;
+#else
+		return (double)std::clock() * 1000000.0 / CLOCKS_PER_SEC;
+#endif
+	}
+	
+#ifdef SIGLY_ENABLE_TRACING
+	// Ring of the emission events of one thread. Only the owning thread
+	// writes to it; buffers are allocated once per thread, linked into a
+	// global list with a compare-and-swap and never freed, so recording an
+	// event neither locks nor allocates.
+	class _trace_buffer {
+	public:
+		enum event_type {
+			EMIT_BEGIN,
+			EMIT_END,
+			SLOT_BEGIN,
+			SLOT_END
+		};
+		
+		struct event {
+			double time;
+			const void *signal;
+			const void *connection;
+			event_type type;
+		};
+		
+		static void record(event_type type, const void *signal, const void *connection) {
+			_trace_buffer *buffer = current();
+			long head = buffer->m_head;
+			event &e = buffer->m_events[head % SIGLY_TRACE_BUFFER_SIZE];
+			e.time = _now();
+			e.signal = signal;
+			e.connection = connection;
+			e.type = type;
+			_atomic_store(&buffer->m_head, head + 1);
+		}
+		
+		static _trace_buffer *first() {
+			return static_cast<_trace_buffer *>(_atomic_load(&list()));
+		}
+		
+		_trace_buffer *nextBuffer() const {
+			return m_next;
+		}
+		
+		long threadId() const {
+			return m_thread;
+		}
+		
+		long head() const {
+			return _atomic_load(&m_head);
+		}
+		
+		const event &at(long index) const {
+			return m_events[index % SIGLY_TRACE_BUFFER_SIZE];
+		}
+		
+		// Index of the oldest event still to export.
+		long m_tail;
+		
+	private:
+		_trace_buffer(): m_tail(0), m_head(0), m_next(NULL) {
+			static volatile long threads = 0;
+			m_thread = _atomic_increment(&threads);
+		}
+		
+		static _trace_buffer *current() {
+			static _SIGLY_THREAD_LOCAL _trace_buffer *buffer = NULL;
+			
+			if (buffer == NULL) {
+				buffer = new _trace_buffer();
+				void *expected = _atomic_load(&list());
+				
+				for (;;) {
+					buffer->m_next = static_cast<_trace_buffer *>(expected);
+					void *previous = _atomic_compare_exchange(&list(), expected, buffer);
+					
+					if (previous == expected) {
+						break;
+					}
+					
+					expected = previous;
+				}
+			}
+			
+			return buffer;
+		}
+		
+		static void *volatile &list() {
+			static void *volatile buffers = NULL;
+			return buffers;
+		}
+		
+		volatile long m_head;
+		long m_thread;
+		_trace_buffer *m_next;
+		event m_events[SIGLY_TRACE_BUFFER_SIZE];
+	};
+	
+	// Access to the events recorded when SIGLY_ENABLE_TRACING is defined.
+	class Trace {
+	public:
+		// Writes the events recorded since the last clear() in the Chrome trace
+		// event format, which chrome://tracing and Perfetto can open. Each
+		// emission is a span named "emit" and each slot call a nested span
+		// named "slot"; both carry the signal and connection addresses.
+		// Spans whose beginning was overwritten in a full buffer are left
+		// out. Threads keep recording while this runs, so events written
+		// concurrently may be torn; export while emitters are idle for an
+		// exact trace.
+		static void writeChromeJson(std::ostream &out) {
+			static const char *const names[] = { "emit", "emit", "slot", "slot" };
+			static const char *const phases[] = { "B", "E", "B", "E" };
+			std::ios_base::fmtflags flags = out.flags();
+			bool first = true;
+			out << std::fixed << "{\"traceEvents\":[";
+			
+			for (_trace_buffer *buffer = _trace_buffer::first(); buffer != NULL; buffer = buffer->nextBuffer()) {
+				long head = buffer->head();
+				long index = head - buffer->m_tail > SIGLY_TRACE_BUFFER_SIZE ? head - SIGLY_TRACE_BUFFER_SIZE : buffer->m_tail;
+				// Spans of a thread nest, so an end without a beginning
+				// before it in the ring belongs to an overwritten one.
+				long depth = 0;
+				
+				for (; index < head; ++index) {
+					const _trace_buffer::event &e = buffer->at(index);
+					
+					if (e.type == _trace_buffer::EMIT_BEGIN || e.type == _trace_buffer::SLOT_BEGIN) {
+						++depth;
+					} else if (depth == 0) {
+						continue;
+					} else {
+						--depth;
+					}
+					
+					out << (first ? "\n" : ",\n");
+					out << "{\"name\":\"" << names[e.type] << "\",\"ph\":\"" << phases[e.type] << "\",\"pid\":1,\"tid\":" << buffer->threadId();
+					out << ",\"ts\":" << e.time << ",\"args\":{\"signal\":\"" << e.signal << "\",\"connection\":\"" << e.connection << "\"}}";
+					first = false;
+				}
+			}
+			
+			out << "\n]}\n";
+			out.flags(flags);
+		}
+		
+		// Discards the events recorded so far.
+		static void clear() {
+			for (_trace_buffer *buffer = _trace_buffer::first(); buffer != NULL; buffer = buffer->nextBuffer()) {
+				buffer->m_tail = buffer->head();
+			}
+		}
+	};
+#endif // SIGLY_ENABLE_TRACING
+	
+	// Per-thread stack of the receivers whose slots are running on the thread,
+	// so that a receiver disconnected or destroyed from inside one of its own
+	// slots does not wait for that call to return.
+	class _call_frame {
+	public:
+		void push(const void *receiver) {
+			m_receiver = receiver;
+			m_next = top();
+			top() = this;
+		}
+		
+		void pop() {
+			top() = m_next;
+		}
+		
+		const void *receiver() const {
+			return m_receiver;
+		}
+		
+		// Forgets the calling thread's frames for the receiver and returns how
+		// many there were.
+		static long detach(const void *receiver) {
+			long count = 0;
+			
+			for (_call_frame *frame = top(); frame != NULL; frame = frame->m_next) {
+				if (frame->m_receiver == receiver) {
+					frame->m_receiver = NULL;
+					++count;
+				}
+			}
+			
+			return count;
+		}
+		
+	private:
+		static _call_frame *&top() {
+			static _SIGLY_THREAD_LOCAL _call_frame *frames = NULL;
+			return frames;
+		}
+		
+		const void *m_receiver;
+		_call_frame *m_next;
+	};
+	
+	// Something a published signal retired, to be freed after a grace period.
+	class _retired {
+	public:
+		_retired(): m_next(NULL) {
+		}
+		
+		virtual ~_retired() {
+		}
+		
+		// Whether the item is among those retired.
+		virtual bool holds(const void *) const {
+			return false;
+		}
+		
+		_retired *m_next;
+	};
+	
+	// Epoch-based grace periods for the emissions of published signals. Each
+	// thread has a record, alone on its cache line, holding the global epoch
+	// it read when it started emitting, or 0 when it is not emitting; reading
+	// only writes to that record. A grace period advances the epoch and waits
+	// until no other thread is still in an older one. Records are allocated
+	// once per thread and never freed.
+	class _read_epoch {
+	public:
+		// Returns the record of the calling thread.
+		static _read_epoch *enter() {
+			_read_epoch *self = current();
+			
+			if (self->m_depth++ == 0) {
+				_atomic_exchange(&self->m_epoch, _atomic_load(&clock()));
+			}
+			
+			return self;
+		}
+		
+		static void leave() {
+			_read_epoch *self = current();
+			
+			if (--self->m_depth == 0) {
+				_atomic_exchange(&self->m_epoch, 0);
+				
+				if (self->m_deferred != NULL) {
+					_retired *deferred = self->m_deferred;
+					self->m_deferred = NULL;
+					synchronize();
+					release(deferred);
+				}
+			}
+		}
+		
+		// Frees the items once no emission can still use them. A thread that
+		// is emitting cannot wait for the others, which might be waiting for
+		// it; its items are kept until its outermost emission returns.
+		static void retire(_retired *items) {
+			_read_epoch *self = current();
+			
+			if (self->m_depth != 0) {
+				_retired *last = items;
+				
+				while (last->m_next != NULL) {
+					last = last->m_next;
+				}
+				
+				last->m_next = self->m_deferred;
+				self->m_deferred = items;
+			} else {
+				synchronize();
+				release(items);
+			}
+		}
+		
+		// Whether the thread retired the item since its outermost emission
+		// started. Such an item is still allocated, but what it refers to,
+		// like the receiver of a connection, may have been destroyed by a
+		// slot of that emission.
+		bool retiredHere(const void *item) const {
+			for (_retired *deferred = m_deferred; deferred != NULL; deferred = deferred->m_next) {
+				if (deferred->holds(item)) {
+					return true;
+				}
+			}
+			
+			return false;
+		}
+		
+	private:
+		_read_epoch(): m_epoch(0), m_depth(0), m_deferred(NULL), m_next(NULL) {
+		}
+		
+		static void synchronize() {
+			_read_epoch *self = current();
+			long target = _atomic_increment(&clock());
+			
+			for (_read_epoch *record = static_cast<_read_epoch *>(_atomic_load(&list())); record != NULL; record = record->m_next) {
+				if (record != self) {
+					for (long epoch = _atomic_load(&record->m_epoch); epoch != 0 && epoch < target; epoch = _atomic_load(&record->m_epoch)) {
+						_thread_yield();
+					}
+				}
+			}
+		}
+		
+		static void release(_retired *items) {
+			while (items != NULL) {
+				_retired *next = items->m_next;
+				delete items;
+				items = next;
+			}
+		}
+		
+		static _read_epoch *current() {
+			static _SIGLY_THREAD_LOCAL _read_epoch *record = NULL;
+			
+			if (record == NULL) {
+				record = new _read_epoch();
+				void *expected = _atomic_load(&list());
+				
+				for (;;) {
+					record->m_next = static_cast<_read_epoch *>(expected);
+					void *previous = _atomic_compare_exchange(&list(), expected, record);
+					
+					if (previous == expected) {
+						break;
+					}
+					
+					expected = previous;
+				}
+			}
+			
+			return record;
+		}
+		
+		// Starts at 1 so that 0 can mean "not emitting".
+		static volatile long &clock() {
+			static volatile long epoch = 1;
+			return epoch;
+		}
+		
+		static void *volatile &list() {
+			static void *volatile records = NULL;
+			return records;
+		}
+		
+		char m_before[SIGLY_CACHE_LINE_SIZE];
+		volatile long m_epoch;
+		long m_depth;
+		_retired *m_deferred;
+		_read_epoch *m_next;
+		char m_after[SIGLY_CACHE_LINE_SIZE];
+	};
+	
+#ifdef SIGLY_ENABLE_REGISTRY
+	// Link of a signal or a receiver into the Registry. The owner links it at
+	// the end of its constructors and unlinks it first thing in its
+	// destructor, so the registry only ever sees complete objects. The
+	// counters only read the owner's atomic counts, never its lock.
+	class _registry_entry {
+	public:
+		typedef std::size_t (*counter)(const void *object);
+		
+		_registry_entry(): m_object(NULL), m_signal(false), m_links(NULL), m_bytes(NULL), m_prev(NULL), m_next(NULL) {
+		}
+		
+		void link(const void *object, bool signal, counter links, counter bytes) {
+			m_object = object;
+			m_signal = signal;
+			m_links = links;
+			m_bytes = bytes;
+			monitor().lock();
+			m_next = head();
+			
+			if (m_next != NULL) {
+				m_next->m_prev = this;
+			}
+			
+			head() = this;
+			monitor().unlock();
+		}
+		
+		void unlink() {
+			monitor().lock();
+			
+			if (m_prev != NULL) {
+				m_prev->m_next = m_next;
+			} else {
+				head() = m_next;
+			}
+			
+			if (m_next != NULL) {
+				m_next->m_prev = m_prev;
+			}
+			
+			monitor().unlock();
+		}
+		
+		static _monitor &monitor() {
+			static _monitor registry;
+			return registry;
+		}
+		
+		static _registry_entry *&head() {
+			static _registry_entry *entries = NULL;
+			return entries;
+		}
+		
+		const void *m_object;
+		bool m_signal;
+		counter m_links;
+		counter m_bytes;
+		_registry_entry *m_prev;
+		_registry_entry *m_next;
+		
+	private:
+		_registry_entry(const _registry_entry &);
+		_registry_entry &operator=(const _registry_entry &);
+	};
+	
+	// Totals over the live signals and receivers.
+	struct MemoryStats {
+		MemoryStats(): signals(0), receivers(0), connections(0), bytes(0) {
+		}
+		
+		std::size_t signals;
+		std::size_t receivers;
+		// Connections held by the signals.
+		std::size_t connections;
+		// What the signals and receivers report from memoryUsage().
+		std::size_t bytes;
+	};
+	
+	// Every signal and receiver of the process, when SIGLY_ENABLE_REGISTRY is
+	// defined.
+	class Registry {
+	public:
+		static MemoryStats collect() {
+			totals visitor;
+			visit(visitor);
+			return visitor.m_stats;
+		}
+		
+		// Calls visitor(object, isSignal, links, bytes) for every live signal
+		// and receiver, where links is the number of connections of a signal
+		// or of senders of a receiver. The registry is locked meanwhile, so
+		// the visitor must not create or destroy signals or receivers.
+		template<class visitor_type>
+		static void visit(visitor_type &visitor) {
+			_registry_entry::monitor().lock();
+			
+			for (_registry_entry *entry = _registry_entry::head(); entry != NULL; entry = entry->m_next) {
+				visitor(entry->m_object, entry->m_signal, entry->m_links(entry->m_object), entry->m_bytes(entry->m_object));
+			}
+			
+			_registry_entry::monitor().unlock();
+		}
+		
+	private:
+		struct totals {
+			void operator()(const void *, bool signal, std::size_t links, std::size_t bytes) {
+				if (signal) {
+					++m_stats.signals;
+					m_stats.connections += links;
+				} else {
+					++m_stats.receivers;
+				}
+				
+				m_stats.bytes += bytes;
+			}
+			
+			MemoryStats m_stats;
+		};
+	};
+#endif // SIGLY_ENABLE_REGISTRY
+	
+	class _payload_pool;
+	
+	// Header of a Payload buffer, allocated together with the bytes that
+	// follow it.
+	struct _payload_block {
+		volatile long refs;
+		std::size_t size;
+		// NULL when the block was allocated on its own.
+		_payload_pool *pool;
+		// Next idle block of the pool.
+		_payload_block *next;
+		
+		unsigned char *data() {
+			return reinterpret_cast<unsigned char *>(this + 1);
+		}
+		
+		static _payload_block *create(std::size_t size, _payload_pool *pool) {
+			_payload_block *block = reinterpret_cast<_payload_block *>(new char[sizeof(_payload_block) + size]);
+			block->refs = 1;
+			block->size = size;
+			block->pool = pool;
+			block->next = NULL;
+			return block;
+		}
+		
+		static void destroy(_payload_block *block) {
+			delete [] reinterpret_cast<char *>(block);
+		}
+	};
+	
+	// Where a pooled block goes back when its last Payload is destroyed.
+	class _payload_pool {
+	public:
+		virtual void release(_payload_block *block) = 0;
+		
+	protected:
+		virtual ~_payload_pool() {
+		}
+	};
+	
+	// Shared, reference-counted buffer of bytes. Copying a Payload only
+	// counts one more reference, so a signal taking a Payload delivers the
+	// same buffer to every receiver, including the copies of the arguments
+	// that queued connections keep until their slot runs. The buffer is
+	// freed, or given back to its PayloadPool, when the last Payload
+	// referring to it is destroyed. Fill it through buffer() before emitting
+	// it; a shared buffer must not change.
+	class Payload {
+	public:
+		Payload(): m_block(NULL) {
+		}
+		
+		// An unshared buffer of size bytes, allocated on its own.
+		explicit Payload(std::size_t size): m_block(_payload_block::create(size, NULL)) {
+		}
+		
+		Payload(const void *data, std::size_t size): m_block(_payload_block::create(size, NULL)) {
+			std::memcpy(m_block->data(), data, size);
+		}
+		
+		Payload(const Payload &other): m_block(other.m_block) {
+			if (m_block != NULL) {
+				_atomic_increment(&m_block->refs);
+			}
+		}
+		
+		Payload &operator=(const Payload &other) {
+			Payload copy(other);
+			swap(copy);
+			return *this;
+		}
+		
+		~Payload() {
+			reset();
+		}
+		
+		void reset() {
+			if (m_block != NULL && _atomic_decrement(&m_block->refs) == 0) {
+				if (m_block->pool != NULL) {
+					m_block->pool->release(m_block);
+				} else {
+					_payload_block::destroy(m_block);
+				}
+			}
+			
+			m_block = NULL;
+		}
+		
+		void swap(Payload &other) {
+			std::swap(m_block, other.m_block);
+		}
+		
+		bool empty() const {
+			return m_block == NULL;
+		}
+		
+		const unsigned char *data() const {
+			return m_block != NULL ? m_block->data() : NULL;
+		}
+		
+		std::size_t size() const {
+			return m_block != NULL ? m_block->size : 0;
+		}
+		
+		// The bytes to fill, or NULL once the buffer is shared.
+		unsigned char *buffer() {
+			return useCount() == 1 ? m_block->data() : NULL;
+		}
+		
+		long useCount() const {
+			return m_block != NULL ? _atomic_load(&m_block->refs) : 0;
+		}
+		
+	private:
+		explicit Payload(_payload_block *block): m_block(block) {
+		}
+		
+		template<class>
+		friend class PayloadPool;
+		
+		_payload_block *m_block;
+	};
+	
+	// Idle blocks of a PayloadPool. Each block in use holds a reference, so
+	// the list outlives the pool until every block has come back.
+	template<class mt_policy>
+	class _payload_free_list : public _payload_pool, public mt_policy {
+	public:
+		_payload_free_list(std::size_t size): m_refs(1), m_size(size), m_idle(NULL) {
+		}
+		
+		_payload_block *take() {
+			_payload_block *block;
+			
+			{
+				lock_block<mt_policy> lock(this);
+				block = m_idle;
+				
+				if (block != NULL) {
+					m_idle = block->next;
+				}
+			}
+			
+			if (block == NULL) {
+				block = _payload_block::create(m_size, this);
+			} else {
+				block->refs = 1;
+			}
+			
+			_atomic_increment(&m_refs);
+			return block;
+		}
+		
+		void give(_payload_block *block) {
+			lock_block<mt_policy> lock(this);
+			block->next = m_idle;
+			m_idle = block;
+		}
+		
+		virtual void release(_payload_block *block) {
+			give(block);
+			drop();
+		}
+		
+		void drop() {
+			if (_atomic_decrement(&m_refs) == 0) {
+				delete this;
+			}
+		}
+		
+		std::size_t blockSize() const {
+			return m_size;
+		}
+		
+	private:
+		~_payload_free_list() {
+			while (m_idle != NULL) {
+				_payload_block *block = m_idle;
+				m_idle = block->next;
+				_payload_block::destroy(block);
+			}
+		}
+		
+		volatile long m_refs;
+		std::size_t m_size;
+		_payload_block *m_idle;
+	};
+	
+	// Allocates Payloads of one size and reuses their buffers once released,
+	// so that emitting large buffers does not go through the allocator. The
+	// pool may be destroyed while its payloads are still in use.
+	template<class mt_policy = SIGLY_DEFAULT_MT_POLICY>
+	class PayloadPool {
+	public:
+		// Allocates reserve buffers up front.
+		PayloadPool(std::size_t blockSize, std::size_t reserve = 0): m_list(new _payload_free_list<mt_policy>(blockSize)) {
+			for (std::size_t i = 0; i < reserve; ++i) {
+				m_list->give(_payload_block::create(blockSize, m_list));
+			}
+		}
+		
+		~PayloadPool() {
+			m_list->drop();
+		}
+		
+		// An unshared buffer of blockSize() bytes, with undefined contents.
+		Payload allocate() {
+			return Payload(m_list->take());
+		}
+		
+		std::size_t blockSize() const {
+			return m_list->blockSize();
+		}
+		
+	private:
+		PayloadPool(const PayloadPool &);
+		PayloadPool &operator=(const PayloadPool &);
+		
+		_payload_free_list<mt_policy> *m_list;
+	};
+	
+	// Order in which a signal calls its slots.
+	enum DispatchOrder {
+		// The order of connection.
+		CONNECTION_ORDER,
+		// Connections of the same receiver class and signature are kept
+		// together, so that consecutive calls run the same code. Within a
+		// group, the order of connection is kept.
+		GROUPED_ORDER
+	};
+	
+	// How a connection made with a mode calls its slot when the receiver has
+	// been given an executor with moveToEventLoop() or moveToExecutor().
+	// Without one, every mode calls the slot directly.
+	enum ConnectionMode {
+		// The slot runs on the emitting thread, as with connect() without a mode.
+		DIRECT_CONNECTION,
+		// The call is always posted to the receiver's executor.
+		QUEUED_CONNECTION,
+		// The slot runs directly when the emitting thread is one that runs
+		// the calls of the receiver's executor and is posted there otherwise.
+		AUTO_CONNECTION
+	};
+	
+	// What an executor whose queue is bounded with setQueueBound() does with
+	// a call posted while the queue is full.
+	enum OverflowPolicy {
+		// The emitting thread waits for room. The threads of the executor
+		// never wait, since they make the room; their calls go over the bound.
+		BLOCK_EMITTER,
+		// The new call is dropped.
+		DROP_NEWEST,
+		// The oldest queued call is dropped to make room.
+		DROP_OLDEST,
+		// A call replaces the one with the same coalescing key and receiver
+		// still queued, which keeps its place, even while the queue is not
+		// full. The key is the connection unless connect() was given one. A
+		// call that has none to replace is dropped if the queue is full.
+		COALESCE
+	};
+	
+	// Counters of the queue of an executor, from its creation.
+	struct QueueStats {
+		QueueStats(): size(0), capacity(0), highWater(0), dropped(0), coalesced(0), blocked(0) {
+		}
+		
+		// Calls queued now.
+		std::size_t size;
+		// The bound, or 0 if there is none.
+		std::size_t capacity;
+		// The most calls that were queued at once.
+		std::size_t highWater;
+		// Calls dropped because the queue was full.
+		unsigned long dropped;
+		// Calls replaced by a later one of the same connection.
+		unsigned long coalesced;
+		// Posts that waited for room.
+		unsigned long blocked;
+	};
+	
+	// A slot call posted to an Executor, holding copies of its arguments.
+	// The key is the coalescing key of the connection that posted it, for
+	// COALESCE; calls without one are only dropped by a closed queue.
+	class _queued_call {
+	public:
+		_queued_call(const void *receiver, const void *key = NULL): m_receiver(receiver), m_key(key), m_previous(NULL), m_next(NULL) {
+		}
+		
+		virtual ~_queued_call() {
+		}
+		
+		// Counts the call on its receiver, like an emission does, so that
+		// disconnecting the receiver waits for the call to return.
+		virtual void enter() = 0;
+		virtual void leave() = 0;
+		virtual void run() = 0;
+		
+		const void *m_receiver;
+		const void *m_key;
+		_queued_call *m_previous;
+		_queued_call *m_next;
+	};
+	
+	// Posted calls in the order they were posted. Not locked. Under
+	// COALESCE, the keyed calls are also indexed by receiver and key.
+	class _call_queue {
+	public:
+		_call_queue(): m_head(NULL), m_tail(NULL), m_size(0), m_policy(BLOCK_EMITTER), m_waiters(0), m_closed(false) {
+		}
+		
+		~_call_queue() {
+			clear();
+		}
+		
+		bool empty() const {
+			return m_head == NULL;
+		}
+		
+		std::size_t size() const {
+			return m_size;
+		}
+		
+		void push(_queued_call *call) {
+			if (m_policy == COALESCE) {
+				index(call);
+			}
+			
+			call->m_previous = m_tail;
+			call->m_next = NULL;
+			
+			if (m_tail != NULL) {
+				m_tail->m_next = call;
+			} else {
+				m_head = call;
+			}
+			
+			m_tail = call;
+			++m_size;
+			
+			if (m_size > m_stats.highWater) {
+				m_stats.highWater = m_size;
+			}
+		}
+		
+		void bound(std::size_t capacity, OverflowPolicy policy) {
+			m_stats.capacity = capacity;
+			
+			if (policy == COALESCE && m_policy != COALESCE) {
+				for (_queued_call *call = m_head; call != NULL; call = call->m_next) {
+					index(call);
+				}
+			} else if (policy != COALESCE) {
+				m_index.clear();
+			}
+			
+			m_policy = policy;
+		}
+		
+		QueueStats stats() const {
+			QueueStats stats = m_stats;
+			stats.size = m_size;
+			return stats;
+		}
+		
+		// Whether posts are waiting on the monitor for room.
+		bool blocking() const {
+			return m_waiters != 0;
+		}
+		
+		// Makes the queue refuse the calls posted from now on, and those
+		// waiting for room, which are woken by notifying the monitor.
+		void close() {
+			m_closed = true;
+		}
+		
+		// Queues the call within the bound, with the monitor held. With
+		// BLOCK_EMITTER, waits on the monitor for room if wait is set, until
+		// there is some or the queue is closed. Returns the call left out,
+		// to be deleted once the monitor is released, or NULL.
+		_queued_call *post(_queued_call *call, _monitor &monitor, bool wait) {
+			if (m_closed) {
+				return call;
+			}
+			
+			if (call->m_key == NULL) {
+				push(call);
+				return NULL;
+			}
+			
+			if (m_policy == COALESCE) {
+				_queued_call *queued = replace(call);
+				
+				if (queued != NULL) {
+					++m_stats.coalesced;
+					return queued;
+				}
+			}
+			
+			if (full()) {
+				if (m_policy == BLOCK_EMITTER) {
+					if (wait) {
+						++m_stats.blocked;
+						++m_waiters;
+						
+						do {
+							monitor.wait();
+						} while (full() && m_policy == BLOCK_EMITTER && !m_closed);
+						
+						// The executor being closed waits for the last one
+						// to leave.
+						if (--m_waiters == 0 && m_closed) {
+							monitor.notifyAll();
+						}
+						
+						return post(call, monitor, false);
+					}
+				} else if (m_policy == DROP_OLDEST) {
+					_queued_call *oldest = removeOldest();
+					
+					if (oldest != NULL) {
+						++m_stats.dropped;
+						push(call);
+						return oldest;
+					}
+				} else {
+					++m_stats.dropped;
+					return call;
+				}
+			}
+			
+			push(call);
+			return NULL;
+		}
+		
+		// Removes the first call and counts it on its receiver, so that a
+		// cancel() made under the same lock never misses a call that is
+		// about to run.
+		_queued_call *take() {
+			_queued_call *call = m_head;
+			
+			if (call != NULL) {
+				m_head = call->m_next;
+				
+				if (m_head != NULL) {
+					m_head->m_previous = NULL;
+				} else {
+					m_tail = NULL;
+				}
+				
+				--m_size;
+				unindex(call);
+				call->enter();
+			}
+			
+			return call;
+		}
+		
+		// Unlinks the calls posted to the receiver and returns them, to be
+		// deleted with drop() once the queue is unlocked.
+		_queued_call *remove(const void *receiver) {
+			_queued_call *removed = NULL;
+			_queued_call **link = &m_head;
+			m_tail = NULL;
+			
+			while (*link != NULL) {
+				_queued_call *call = *link;
+				
+				if (call->m_receiver == receiver) {
+					*link = call->m_next;
+					unindex(call);
+					call->m_next = removed;
+					removed = call;
+					--m_size;
+				} else {
+					call->m_previous = m_tail;
+					m_tail = call;
+					link = &call->m_next;
+				}
+			}
+			
+			return removed;
+		}
+		
+		void clear() {
+			m_index.clear();
+			drop(m_head);
+			m_head = NULL;
+			m_tail = NULL;
+			m_size = 0;
+		}
+		
+		bool full() const {
+			return m_stats.capacity != 0 && m_size >= m_stats.capacity;
+		}
+		
+		static void drop(_queued_call *calls) {
+			while (calls != NULL) {
+				_queued_call *call = calls;
+				calls = call->m_next;
+				delete call;
+			}
+		}
+		
+	private:
+		typedef std::pair<const void *, const void *> _call_key;
+		typedef std::map<_call_key, _queued_call *> _call_index;
+		
+		// Indexes a keyed call unless one of its key is indexed already. A
+		// call left out of the index for want of memory is only never
+		// replaced.
+		void index(_queued_call *call) {
+			if (call->m_key != NULL) {
+				try {
+					m_index.insert(std::make_pair(_call_key(call->m_receiver, call->m_key), call));
+				} catch (const std::bad_alloc &) {
+				}
+			}
+		}
+		
+		void unindex(_queued_call *call) {
+			if (call->m_key == NULL || m_index.empty()) {
+				return;
+			}
+			
+			_call_index::iterator found = m_index.find(_call_key(call->m_receiver, call->m_key));
+			
+			if (found != m_index.end() && found->second == call) {
+				m_index.erase(found);
+			}
+		}
+		
+		// Puts the call in the place of the queued one with its key and
+		// returns that one, or NULL if there is none.
+		_queued_call *replace(_queued_call *call) {
+			_call_index::iterator found = m_index.find(_call_key(call->m_receiver, call->m_key));
+			
+			if (found == m_index.end()) {
+				return NULL;
+			}
+			
+			_queued_call *queued = found->second;
+			call->m_previous = queued->m_previous;
+			call->m_next = queued->m_next;
+			(call->m_previous != NULL ? call->m_previous->m_next : m_head) = call;
+			(call->m_next != NULL ? call->m_next->m_previous : m_tail) = call;
+			
+			found->second = call;
+			return queued;
+		}
+		
+		// Unlinks the first call that has a key.
+		_queued_call *removeOldest() {
+			for (_queued_call *call = m_head; call != NULL; call = call->m_next) {
+				if (call->m_key != NULL) {
+					(call->m_previous != NULL ? call->m_previous->m_next : m_head) = call->m_next;
+					(call->m_next != NULL ? call->m_next->m_previous : m_tail) = call->m_previous;
+					--m_size;
+					unindex(call);
+					return call;
+				}
+			}
+			
+			return NULL;
+		}
+		
+		_call_queue(const _call_queue &);
+		_call_queue &operator=(const _call_queue &);
+		
+		_queued_call *m_head;
+		_queued_call *m_tail;
+		std::size_t m_size;
+		OverflowPolicy m_policy;
+		QueueStats m_stats;
+		long m_waiters;
+		bool m_closed;
+		_call_index m_index;
+	};
+	
+	// Ends a call taken from a queue, even if its slot throws.
+	class _running_call {
+	public:
+		_running_call(_queued_call *call): m_call(call) {
+			m_frame.push(call->m_receiver);
+		}
+		
+		~_running_call() {
+			if (m_frame.receiver() != NULL) {
+				m_call->leave();
+			}
+			
+			m_frame.pop();
+			delete m_call;
+		}
+		
+	private:
+		_queued_call *m_call;
+		_call_frame m_frame;
+	};
+	
+	// Something that runs posted slot calls: an EventLoop, a ThreadPool or
+	// a Strand.
+	class Executor {
+	public:
+		virtual ~Executor() {
+		}
+		
+		// Takes ownership of the call.
+		virtual void post(_queued_call *call) = 0;
+		
+		// Drops the calls posted to the receiver that have not started yet.
+		virtual void cancel(const void *receiver) = 0;
+		
+		// Whether the calling thread is one that runs the posted calls, so
+		// that AUTO_CONNECTION can call the slot directly.
+		virtual bool isCurrent() const = 0;
+		
+		// This executor if it is an event loop, or NULL.
+		virtual EventLoop *eventLoop() {
+			return NULL;
+		}
+	};
+	
+	// Executor running the calls of a queue of its own, which may be bounded.
+	class _queued_executor : public Executor {
+	public:
+		virtual void cancel(const void *receiver) {
+			m_monitor.lock();
+			_queued_call *dropped = m_queue.remove(receiver);
+			
+			if (m_queue.blocking()) {
+				m_monitor.notifyAll();
+			}
+			
+			m_monitor.unlock();
+			_call_queue::drop(dropped);
+		}
+		
+		// Keeps at most capacity calls queued, applying the policy to the
+		// calls posted beyond, or lifts the bound if capacity is 0. Calls
+		// already queued stay.
+		void setQueueBound(std::size_t capacity, OverflowPolicy policy = BLOCK_EMITTER) {
+			m_monitor.lock();
+			m_queue.bound(capacity, policy);
+			m_monitor.notifyAll();
+			m_monitor.unlock();
+		}
+		
+		QueueStats queueStats() {
+			m_monitor.lock();
+			QueueStats stats = m_queue.stats();
+			m_monitor.unlock();
+			return stats;
+		}
+		
+	protected:
+		_queued_executor() {
+		}
+		
+		// Queues the call with the monitor held, waiting for room only if
+		// wait is set, and returns the call left out.
+		_queued_call *enqueue(_queued_call *call, bool wait) {
+			_queued_call *dropped = m_queue.post(call, m_monitor, wait);
+			
+			if (dropped != call) {
+				m_monitor.notifyOne();
+			}
+			
+			return dropped;
+		}
+		
+		// Takes the next call with the monitor held, waking the posts that
+		// wait for room.
+		_queued_call *next() {
+			_queued_call *call = m_queue.take();
+			
+			if (call != NULL && m_queue.blocking()) {
+				m_monitor.notifyAll();
+			}
+			
+			return call;
+		}
+		
+		// Refuses the calls posted from now on and returns once the posts
+		// that waited for room have dropped theirs and left the monitor.
+		void close() {
+			m_monitor.lock();
+			m_queue.close();
+			m_monitor.notifyAll();
+			
+			while (m_queue.blocking()) {
+				m_monitor.wait();
+			}
+			
+			m_monitor.unlock();
+		}
+		
+		_monitor m_monitor;
+		_call_queue m_queue;
+		
+	private:
+		_queued_executor(const _queued_executor &);
+		_queued_executor &operator=(const _queued_executor &);
+	};
+	
+	// Queue of the slot calls posted to the receivers that live on one thread.
+	// The thread that creates an event loop owns it unless it already had one;
+	// makeCurrent() changes the loop of the calling thread. The owning thread
+	// runs the posted calls with processEvents() or exec(). Receivers must
+	// be moved to another loop or destroyed before their loop is.
+	class EventLoop : public _queued_executor {
+	public:
+		EventLoop(): m_quit(false) {
+			if (threadLoop() == NULL) {
+				threadLoop() = this;
+			}
+		}
+		
+		~EventLoop() {
+			close();
+			
+			if (threadLoop() == this) {
+				threadLoop() = NULL;
+			}
+		}
+		
+		// Event loop of the calling thread, or NULL.
+		static EventLoop *current() {
+			return threadLoop();
+		}
+		
+		void makeCurrent() {
+			threadLoop() = this;
+		}
+		
+		virtual bool isCurrent() const {
+			return threadLoop() == this;
+		}
+		
+		virtual EventLoop *eventLoop() {
+			return this;
+		}
+		
+		virtual void post(_queued_call *call) {
+			m_monitor.lock();
+			_queued_call *dropped = enqueue(call, !isCurrent());
+			m_monitor.unlock();
+			delete dropped;
+		}
+		
+		// Runs the calls posted so far, and those they post in turn, on the
+		// calling thread. Returns the number of calls run.
+		std::size_t processEvents() {
+			std::size_t count = 0;
+			
+			while (_queued_call *call = take()) {
+				_running_call running(call);
+				call->run();
+				++count;
+			}
+			
+			return count;
+		}
+		
+#ifndef _SIGLY_SINGLE_THREADED
+		// Runs posted calls until quit() is called, sleeping while there are
+		// none.
+		void exec() {
+			for (;;) {
+				processEvents();
+				m_monitor.lock();
+				
+				while (m_queue.empty() && !m_quit) {
+					m_monitor.wait();
+				}
+				
+				bool done = m_quit && m_queue.empty();
+				
+				if (done) {
+					m_quit = false;
+				}
+				
+				m_monitor.unlock();
+				
+				if (done) {
+					break;
+				}
+			}
+		}
+		
+		// Makes exec() return once the calls already posted have run.
+		void quit() {
+			m_monitor.lock();
+			m_quit = true;
+			m_monitor.notifyAll();
+			m_monitor.unlock();
+		}
+#endif // _SIGLY_SINGLE_THREADED
+		
+	private:
+		_queued_call *take() {
+			m_monitor.lock();
+			_queued_call *call = next();
+			m_monitor.unlock();
+			return call;
+		}
+		
+		static EventLoop *&threadLoop() {
+			static _SIGLY_THREAD_LOCAL EventLoop *loop = NULL;
+			return loop;
+		}
+		
+		EventLoop(const EventLoop &);
+		EventLoop &operator=(const EventLoop &);
+		
+		bool m_quit;
+	};
+	
+#ifndef _SIGLY_SINGLE_THREADED
+	// A fixed set of threads running the calls posted to it, each on the
+	// first thread that is free, so that calls for the same receiver may
+	// run at the same time. Destroying the pool waits for the running calls
+	// and drops the others. Receivers may outlive the pool; a receiver
+	// destroyed before it drops its calls that have not started yet.
+	class ThreadPool : public _queued_executor {
+	public:
+		// Throws std::bad_alloc if the threads cannot be started.
+		explicit ThreadPool(std::size_t threads): m_quit(false), m_next(NULL) {
+			try {
+				while (m_threads.size() < threads) {
+					start();
+				}
+			} catch (...) {
+				stop();
+				throw;
+			}
+			
+			_pool_list &pools = poolList();
+			pools.monitor.lock();
+			m_next = pools.head;
+			pools.head = this;
+			_atomic_increment(&pools.count);
+			pools.monitor.unlock();
+		}
+		
+		// The pool stays listed until its threads have stopped, so that the
+		// receivers destroyed meanwhile still drop their calls.
+		~ThreadPool() {
+			stop();
+			_pool_list &pools = poolList();
+			pools.monitor.lock();
+			ThreadPool **link = &pools.head;
+			
+			while (*link != this) {
+				link = &(*link)->m_next;
+			}
+			
+			*link = m_next;
+			_atomic_decrement(&pools.count);
+			pools.monitor.unlock();
+		}
+		
+		virtual void post(_queued_call *call) {
+			m_monitor.lock();
+			_queued_call *dropped = enqueue(call, !isCurrent());
+			m_monitor.unlock();
+			delete dropped;
+		}
+		
+		virtual bool isCurrent() const {
+			return threadPool() == this;
+		}
+		
+		std::size_t threadCount() const {
+			return m_threads.size();
+		}
+		
+	private:
+		template<class, class>
+		friend class _receiver;
+		
+#ifdef _SIGLY_HAS_WIN32_THREADS
+		typedef HANDLE thread_type;
+		
+		static DWORD WINAPI work(LPVOID pool) {
+			static_cast<ThreadPool *>(pool)->work();
+			return 0;
+		}
+		
+		void start() {
+			m_threads.reserve(m_threads.size() + 1);
+			HANDLE thread = CreateThread(NULL, 0, &ThreadPool::work, this, 0, NULL);
+			
+			if (thread == NULL) {
+				throw std::bad_alloc();
+			}
+			
+			m_threads.push_back(thread);
+		}
+		
+		static void join(HANDLE thread) {
+			WaitForSingleObject(thread, INFINITE);
+			CloseHandle(thread);
+		}
+#else
+		typedef pthread_t thread_type;
+		
+		static void *work(void *pool) {
+			static_cast<ThreadPool *>(pool)->work();
+			return NULL;
+		}
+		
+		void start() {
+			m_threads.reserve(m_threads.size() + 1);
+			pthread_t thread;
+			
+			if (pthread_create(&thread, NULL, &ThreadPool::work, this) != 0) {
+				throw std::bad_alloc();
+			}
+			
+			m_threads.push_back(thread);
+		}
+		
+		static void join(pthread_t thread) {
+			pthread_join(thread, NULL);
+		}
+#endif // _SIGLY_HAS_WIN32_THREADS
+		
+		void work() {
+			threadPool() = this;
+			m_monitor.lock();
+			
+			while (!m_quit) {
+				_queued_call *call = next();
+				
+				if (call == NULL) {
+					m_monitor.wait();
+					continue;
+				}
+				
+				m_monitor.unlock();
+				
+				try {
+					_running_call running(call);
+					call->run();
+				} catch (...) {
+					// Nothing on a pool thread could handle the exception of
+					// a slot; the call is over.
+				}
+				
+				m_monitor.lock();
+			}
+			
+			m_monitor.unlock();
+		}
+		
+		void stop() {
+			m_monitor.lock();
+			m_quit = true;
+			m_monitor.unlock();
+			close();
+			
+			for (std::size_t i = 0; i < m_threads.size(); ++i) {
+				join(m_threads[i]);
+			}
+			
+			m_queue.clear();
+		}
+		
+		// Drops the calls posted to the receiver in every pool. Called when
+		// the receiver is destroyed; takes no lock while there is no pool.
+		static void cancelAll(const void *receiver) {
+			_pool_list &pools = poolList();
+			
+			if (_atomic_load(&pools.count) == 0) {
+				return;
+			}
+			
+			pools.monitor.lock();
+			
+			for (ThreadPool *pool = pools.head; pool != NULL; pool = pool->m_next) {
+				pool->cancel(receiver);
+			}
+			
+			pools.monitor.unlock();
+		}
+		
+		struct _pool_list {
+			_pool_list(): head(NULL), count(0) {
+			}
+			
+			_monitor monitor;
+			ThreadPool *head;
+			volatile long count;
+		};
+		
+		static _pool_list &poolList() {
+			static _pool_list pools;
+			return pools;
+		}
+		
+		static ThreadPool *&threadPool() {
+			static _SIGLY_THREAD_LOCAL ThreadPool *pool = NULL;
+			return pool;
+		}
+		
+		ThreadPool(const ThreadPool &);
+		ThreadPool &operator=(const ThreadPool &);
+		
+		std::vector<thread_type> m_threads;
+		bool m_quit;
+		ThreadPool *m_next;
+	};
+#endif // _SIGLY_SINGLE_THREADED
+	
+	// Runs the calls posted to it one at a time, in the order they were
+	// posted, on the threads of another executor. The slots of receivers
+	// moved to one strand never run at the same time, so they need no lock
+	// of their own, while the strands sharing a ThreadPool run in parallel.
+	// Each turn of a strand runs the calls queued when it starts, then makes
+	// way for the other work of the executor. The receivers must be moved
+	// away or destroyed before the strand, and the strand destroyed before
+	// its executor.
+	class Strand : public _queued_executor {
+	public:
+		explicit Strand(Executor *executor): m_executor(executor), m_scheduled(false), m_turns(0) {
+		}
+		
+		// Drops the calls that have not started and waits for a turn being
+		// run on another thread. Must not be called from a slot of the
+		// strand.
+		~Strand() {
+			close();
+			
+			for (;;) {
+				m_executor->cancel(this);
+				
+				if (_atomic_load(&m_turns) == 0) {
+					break;
+				}
+				
+				_thread_yield();
+			}
+		}
+		
+		// Posts from the threads of the executor never wait for room, since
+		// the strand might need one of them to make it.
+		virtual void post(_queued_call *call) {
+			m_monitor.lock();
+			_queued_call *dropped = enqueue(call, !m_executor->isCurrent());
+			bool idle = dropped != call && !m_scheduled && !m_queue.empty();
+			
+			if (idle) {
+				m_scheduled = true;
+			}
+			
+			m_monitor.unlock();
+			delete dropped;
+			
+			if (idle) {
+				schedule();
+			}
+		}
+		
+		virtual bool isCurrent() const {
+			return threadStrand() == this;
+		}
+		
+		Executor *executor() const {
+			return m_executor;
+		}
+		
+	private:
+		// Posted to the executor for each turn of the strand; counted so that
+		// the strand outlives them.
+		class _turn : public _queued_call {
+		public:
+			_turn(Strand *strand): _queued_call(strand), m_strand(strand) {
+				_atomic_increment(&strand->m_turns);
+			}
+			
+			~_turn() {
+				_atomic_decrement(&m_strand->m_turns);
+			}
+			
+			virtual void enter() {
+			}
+			
+			virtual void leave() {
+			}
+			
+			virtual void run() {
+				m_strand->run();
+			}
+			
+		private:
+			Strand *m_strand;
+		};
+		
+		friend class _turn;
+		
+		void schedule() {
+			try {
+				m_executor->post(new _turn(this));
+			} catch (...) {
+				m_monitor.lock();
+				m_scheduled = false;
+				m_monitor.unlock();
+				throw;
+			}
+		}
+		
+		// A slot that throws ends the turn; the exception is left to the
+		// executor, which handles it like the ones of its own calls.
+		void run() {
+			Strand *&current = threadStrand();
+			Strand *outer = current;
+			current = this;
+			
+			m_monitor.lock();
+			std::size_t count = m_queue.size();
+			m_monitor.unlock();
+			
+			try {
+				while (count-- > 0 && runOne()) {
+				}
+			} catch (...) {
+				current = outer;
+				
+				try {
+					reschedule();
+				} catch (...) {
+				}
+				
+				throw;
+			}
+			
+			current = outer;
+			reschedule();
+		}
+		
+		bool runOne() {
+			m_monitor.lock();
+			_queued_call *call = next();
+			m_monitor.unlock();
+			
+			if (call == NULL) {
+				return false;
+			}
+			
+			_running_call running(call);
+			call->run();
+			return true;
+		}
+		
+		// The calls posted during a turn wait for the next one.
+		void reschedule() {
+			m_monitor.lock();
+			m_scheduled = !m_queue.empty();
+			bool more = m_scheduled;
+			m_monitor.unlock();
+			
+			if (more) {
+				schedule();
+			}
+		}
+		
+		static Strand *&threadStrand() {
+			static _SIGLY_THREAD_LOCAL Strand *strand = NULL;
+			return strand;
+		}
+		
+		Strand(const Strand &);
+		Strand &operator=(const Strand &);
+		
+		Executor *m_executor;
+		bool m_scheduled;
+		volatile long m_turns;
+	};
+	
+	// Emission of a trampolined signal made from a slot, with copies of its
+	// arguments, waiting for the outermost emission of the thread to run it.
+	class _deferred_emission {
+	public:
+		_deferred_emission(const void *signal): m_signal(signal), m_pins(NULL), m_next(NULL) {
+		}
+		
+		virtual ~_deferred_emission() {
+		}
+		
+		virtual void run() = 0;
+		
+		const void *m_signal;
+		// The pin count of the signal, which the emission holds until it is
+		// run or dropped.
+		volatile long *m_pins;
+		_deferred_emission *m_next;
+	};
+	
+	template<class signal_type>
+	class _deferred_emission0 : public _deferred_emission {
+	public:
+		_deferred_emission0(signal_type *signal): _deferred_emission(signal), m_signal(signal) {
+		}
+		
+		virtual void run() {
+			m_signal->dispatch();
+		}
+		
+	private:
+		signal_type *m_signal;
+	};
+	
+	template<class signal_type, class arg1_type>
+	class _deferred_emission1 : public _deferred_emission {
+	public:
+		_deferred_emission1(signal_type *signal, arg1_type a1): _deferred_emission(signal), m_signal(signal), m_a1(a1) {
+		}
+		
+		virtual void run() {
+			m_signal->dispatch(m_a1);
+		}
+		
+	private:
+		signal_type *m_signal;
+		typename _value_type<arg1_type>::type m_a1;
+	};
+	
+	template<class signal_type, class arg1_type, class arg2_type>
+	class _deferred_emission2 : public _deferred_emission {
+	public:
+		_deferred_emission2(signal_type *signal, arg1_type a1, arg2_type a2): _deferred_emission(signal), m_signal(signal), m_a1(a1), m_a2(a2) {
+		}
+		
+		virtual void run() {
+			m_signal->dispatch(m_a1, m_a2);
+		}
+		
+	private:
+		signal_type *m_signal;
+		typename _value_type<arg1_type>::type m_a1;
+		typename _value_type<arg2_type>::type m_a2;
+	};
+	
+	template<class signal_type, class arg1_type, class arg2_type, class arg3_type>
+	class _deferred_emission3 : public _deferred_emission {
+	public:
+		_deferred_emission3(signal_type *signal, arg1_type a1, arg2_type a2, arg3_type a3): _deferred_emission(signal), m_signal(signal), m_a1(a1), m_a2(a2), m_a3(a3) {
+		}
+		
+		virtual void run() {
+			m_signal->dispatch(m_a1, m_a2, m_a3);
+		}
+		
+	private:
+		signal_type *m_signal;
+		typename _value_type<arg1_type>::type m_a1;
+		typename _value_type<arg2_type>::type m_a2;
+		typename _value_type<arg3_type>::type m_a3;
+	};
+	
+	template<class signal_type, class arg1_type, class arg2_type, class arg3_type, class arg4_type>
+	class _deferred_emission4 : public _deferred_emission {
+	public:
+		_deferred_emission4(signal_type *signal, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4): _deferred_emission(signal), m_signal(signal), m_a1(a1), m_a2(a2), m_a3(a3), m_a4(a4) {
+		}
+		
+		virtual void run() {
+			m_signal->dispatch(m_a1, m_a2, m_a3, m_a4);
+		}
+		
+	private:
+		signal_type *m_signal;
+		typename _value_type<arg1_type>::type m_a1;
+		typename _value_type<arg2_type>::type m_a2;
+		typename _value_type<arg3_type>::type m_a3;
+		typename _value_type<arg4_type>::type m_a4;
+	};
+	
+	template<class signal_type, class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type>
+	class _deferred_emission5 : public _deferred_emission {
+	public:
+		_deferred_emission5(signal_type *signal, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5): _deferred_emission(signal), m_signal(signal), m_a1(a1), m_a2(a2), m_a3(a3), m_a4(a4), m_a5(a5) {
+		}
+		
+		virtual void run() {
+			m_signal->dispatch(m_a1, m_a2, m_a3, m_a4, m_a5);
+		}
+		
+	private:
+		signal_type *m_signal;
+		typename _value_type<arg1_type>::type m_a1;
+		typename _value_type<arg2_type>::type m_a2;
+		typename _value_type<arg3_type>::type m_a3;
+		typename _value_type<arg4_type>::type m_a4;
+		typename _value_type<arg5_type>::type m_a5;
+	};
+	
+	template<class signal_type, class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type>
+	class _deferred_emission6 : public _deferred_emission {
+	public:
+		_deferred_emission6(signal_type *signal, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6): _deferred_emission(signal), m_signal(signal), m_a1(a1), m_a2(a2), m_a3(a3), m_a4(a4), m_a5(a5), m_a6(a6) {
+		}
+		
+		virtual void run() {
+			m_signal->dispatch(m_a1, m_a2, m_a3, m_a4, m_a5, m_a6);
+		}
+		
+	private:
+		signal_type *m_signal;
+		typename _value_type<arg1_type>::type m_a1;
+		typename _value_type<arg2_type>::type m_a2;
+		typename _value_type<arg3_type>::type m_a3;
+		typename _value_type<arg4_type>::type m_a4;
+		typename _value_type<arg5_type>::type m_a5;
+		typename _value_type<arg6_type>::type m_a6;
+	};
+	
+	template<class signal_type, class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class arg7_type>
+	class _deferred_emission7 : public _deferred_emission {
+	public:
+		_deferred_emission7(signal_type *signal, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6, arg7_type a7): _deferred_emission(signal), m_signal(signal), m_a1(a1), m_a2(a2), m_a3(a3), m_a4(a4), m_a5(a5), m_a6(a6), m_a7(a7) {
+		}
+		
+		virtual void run() {
+			m_signal->dispatch(m_a1, m_a2, m_a3, m_a4, m_a5, m_a6, m_a7);
+		}
+		
+	private:
+		signal_type *m_signal;
+		typename _value_type<arg1_type>::type m_a1;
+		typename _value_type<arg2_type>::type m_a2;
+		typename _value_type<arg3_type>::type m_a3;
+		typename _value_type<arg4_type>::type m_a4;
+		typename _value_type<arg5_type>::type m_a5;
+		typename _value_type<arg6_type>::type m_a6;
+		typename _value_type<arg7_type>::type m_a7;
+	};
+	
+	template<class signal_type, class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class arg7_type, class arg8_type>
+	class _deferred_emission8 : public _deferred_emission {
+	public:
+		_deferred_emission8(signal_type *signal, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6, arg7_type a7, arg8_type a8): _deferred_emission(signal), m_signal(signal), m_a1(a1), m_a2(a2), m_a3(a3), m_a4(a4), m_a5(a5), m_a6(a6), m_a7(a7), m_a8(a8) {
+		}
+		
+		virtual void run() {
+			m_signal->dispatch(m_a1, m_a2, m_a3, m_a4, m_a5, m_a6, m_a7, m_a8);
+		}
+		
+	private:
+		signal_type *m_signal;
+		typename _value_type<arg1_type>::type m_a1;
+		typename _value_type<arg2_type>::type m_a2;
+		typename _value_type<arg3_type>::type m_a3;
+		typename _value_type<arg4_type>::type m_a4;
+		typename _value_type<arg5_type>::type m_a5;
+		typename _value_type<arg6_type>::type m_a6;
+		typename _value_type<arg7_type>::type m_a7;
+		typename _value_type<arg8_type>::type m_a8;
+	};
+	
+	// Queue of the deferred emissions of the calling thread. The outermost
+	// emission of a trampolined signal owns it and runs the emissions its
+	// slots deferred, and those they defer in turn, one after the other, so
+	// the stack does not grow with the length of a cascade. Each deferred
+	// emission pins its signal. A queue joins a process-wide list the first
+	// time an emission is deferred to it, so that a signal destroyed on
+	// another thread can take its emissions out, and only then gets a lock.
+	class _trampoline {
+	public:
+		_trampoline(): m_outer(current()), m_head(NULL), m_tail(NULL), m_running(NULL), m_lock(NULL), m_listed(false), m_previous(NULL), m_next(NULL) {
+			if (m_outer == NULL) {
+				current() = this;
+			}
+		}
+		
+		~_trampoline() {
+			if (m_outer == NULL) {
+				if (m_listed) {
+					lock_block<_monitor> lock(&list());
+					
+					if (m_previous != NULL) {
+						m_previous->m_next = m_next;
+					} else {
+						head() = m_next;
+					}
+					
+					if (m_next != NULL) {
+						m_next->m_previous = m_previous;
+					}
+				}
+				
+				// A slot threw; the emissions left are dropped.
+				while (m_head != NULL) {
+					_deferred_emission *emission = m_head;
+					m_head = emission->m_next;
+					release(emission);
+				}
+				
+				delete m_lock;
+				current() = NULL;
+			}
+		}
+		
+		bool outermost() const {
+			return m_outer == NULL;
+		}
+		
+		// Takes emission, which is deleted if it cannot be queued.
+		void defer(_deferred_emission *emission, volatile long *pins) {
+			_trampoline *owner = outermost() ? this : m_outer;
+			
+			if (!owner->m_listed) {
+				try {
+					owner->m_lock = new _monitor();
+				} catch (...) {
+					delete emission;
+					throw;
+				}
+				
+				lock_block<_monitor> lock(&list());
+				owner->m_next = head();
+				
+				if (owner->m_next != NULL) {
+					owner->m_next->m_previous = owner;
+				}
+				
+				head() = owner;
+				owner->m_listed = true;
+			}
+			
+			_atomic_increment(pins);
+			emission->m_pins = pins;
+			lock_block<_monitor> lock(owner->m_lock);
+			
+			if (owner->m_tail != NULL) {
+				owner->m_tail->m_next = emission;
+			} else {
+				owner->m_head = emission;
+			}
+			
+			owner->m_tail = emission;
+		}
+		
+		// Runs the deferred emissions in the order they were made.
+		void drain() {
+			while (_deferred_emission *emission = pop()) {
+				_deferred_emission_owner owner(this, emission);
+				emission->run();
+			}
+		}
+		
+		// Drops the emissions of a signal that is being destroyed, from the
+		// queues of every thread. The signal waits for its pins afterwards,
+		// so emissions that other threads already started finish first. One
+		// that the calling thread is running, from which the signal is
+		// destroyed, no longer counts.
+		static void cancel(const void *signal) {
+			_trampoline *trampoline = current();
+			
+			if (trampoline != NULL && trampoline->m_running != NULL && trampoline->m_running->m_signal == signal) {
+				_atomic_decrement(trampoline->m_running->m_pins);
+				trampoline->m_running->m_pins = NULL;
+			}
+			
+			lock_block<_monitor> lock(&list());
+			
+			for (trampoline = head(); trampoline != NULL; trampoline = trampoline->m_next) {
+				trampoline->remove(signal);
+			}
+		}
+		
+	private:
+		// Deletes an emission once it has run, even if a slot throws.
+		class _deferred_emission_owner {
+		public:
+			_deferred_emission_owner(_trampoline *trampoline, _deferred_emission *emission): m_trampoline(trampoline), m_emission(emission) {
+				trampoline->m_running = emission;
+			}
+			
+			~_deferred_emission_owner() {
+				m_trampoline->m_running = NULL;
+				release(m_emission);
+			}
+			
+		private:
+			_trampoline *m_trampoline;
+			_deferred_emission *m_emission;
+		};
+		
+		// Nothing was deferred to a queue that is not listed.
+		_deferred_emission *pop() {
+			if (!m_listed) {
+				return NULL;
+			}
+			
+			lock_block<_monitor> lock(m_lock);
+			_deferred_emission *emission = m_head;
+			
+			if (emission != NULL) {
+				m_head = emission->m_next;
+				
+				if (m_head == NULL) {
+					m_tail = NULL;
+				}
+			}
+			
+			return emission;
+		}
+		
+		void remove(const void *signal) {
+			lock_block<_monitor> lock(m_lock);
+			_deferred_emission **link = &m_head;
+			m_tail = NULL;
+			
+			while (*link != NULL) {
+				_deferred_emission *emission = *link;
+				
+				if (emission->m_signal == signal) {
+					*link = emission->m_next;
+					release(emission);
+				} else {
+					m_tail = emission;
+					link = &emission->m_next;
+				}
+			}
+		}
+		
+		static void release(_deferred_emission *emission) {
+			if (emission->m_pins != NULL) {
+				_atomic_decrement(emission->m_pins);
+			}
+			
+			delete emission;
+		}
+		
+		static _trampoline *&current() {
+			static _SIGLY_THREAD_LOCAL _trampoline *trampoline = NULL;
+			return trampoline;
+		}
+		
+		// Guards the list of queues and, while it is walked, their removal.
+		static _monitor &list() {
+			static _monitor trampolines;
+			return trampolines;
+		}
+		
+		static _trampoline *&head() {
+			static _trampoline *trampolines = NULL;
+			return trampolines;
+		}
+		
+		_trampoline(const _trampoline &);
+		_trampoline &operator=(const _trampoline &);
+		
+		_trampoline *m_outer;
+		_deferred_emission *m_head;
+		_deferred_emission *m_tail;
+		// The emission being run by drain().
+		_deferred_emission *m_running;
+		// Guards the queue once it is listed.
+		_monitor *m_lock;
+		bool m_listed;
+		_trampoline *m_previous;
+		_trampoline *m_next;
+	};
+	
+	template<class mt_policy, class connections_list, bool published = _dispatch_traits<mt_policy>::published>
+	class _emission;
+	
+	template<class mt_policy>
+	class _signal_base;
+	
+	// What a signal needs of the LatencyBudget given to it: counting the
+	// consecutive overruns of each connection, and the connections due for
+	// demotion.
+	template<class mt_policy>
+	class _latency_budget {
+	public:
+		_latency_budget(double microseconds, unsigned long strikes, Executor *worker)
+		: m_microseconds(microseconds), m_strikes(strikes != 0 ? strikes : 1), m_worker(worker), m_suspects(0), m_due_count(0) {
+		}
+		
+		virtual ~_latency_budget() {
+		}
+		
+		double microseconds() const {
+			return m_microseconds;
+		}
+		
+		unsigned long strikes() const {
+			return m_strikes;
+		}
+		
+		Executor *worker() const {
+			return m_worker;
+		}
+		
+		// Counts a slot call of the connection that started at the given
+		// time. Calls within the budget only lock while some connection has
+		// overrun it, to start its count again.
+		void measure(_signal_base<mt_policy> *signal, const void *conn, double start) {
+			if (_now() - start <= m_microseconds) {
+				if (_atomic_load(&m_suspects) != 0) {
+					m_monitor.lock();
+					m_overruns.erase(conn);
+					_atomic_exchange(&m_suspects, (long)m_overruns.size());
+					m_monitor.unlock();
+				}
+				
+				return;
+			}
+			
+			m_monitor.lock();
+			
+			if (++m_overruns[conn] >= m_strikes) {
+				m_overruns.erase(conn);
+				m_due.push_back(std::make_pair(signal, conn));
+				_atomic_increment(&m_due_count);
+			}
+			
+			_atomic_exchange(&m_suspects, (long)m_overruns.size());
+			m_monitor.unlock();
+		}
+		
+		bool due(_signal_base<mt_policy> *signal) {
+			if (_atomic_load(&m_due_count) == 0) {
+				return false;
+			}
+			
+			m_monitor.lock();
+			bool found = false;
+			
+			for (std::size_t i = 0; i < m_due.size() && !found; ++i) {
+				found = m_due[i].first == signal;
+			}
+			
+			m_monitor.unlock();
+			return found;
+		}
+		
+		// Moves the connections of the signal due for demotion to conns.
+		void take(_signal_base<mt_policy> *signal, std::vector<const void *> &conns) {
+			m_monitor.lock();
+			std::size_t kept = 0;
+			
+			for (std::size_t i = 0; i < m_due.size(); ++i) {
+				if (m_due[i].first == signal) {
+					conns.push_back(m_due[i].second);
+				} else {
+					m_due[kept++] = m_due[i];
+				}
+			}
+			
+			m_due.resize(kept);
+			_atomic_exchange(&m_due_count, (long)kept);
+			m_monitor.unlock();
+		}
+		
+		// Forgets a connection the signal released, whose address may be
+		// reused.
+		void forget(const void *conn) {
+			m_monitor.lock();
+			m_overruns.erase(conn);
+			_atomic_exchange(&m_suspects, (long)m_overruns.size());
+			std::size_t kept = 0;
+			
+			for (std::size_t i = 0; i < m_due.size(); ++i) {
+				if (m_due[i].second != conn) {
+					m_due[kept++] = m_due[i];
+				}
+			}
+			
+			m_due.resize(kept);
+			_atomic_exchange(&m_due_count, (long)kept);
+			m_monitor.unlock();
+		}
+		
+		// Called without any lock after the signal demoted a connection of
+		// the receiver.
+		virtual void report(_signal_base<mt_policy> *signal, HasSlots<mt_policy> *receiver) = 0;
+		
+	private:
+		_latency_budget(const _latency_budget &);
+		_latency_budget &operator=(const _latency_budget &);
+		
+		double m_microseconds;
+		unsigned long m_strikes;
+		Executor *m_worker;
+		_monitor m_monitor;
+		std::map<const void *, unsigned long> m_overruns;
+		volatile long m_suspects;
+		std::vector<std::pair<_signal_base<mt_policy> *, const void *> > m_due;
+		volatile long m_due_count;
+	};
+	
+	// Times a slot call against the signal's latency budget, if any.
+	template<class mt_policy>
+	class _slot_clock {
+	public:
+		_slot_clock(_latency_budget<mt_policy> *budget, _signal_base<mt_policy> *signal, const void *conn)
+		: m_budget(budget), m_signal(signal), m_conn(conn), m_start(budget != NULL ? _now() : 0.0) {
+		}
+		
+		// Not called if the slot throws.
+		void stop() {
+			if (m_budget != NULL) {
+				m_budget->measure(m_signal, m_conn, m_start);
+			}
+		}
+		
+	private:
+		_latency_budget<mt_policy> *m_budget;
+		_signal_base<mt_policy> *m_signal;
+		const void *m_conn;
+		double m_start;
+	};
+	
+	// Connection bookkeeping shared by Signal0..Signal8. None of it depends on
+	// the argument types, so it is instantiated once per policy however many
+	// signatures a program uses.
+	template<class mt_policy>
+	class _signal_base : public mt_policy {
+	public:
+		typedef std::list<_connection_base<mt_policy> *> connections_list;
+		typedef typename connections_list::const_iterator const_iterator;
+		typedef typename connections_list::iterator iterator;
+		
+		_signal_base(): m_emitting(0), m_pins(0), m_has_garbage(false), m_reordered(false), m_trampolined(0), m_sequence(0), m_items(NULL), m_count(0), m_connection_count(0), m_connection_bytes(0), m_index(NULL), m_index_bytes(0), m_groups(NULL), m_arrivals(NULL), m_combining(0), m_budget(NULL) {
+			_SIGLY_REGISTER(true);
+		}
+		
+		_signal_base(const _signal_base &s): mt_policy(s), m_emitting(0), m_pins(0), m_has_garbage(false), m_reordered(false), m_trampolined(s.m_trampolined), m_sequence(0), m_items(NULL), m_count(0), m_connection_count(0), m_connection_bytes(0), m_index(NULL), m_index_bytes(0), m_groups(s.m_groups != NULL ? new group_map() : NULL), m_arrivals(NULL), m_combining(0), m_budget(s.latencyBudget()) {
+			{
+				write_block lock(this, s.m_connected_slots.size());
+				const_iterator it = s.m_connected_slots.begin();
+				const_iterator itEnd = s.m_connected_slots.end();
+				
+				while (it != itEnd) {
+					if (*it != NULL) {
+						(*it)->getdest()->signalConnect(this);
+						append((*it)->clone());
+					}
+					
+					++it;
+				}
+			}
+			
+			_SIGLY_REGISTER(true);
+		}
+		
+		~_signal_base() {
+			_SIGLY_UNREGISTER();
+			
+			// Deferred emissions pin the signal, including those queued
+			// before trampolining was turned off.
+			if (m_trampolined || _atomic_load(&m_pins) != 0) {
+				_trampoline::cancel(this);
+			}
+			
+			disconnectAll();
+			waitForPins();
+			delete m_index;
+			delete m_groups;
+		}
+		
+		void disconnectAll() {
+			write_block lock(this);
+			iterator it = m_connected_slots.begin();
+			iterator itEnd = m_connected_slots.end();
+			
+			while (it != itEnd) {
+				if (*it != NULL) {
+					(*it)->getdest()->signalDisconnect(this);
+					release(it++);
+					continue;
+				}
+				
+				++it;
+			}
+		}
+		
+		void disconnect(HasSlots<mt_policy>* pclass) {
+			write_block lock(this);
+			iterator it = m_connected_slots.begin();
+			iterator itEnd = m_connected_slots.end();
+			
+			while (it != itEnd) {
+				if (*it != NULL && (*it)->getdest() == pclass) {
+					release(it++);
+					pclass->signalDisconnect(this);
+					continue;
+				}
+				
+				++it;
+			}
+		}
+		
+		void slot_disconnect(HasSlots<mt_policy>* pslot) {
+			write_block lock(this);
+			iterator it = m_connected_slots.begin();
+			iterator itEnd = m_connected_slots.end();
+			
+			while (it != itEnd) {
+				iterator itNext = it;
+				++itNext;
+				
+				if (*it != NULL && (*it)->getdest() == pslot) {
+					release(it);
+				}
+				
+				it = itNext;
+			}
+		}
+		
+		// Removes the connections of all the given receivers in one pass.
+		void slot_disconnect(const std::set<HasSlots<mt_policy> *> &receivers) {
+			write_block lock(this);
+			iterator it = m_connected_slots.begin();
+			iterator itEnd = m_connected_slots.end();
+			
+			while (it != itEnd) {
+				iterator itNext = it;
+				++itNext;
+				
+				if (*it != NULL && receivers.count((*it)->getdest()) != 0) {
+					release(it);
+				}
+				
+				it = itNext;
+			}
+		}
+		
+		void slot_duplicate(const HasSlots<mt_policy>* oldtarget, HasSlots<mt_policy>* newtarget) {
+			write_block lock(this, EVERY);
+			iterator it = m_connected_slots.begin();
+			iterator itEnd = m_connected_slots.end();
+			
+			while (it != itEnd) {
+				if (*it != NULL && (*it)->getdest() == oldtarget) {
+					append((*it)->duplicate(newtarget));
+					newtarget->signalConnect(this);
+				}
+				
+				++it;
+			}
+		}
+		
+		bool empty() {
+			lock_block<mt_policy> lock(this);
+			
+			for (const_iterator it = m_connected_slots.begin(); it != m_connected_slots.end(); ++it) {
+				if (*it != NULL) {
+					return false;
+				}
+			}
+			
+			return true;
+		}
+		
+		// Frees the connections that were disconnected while the signal was
+		// being emitted, once no emission is running anymore.
+		void collectGarbage() {
+			lock_block<mt_policy> lock(this);
+			
+			if (m_emitting == 0 && m_has_garbage) {
+				m_connected_slots.remove(NULL);
+				
+				for (const_iterator it = m_garbage.begin(); it != m_garbage.end(); ++it) {
+					delete *it;
+				}
+				
+				m_garbage.clear();
+				m_has_garbage = false;
+			}
+		}
+		
+		// A receiver pins a sender it found in its sender set before calling
+		// slot_disconnect() or slot_duplicate() without holding its own lock.
+		// The sender's destructor waits for those calls to finish.
+		void pin() {
+			_atomic_increment(&m_pins);
+		}
+		
+		void unpin() {
+			_atomic_decrement(&m_pins);
+		}
+		
+		std::size_t connectionCount() const {
+			return (std::size_t)_atomic_load(&m_connection_count);
+		}
+		
+		// Bytes owned by the signal: the object itself, the connections and
+		// their list nodes, the published array, the binding index and what
+		// the policy allocated. Does not lock the signal.
+		std::size_t memoryUsage() const {
+			return sizeof(*this) + (std::size_t)_atomic_load(&m_connection_bytes) + (std::size_t)_atomic_load(&m_count) * sizeof(void *) + (std::size_t)_atomic_load(&m_index_bytes) + _heap_size(static_cast<const mt_policy *>(this));
+		}
+		
+		// With GROUPED_ORDER, the current connections are regrouped at once,
+		// unless the signal is being emitted on another thread, in which case
+		// only the connections made from then on are grouped. Slots
+		// connected during an emission may be called by it or not.
+		void setDispatchOrder(DispatchOrder order) {
+			write_block lock(this);
+			
+			if (order == CONNECTION_ORDER) {
+				delete m_groups;
+				m_groups = NULL;
+			} else if (m_groups == NULL) {
+				m_groups = new group_map();
+				
+				if (m_emitting == 0) {
+					regroup();
+				}
+			}
+		}
+		
+		DispatchOrder dispatchOrder() const {
+			return m_groups != NULL ? GROUPED_ORDER : CONNECTION_ORDER;
+		}
+		
+		// A trampolined signal emitted from a slot, while another emission
+		// of a trampolined signal is running on the thread, does not call
+		// its slots right away. The emission is queued with copies of its
+		// arguments and run by the outermost emission once the emissions
+		// queued before it are done, so cascades run breadth first, with a
+		// stack and a set of locked signals that do not grow with their
+		// depth.
+		void setTrampolined(bool trampolined) {
+			_atomic_exchange(&m_trampolined, trampolined ? 1 : 0);
+		}
+		
+		bool isTrampolined() const {
+			return _atomic_load(&m_trampolined) != 0;
+		}
+		
+		// Times the slots against the budget, see LatencyBudget, or stops
+		// timing them if budget is NULL. Connections demoted already stay
+		// demoted.
+		void setLatencyBudget(_latency_budget<mt_policy> *budget) {
+			_atomic_exchange(&m_budget, budget);
+		}
+		
+		_latency_budget<mt_policy> *latencyBudget() const {
+			return static_cast<_latency_budget<mt_policy> *>(_atomic_load(&m_budget));
+		}
+		
+		// Reads the array published by the last change. Only used with
+		// published policies, inside an emission's _read_epoch section.
+		void snapshot(_connection_base<mt_policy> *const *&items, long &count) const {
+			for (;;) {
+				long sequence = _atomic_load(&m_sequence);
+				
+				if ((sequence & 1) == 0) {
+					items = static_cast<_connection_base<mt_policy> *const *>(_atomic_load(&m_items));
+					count = _atomic_load(&m_count);
+					
+					if (_atomic_load(&m_sequence) == sequence) {
+						return;
+					}
+				}
+				
+				_thread_yield();
+			}
+		}
+		
+	protected:
+		// write_block reserves room for as many more connections as there
+		// are.
+		static const std::size_t EVERY = ~std::size_t(0);
+		
+		// Exclusive access for changing the connection list. With a published
+		// policy the new list is published when the block ends, and what the
+		// change removed is retired once the signal is unlocked. The block
+		// allocates what publishing needs up front, for a change adding at
+		// most extra connections, so that only its constructor can throw.
+		class write_block {
+		public:
+			write_block(_signal_base *signal, std::size_t extra = 0): m_signal(signal), m_items(NULL), m_node(NULL) {
+				m_signal->lock();
+				std::size_t room = ~std::size_t(0);
+				
+				if (_dispatch_traits<mt_policy>::published) {
+					try {
+						room = m_signal->reserve(extra, m_items, m_node);
+					} catch (...) {
+						m_signal->unmerge();
+						m_signal->unlock();
+						throw;
+					}
+				}
+				
+				if (_atomic_load(&m_signal->m_arrivals) != NULL) {
+					m_signal->merge(room);
+				}
+			}
+			
+			~write_block() {
+				if (_dispatch_traits<mt_policy>::published) {
+					_retired *retired = m_signal->publish(m_items, m_node);
+					m_signal->unlock();
+					
+					if (retired != NULL) {
+						_read_epoch::retire(retired);
+					}
+				} else {
+					m_signal->unlock();
+				}
+			}
+			
+		private:
+			_signal_base *m_signal;
+			_connection_base<mt_policy> **m_items;
+			_retired *m_node;
+		};
+		
+		// Adds a connection made by one of the typed connect() functions.
+		// The connection is pushed on a lock-free stack, and whichever
+		// connecting thread gets the lock first appends every connection
+		// pushed so far, while the others sleep until theirs is appended
+		// instead of queuing on the lock. A burst of concurrent connects thus
+		// takes the lock a few times instead of once per connection. The
+		// connection is in place, and visible to emissions, when attach()
+		// returns. If it cannot be appended, it is deleted and
+		// std::bad_alloc is thrown.
+		void attach(_connection_base<mt_policy> *conn) {
+			if (_atomic_compare_exchange(&m_combining, IDLE, COMBINING) == IDLE) {
+				combine(conn);
+				return;
+			}
+			
+			_arrival arrival(conn);
+			void *head;
+			
+			do {
+				head = _atomic_load(&m_arrivals);
+				arrival.next = static_cast<_arrival *>(head);
+			} while (_atomic_compare_exchange(&m_arrivals, head, &arrival) != head);
+			
+			_monitor &monitor = combiners();
+			monitor.lock();
+			
+			while (_atomic_load(&arrival.state) == _arrival::WAITING) {
+				long combining = _atomic_compare_exchange(&m_combining, IDLE, COMBINING);
+				
+				if (combining == IDLE) {
+					monitor.unlock();
+					combine(NULL);
+					monitor.lock();
+				} else if (combining == AWAITED || _atomic_compare_exchange(&m_combining, COMBINING, AWAITED) == COMBINING) {
+					monitor.wait();
+				}
+			}
+			
+			monitor.unlock();
+			
+			if (arrival.state == _arrival::FAILED) {
+				throw std::bad_alloc();
+			}
+		}
+		
+		// Adds conn unless the same slot of the same receiver is connected
+		// already, in which case conn is deleted. So it is if the signal runs
+		// out of memory.
+		bool attachUnique(_connection_base<mt_policy> *conn) {
+			_connection_base<mt_policy> *owned = conn;
+			
+			try {
+				write_block lock(this, 1);
+				const void *bytes;
+				std::size_t size = conn->method(bytes);
+				
+				if (!lookup(conn->getdest(), bytes, size).empty()) {
+					delete conn;
+					return false;
+				}
+				
+				owned = NULL;
+				link(conn);
+				return true;
+			} catch (...) {
+				delete owned;
+				throw;
+			}
+		}
+		
+		// Removes the connections of pclass to the member function whose
+		// representation is given.
+		bool detach(HasSlots<mt_policy> *pclass, const void *bytes, std::size_t size) {
+			write_block lock(this);
+			std::vector<iterator> found = lookup(pclass, bytes, size);
+			
+			for (typename std::vector<iterator>::const_iterator it = found.begin(); it != found.end(); ++it) {
+				if (release(*it)) {
+					pclass->signalDisconnect(this);
+				}
+			}
+			
+			return !found.empty();
+		}
+		
+		void waitForPins() {
+			while (_atomic_load(&m_pins) != 0) {
+				_thread_yield();
+			}
+		}
+		
+		// Called by the signals after each emission they timed, with the
+		// signal no longer locked by it: demotes the connections that used
+		// up the latency budget.
+		void settle(_latency_budget<mt_policy> *budget) {
+			if (budget != NULL && budget->due(this)) {
+				demote(budget);
+			}
+		}
+		
+		connections_list m_connected_slots;
+		
+		// Number of emissions in progress. Only changes with the signal
+		// locked; while it is not zero, connections are unlinked instead of
+		// deleted.
+		volatile long m_emitting;
+		volatile long m_pins;
+		bool m_has_garbage;
+		bool m_reordered;
+		volatile long m_trampolined;
+		
+		template<class, class, bool>
+		friend class _emission;
+		
+	private:
+		// A connection waiting to be appended, on the stack of the thread
+		// that connects it.
+		struct _arrival {
+			enum {
+				WAITING,
+				DONE,
+				FAILED
+			};
+			
+			_arrival(_connection_base<mt_policy> *conn): conn(conn), next(NULL), state(WAITING) {
+			}
+			
+			_connection_base<mt_policy> *conn;
+			_arrival *next;
+			volatile long state;
+		};
+		
+		// States of m_combining. AWAITED is COMBINING with threads asleep on
+		// combiners() until the combiner is done.
+		enum {
+			IDLE,
+			COMBINING,
+			AWAITED
+		};
+		
+		// Where the connecting threads whose connections are being appended
+		// by another one sleep, whatever the signal.
+		static _monitor &combiners() {
+			static _monitor waiting;
+			return waiting;
+		}
+		
+		// Takes the lock on behalf of the connecting threads, whose
+		// connections write_block appends, and appends conn if not NULL.
+		// Then wakes the threads that went to sleep meanwhile, whether or
+		// not their connection was appended, so that one of them combines
+		// the rest.
+		void combine(_connection_base<mt_policy> *conn) {
+			_connection_base<mt_policy> *owned = conn;
+			
+			try {
+				write_block lock(this, 1);
+				owned = NULL;
+				
+				if (conn != NULL) {
+					link(conn);
+				}
+			} catch (...) {
+				delete owned;
+				uncombine();
+				throw;
+			}
+			
+			uncombine();
+		}
+		
+		void uncombine() {
+			if (_atomic_exchange(&m_combining, IDLE) == AWAITED) {
+				_monitor &monitor = combiners();
+				monitor.lock();
+				monitor.notifyAll();
+				monitor.unlock();
+			}
+		}
+		
+		// Appends conn and registers the signal with its receiver. If either
+		// runs out of memory, conn is taken back and deleted before the
+		// exception is rethrown.
+		void link(_connection_base<mt_policy> *conn) {
+			iterator added;
+			
+			try {
+				added = append(conn);
+			} catch (...) {
+				delete conn;
+				throw;
+			}
+			
+			try {
+				conn->getdest()->signalConnect(this);
+			} catch (...) {
+				unappend(added);
+				throw;
+			}
+		}
+		
+		// Appends the pending connections in the order they were pushed, at
+		// most room of them. An arrival may not be touched once it is marked
+		// done, as its thread then returns.
+		void merge(std::size_t room) {
+			_arrival *reversed = static_cast<_arrival *>(_atomic_exchange(&m_arrivals, NULL));
+			_arrival *arrival = NULL;
+			
+			while (reversed != NULL) {
+				_arrival *next = reversed->next;
+				reversed->next = arrival;
+				arrival = reversed;
+				reversed = next;
+			}
+			
+			while (arrival != NULL) {
+				_arrival *next = arrival->next;
+				
+				if (room-- == 0) {
+					requeue(arrival);
+					return;
+				}
+				
+				try {
+					link(arrival->conn);
+				} catch (...) {
+					requeue(next);
+					_atomic_exchange(&arrival->state, _arrival::FAILED);
+					return;
+				}
+				
+				_atomic_exchange(&arrival->state, _arrival::DONE);
+				arrival = next;
+			}
+		}
+		
+		// Fails the pending connections, which are deleted, when there is no
+		// memory to append them.
+		void unmerge() {
+			_arrival *arrival = static_cast<_arrival *>(_atomic_exchange(&m_arrivals, NULL));
+			
+			while (arrival != NULL) {
+				_arrival *next = arrival->next;
+				delete arrival->conn;
+				_atomic_exchange(&arrival->state, _arrival::FAILED);
+				arrival = next;
+			}
+		}
+		
+		// Pushes the arrivals back, to wait for the next merge.
+		void requeue(_arrival *arrival) {
+			for (_arrival *next; arrival != NULL; arrival = next) {
+				next = arrival->next;
+				void *head;
+				
+				do {
+					head = _atomic_load(&m_arrivals);
+					arrival->next = static_cast<_arrival *>(head);
+				} while (_atomic_compare_exchange(&m_arrivals, head, arrival) != head);
+			}
+		}
+		
+		// Allocates what publishing a change needs: a node to retire the
+		// current array in, and a new array with room for the connections,
+		// the arrivals pushed so far and extra more. Returns how many
+		// arrivals fit.
+		std::size_t reserve(std::size_t extra, _connection_base<mt_policy> **&items, _retired *&node) {
+			std::size_t size = m_connected_slots.size();
+			std::size_t arrivals = 0;
+			
+			for (_arrival *arrival = static_cast<_arrival *>(_atomic_load(&m_arrivals)); arrival != NULL; arrival = arrival->next) {
+				++arrivals;
+			}
+			
+			std::size_t capacity = size + (extra == EVERY ? size : extra) + arrivals;
+			node = new retired();
+			
+			try {
+				items = capacity != 0 ? new _connection_base<mt_policy> *[capacity] : NULL;
+			} catch (...) {
+				delete node;
+				node = NULL;
+				throw;
+			}
+			
+			return arrivals;
+		}
+		
+		// Replaces the connections due for demotion in place, so that their
+		// position, group and index entries stay the same.
+		void demote(_latency_budget<mt_policy> *budget) {
+			std::vector<HasSlots<mt_policy> *> receivers;
+			
+			{
+				write_block lock(this);
+				std::vector<const void *> due;
+				budget->take(this, due);
+				
+				for (iterator it = m_connected_slots.begin(); it != m_connected_slots.end(); ++it) {
+					if (*it == NULL || std::find(due.begin(), due.end(), *it) == due.end()) {
+						continue;
+					}
+					
+					_connection_base<mt_policy> *demoted = (*it)->demote(budget->worker());
+					
+					if (demoted != NULL) {
+						account(*it, -1);
+						account(demoted, 1);
+						budget->forget(*it);
+						*it = demoted;
+						m_reordered = true;
+						receivers.push_back(demoted->getdest());
+					}
+				}
+			}
+			
+			for (std::size_t i = 0; i < receivers.size(); ++i) {
+				budget->report(this, receivers[i]);
+			}
+		}
+		
+		// Leaves the connections as they were if it throws; conn is then
+		// still the caller's.
+		iterator append(_connection_base<mt_policy> *conn) {
+			iterator added;
+			
+			if (m_groups != NULL) {
+				typename group_map::iterator group = m_groups->find(conn->stub());
+				
+				if (group != m_groups->end()) {
+					iterator after = group->second;
+					added = m_connected_slots.insert(++after, conn);
+					group->second = added;
+				} else {
+					added = m_connected_slots.insert(m_connected_slots.end(), conn);
+					
+					try {
+						m_groups->insert(std::make_pair(conn->stub(), added));
+					} catch (...) {
+						m_connected_slots.erase(added);
+						throw;
+					}
+				}
+			} else {
+				added = m_connected_slots.insert(m_connected_slots.end(), conn);
+			}
+			
+			account(conn, 1);
+			
+			if (m_index != NULL) {
+				try {
+					index(added);
+				} catch (const std::bad_alloc &) {
+					// The index is rebuilt by the next lookup.
+					delete m_index;
+					m_index = NULL;
+					_atomic_exchange(&m_index_bytes, 0);
+				}
+			}
+			
+			return added;
+		}
+		
+		// Takes back a connection that append() added under the same lock,
+		// before any emission could call it, and deletes it. Allocates
+		// nothing, so that it can undo a connect that ran out of memory.
+		void unappend(iterator it) {
+			_connection_base<mt_policy> *conn = *it;
+			account(conn, -1);
+			
+			if (m_index != NULL) {
+				unindex(it);
+			}
+			
+			if (m_groups != NULL) {
+				ungroup(it);
+			}
+			
+			if (_dispatch_traits<mt_policy>::published || m_emitting == 0) {
+				m_connected_slots.erase(it);
+			} else {
+				*it = NULL;
+				m_has_garbage = true;
+			}
+			
+			delete conn;
+		}
+		
+		// Last connection of each group, in GROUPED_ORDER.
+		typedef std::map<const void *, iterator> group_map;
+		
+		// Moves every connection behind the last one of its group.
+		// Iterators stay valid, including those of the binding index.
+		void regroup() {
+			iterator it = m_connected_slots.begin();
+			
+			while (it != m_connected_slots.end()) {
+				iterator current = it++;
+				
+				if (*current == NULL) {
+					continue;
+				}
+				
+				typename group_map::iterator group = m_groups->find((*current)->stub());
+				
+				if (group == m_groups->end()) {
+					m_groups->insert(std::make_pair((*current)->stub(), current));
+				} else {
+					iterator after = group->second;
+					
+					if (++after != current) {
+						m_connected_slots.splice(after, m_connected_slots, current);
+					}
+					
+					group->second = current;
+				}
+			}
+			
+			m_reordered = true;
+		}
+		
+		// Makes the connection before it the last of its group, if there is
+		// one; NULL entries of removed connections are skipped.
+		void ungroup(iterator it) {
+			const void *stub = (*it)->stub();
+			typename group_map::iterator group = m_groups->find(stub);
+			
+			if (group->second != it) {
+				return;
+			}
+			
+			iterator previous = it;
+			
+			while (previous != m_connected_slots.begin()) {
+				if (*--previous != NULL) {
+					break;
+				}
+			}
+			
+			if (previous != it && *previous != NULL && (*previous)->stub() == stub) {
+				group->second = previous;
+			} else {
+				m_groups->erase(group);
+			}
+		}
+		
+		// Only changes with the signal locked; read from anywhere.
+		void account(_connection_base<mt_policy> *conn, long sign) {
+			_atomic_exchange(&m_connection_count, m_connection_count + sign);
+			_atomic_exchange(&m_connection_bytes, m_connection_bytes + sign * (long)(conn->size() + _LIST_NODE_SIZE));
+		}
+		
+		static std::size_t linksOf(const void *signal) {
+			return static_cast<const _signal_base *>(signal)->connectionCount();
+		}
+		
+		static std::size_t bytesOf(const void *signal) {
+			return static_cast<const _signal_base *>(signal)->memoryUsage();
+		}
+		
+		// Index of the connections by slot and by receiver, built by the first
+		// connectUnique() or disconnect() of a single slot, so that both look
+		// up a slot in constant time however many connections the signal has.
+		// It is kept up to date from then on.
+		struct binding_index {
+			// Every connection, hashed by receiver and member function.
+			_hash_index<iterator> bindings;
+			// Number of connections of each receiver.
+			_hash_index<std::pair<HasSlots<mt_policy> *, long> > receivers;
+		};
+		
+		static std::size_t hashReceiver(const HasSlots<mt_policy> *dest) {
+			return _hash_bytes(&dest, sizeof(dest), 2166136261u);
+		}
+		
+		static std::size_t hashBinding(const HasSlots<mt_policy> *dest, const void *bytes, std::size_t size) {
+			return _hash_bytes(bytes, size, hashReceiver(dest));
+		}
+		
+		static std::size_t hashBinding(const _connection_base<mt_policy> *conn) {
+			const void *bytes;
+			std::size_t size = conn->method(bytes);
+			return hashBinding(conn->getdest(), bytes, size);
+		}
+		
+		// The connections of dest to the member function, building the index
+		// if needed.
+		std::vector<iterator> lookup(const HasSlots<mt_policy> *dest, const void *bytes, std::size_t size) {
+			if (m_index == NULL) {
+				m_index = new binding_index();
+				
+				for (iterator it = m_connected_slots.begin(); it != m_connected_slots.end(); ++it) {
+					if (*it != NULL) {
+						index(it);
+					}
+				}
+				
+				indexed();
+			}
+			
+			std::vector<iterator> found;
+			std::size_t hash = hashBinding(dest, bytes, size);
+			typename _hash_index<iterator>::bucket &candidates = m_index->bindings.at(hash);
+			
+			for (std::size_t i = 0; i < candidates.size(); ++i) {
+				const void *other;
+				_connection_base<mt_policy> *conn = *candidates[i].value;
+				
+				if (candidates[i].hash == hash && conn->getdest() == dest && conn->method(other) == size && std::memcmp(other, bytes, size) == 0) {
+					found.push_back(candidates[i].value);
+				}
+			}
+			
+			return found;
+		}
+		
+		void index(iterator it) {
+			HasSlots<mt_policy> *dest = (*it)->getdest();
+			std::size_t hash = hashReceiver(dest);
+			typename _hash_index<std::pair<HasSlots<mt_policy> *, long> >::bucket &receivers = m_index->receivers.at(hash);
+			std::size_t i = 0;
+			
+			while (i < receivers.size() && receivers[i].value.first != dest) {
+				++i;
+			}
+			
+			if (i < receivers.size()) {
+				++receivers[i].value.second;
+			} else {
+				m_index->receivers.insert(hash, std::make_pair(dest, 1L));
+			}
+			
+			m_index->bindings.insert(hashBinding(*it), it);
+			indexed();
+		}
+		
+		// Returns whether it was the last connection of its receiver.
+		bool unindex(iterator it) {
+			typename _hash_index<iterator>::bucket &bindings = m_index->bindings.at(hashBinding(*it));
+			std::size_t i = 0;
+			
+			while (bindings[i].value != it) {
+				++i;
+			}
+			
+			m_index->bindings.erase(bindings, i);
+			
+			HasSlots<mt_policy> *dest = (*it)->getdest();
+			typename _hash_index<std::pair<HasSlots<mt_policy> *, long> >::bucket &receivers = m_index->receivers.at(hashReceiver(dest));
+			i = 0;
+			
+			while (receivers[i].value.first != dest) {
+				++i;
+			}
+			
+			bool last = --receivers[i].value.second == 0;
+			
+			if (last) {
+				m_index->receivers.erase(receivers, i);
+			}
+			
+			indexed();
+			return last;
+		}
+		
+		void indexed() {
+			_atomic_exchange(&m_index_bytes, (long)(sizeof(binding_index) + m_index->bindings.bytes() + m_index->receivers.bytes()));
+		}
+		
+		// Deletes a connection, or while emissions are running leaves NULL in
+		// its place and keeps it until collectGarbage(). Returns whether the
+		// receiver has no other connection, when the index is built.
+		bool release(iterator it) {
+			account(*it, -1);
+			
+			if (_latency_budget<mt_policy> *budget = latencyBudget()) {
+				budget->forget(*it);
+			}
+			
+			bool last = m_index != NULL && unindex(it);
+			
+			if (m_groups != NULL) {
+				ungroup(it);
+			}
+			
+			if (_dispatch_traits<mt_policy>::published) {
+				m_garbage.push_back(*it);
+				m_connected_slots.erase(it);
+				m_has_garbage = true;
+			} else if (m_emitting == 0) {
+				delete *it;
+				m_connected_slots.erase(it);
+			} else {
+				m_garbage.push_back(*it);
+				*it = NULL;
+				m_has_garbage = true;
+			}
+			
+			return last;
+		}
+		
+		// The published array and the connections it no longer holds.
+		class retired : public _retired {
+		public:
+			retired(): m_items(NULL) {
+			}
+			
+			~retired() {
+				for (const_iterator it = m_connections.begin(); it != m_connections.end(); ++it) {
+					delete *it;
+				}
+				
+				delete [] m_items;
+			}
+			
+			virtual bool holds(const void *item) const {
+				return std::find(m_connections.begin(), m_connections.end(), item) != m_connections.end();
+			}
+			
+			connections_list m_connections;
+			_connection_base<mt_policy> **m_items;
+		};
+		
+		// Swaps in the connections, copied to the array reserve() allocated,
+		// unless nothing changed, in which case the array and the node are
+		// freed. Readers retry while the sequence is odd or has moved.
+		_retired *publish(_connection_base<mt_policy> **items, _retired *node) {
+			long count = (long)m_connected_slots.size();
+			retired *previous = static_cast<retired *>(node);
+			
+			if (!m_has_garbage && !m_reordered && count == m_count) {
+				delete [] items;
+				delete previous;
+				return NULL;
+			}
+			
+			if (count == 0) {
+				delete [] items;
+				items = NULL;
+			}
+			
+			std::copy(m_connected_slots.begin(), m_connected_slots.end(), items);
+			_atomic_increment(&m_sequence);
+			previous->m_items = static_cast<_connection_base<mt_policy> **>(_atomic_exchange(&m_items, items));
+			_atomic_exchange(&m_count, count);
+			_atomic_increment(&m_sequence);
+			
+			previous->m_connections.swap(m_garbage);
+			m_has_garbage = false;
+			m_reordered = false;
+			return previous;
+		}
+		
+		connections_list m_garbage;
+		volatile long m_sequence;
+		void *volatile m_items;
+		volatile long m_count;
+		volatile long m_connection_count;
+		volatile long m_connection_bytes;
+		binding_index *m_index;
+		volatile long m_index_bytes;
+		group_map *m_groups;
+		// Connections pushed by attach() and not appended yet.
+		void *volatile m_arrivals;
+		// Set while a connecting thread waits for the lock to append them.
+		volatile long m_combining;
+		void *volatile m_budget;
+#ifdef SIGLY_ENABLE_REGISTRY
+		_registry_entry m_entry;
+#endif
+	};
+	
+	// Signals connected to a receiver, slot calls running on it and the
+	// executor of its queued calls.
+	template<class mt_policy>
+	struct _receiver_state {
+		_receiver_state(): calls(0), executor(NULL), count(0) {
+		}
+		
+		std::set<_signal_base<mt_policy> *> senders;
+		volatile long calls;
+		void *volatile executor;
+		volatile long count;
+	};
+	
+	// Receiver protocol shared by the HasSlots specializations. The storage
+	// base decides where the _receiver_state lives and which lock guards it:
+	// getState() returns the state or NULL if it was never needed, inflate()
+	// creates it and mutexOf() returns its lock.
+	template<class mt_policy, class storage>
+	class _receiver : public storage {
+	private:
+		typedef typename storage::state_type state_type;
+		typedef typename storage::lock_type lock_type;
+		typedef typename std::set<_signal_base<mt_policy> *>::const_iterator const_iterator;
+		
+	public:
+		void signalConnect(_signal_base<mt_policy>* sender) {
+			state_type *target = this->inflate();
+			lock_block<lock_type> lock(this->mutexOf(target));
+			target->senders.insert(sender);
+			countSenders(target);
+		}
+		
+		void signalDisconnect(_signal_base<mt_policy>* sender) {
+			state_type *target = this->getState();
+			
+			if (target != NULL) {
+				lock_block<lock_type> lock(this->mutexOf(target));
+				target->senders.erase(sender);
+				countSenders(target);
+			}
+		}
+		
+		// Removes every connection to this object, then waits for the slot
+		// calls already running on other threads. Each sender is unlinked with
+		// only its own lock held, so that locks are always taken in the
+		// signal-then-receiver order used by connect and shoot.
+		void disconnectAll() {
+			state_type *target = this->getState();
+			
+			if (target == NULL) {
+				return;
+			}
+			
+			for (;;) {
+				_signal_base<mt_policy> *sender;
+				
+				{
+					lock_block<lock_type> lock(this->mutexOf(target));
+					
+					if (target->senders.empty()) {
+						break;
+					}
+					
+					sender = *target->senders.begin();
+					target->senders.erase(target->senders.begin());
+					countSenders(target);
+					sender->pin();
+				}
+				
+				sender->slot_disconnect(self());
+				sender->unpin();
+			}
+			
+			finishDisconnect();
+		}
+		
+		// Disconnects every receiver in [first, last) at once: each signal
+		// connected to any of them is locked and scanned a single time,
+		// instead of once per receiver. The iterators must dereference to
+		// pointers convertible to HasSlots *.
+		template<class iterator>
+		static void disconnectAll(iterator first, iterator last) {
+			_disconnect_receivers<mt_policy>(first, last);
+		}
+		
+		// Disconnects every receiver in [first, last) as disconnectAll() does,
+		// then deletes them.
+		template<class iterator>
+		static void destroyAll(iterator first, iterator last) {
+			_disconnect_receivers<mt_policy>(first, last);
+			
+			for (; first != last; ++first) {
+				delete *first;
+			}
+		}
+		
+		// Empties the sender set, pinning each sender and appending it to
+		// senders. Returns false if the set was already empty.
+		bool takeSenders(std::vector<_signal_base<mt_policy> *> &senders) {
+			state_type *target = this->getState();
+			
+			if (target == NULL) {
+				return false;
+			}
+			
+			lock_block<lock_type> lock(this->mutexOf(target));
+			
+			if (target->senders.empty()) {
+				return false;
+			}
+			
+			for (const_iterator it = target->senders.begin(); it != target->senders.end(); ++it) {
+				(*it)->pin();
+				senders.push_back(*it);
+			}
+			
+			target->senders.clear();
+			countSenders(target);
+			return true;
+		}
+		
+		// Waits for the slot calls started before the connections were
+		// removed, other than the calling thread's own.
+		void finishDisconnect() {
+			state_type *target = this->getState();
+			
+			if (target == NULL) {
+				return;
+			}
+			
+			for (long own = _call_frame::detach(self()); own > 0; --own) {
+				_atomic_decrement(&target->calls);
+			}
+			
+			while (_atomic_load(&target->calls) != 0) {
+				_thread_yield();
+			}
+			
+			// No connection is left to post new calls; drop the posted ones,
+			// from the executor and from any thread pool, and wait for those
+			// already started.
+			Executor *executor = this->executor();
+			
+			if (executor != NULL) {
+				executor->cancel(self());
+			}
+			
+#ifndef _SIGLY_SINGLE_THREADED
+			ThreadPool::cancelAll(self());
+#endif
+			
+			while (_atomic_load(&target->calls) != 0) {
+				_thread_yield();
+			}
+		}
+		
+		// Makes the slots connected to this object with QUEUED_CONNECTION or
+		// AUTO_CONNECTION run on the given executor, or on the emitting
+		// thread if it is NULL (the default). Calls already posted to the
+		// previous executor are dropped. Must not be called while a signal
+		// connected to this object is being emitted on another thread.
+		void moveToExecutor(Executor *executor) {
+			state_type *target = executor != NULL ? this->inflate() : this->getState();
+			
+			if (target != NULL) {
+				Executor *previous = static_cast<Executor *>(_atomic_exchange(&target->executor, executor));
+				
+				if (previous != NULL && previous != executor) {
+					previous->cancel(self());
+				}
+			}
+		}
+		
+		void moveToEventLoop(EventLoop *loop) {
+			moveToExecutor(loop);
+		}
+		
+		Executor *executor() const {
+			state_type *target = this->getState();
+			return target != NULL ? static_cast<Executor *>(_atomic_load(&target->executor)) : NULL;
+		}
+		
+		// The executor if it is an event loop, or NULL.
+		EventLoop *eventLoop() const {
+			Executor *executor = this->executor();
+			return executor != NULL ? executor->eventLoop() : NULL;
+		}
+		
+		// Called by emissions around each slot call made without the signal
+		// locked.
+		void enterSlot() {
+			_atomic_increment(&this->getState()->calls);
+		}
+		
+		void leaveSlot() {
+			_atomic_decrement(&this->getState()->calls);
+		}
+		
+		// Number of signals connected to this object.
+		std::size_t senderCount() const {
+			state_type *target = this->getState();
+			return target != NULL ? (std::size_t)_atomic_load(&target->count) : 0;
+		}
+		
+		// Connects this object to every slot the original is connected to.
+		// The copy constructor does not, since signals emitted on other
+		// threads could then call into a copy whose derived part is still
+		// being built; call this once the copy is complete.
+		void copyConnections(const _receiver &original) {
+			state_type *source = original.getState();
+			
+			if (source == NULL) {
+				return;
+			}
+			
+			std::set<_signal_base<mt_policy> *> senders;
+			
+			{
+				lock_block<lock_type> lock(const_cast<_receiver &>(original).mutexOf(source));
+				senders = source->senders;
+				
+				for (const_iterator it = senders.begin(); it != senders.end(); ++it) {
+					(*it)->pin();
+				}
+			}
+			
+			for (const_iterator it = senders.begin(); it != senders.end(); ++it) {
+				(*it)->slot_duplicate(original.self(), self());
+				(*it)->unpin();
+			}
+		}
+		
+	protected:
+		_receiver() {
+		}
+		
+		// A copy runs its slots on the executor of the original.
+		_receiver(const _receiver &original): storage(original) {
+			Executor *executor = original.executor();
+			
+			if (executor != NULL) {
+				moveToExecutor(executor);
+			}
+		}
+		
+	private:
+		HasSlots<mt_policy> *self() {
+			return static_cast<HasSlots<mt_policy> *>(this);
+		}
+		
+		const HasSlots<mt_policy> *self() const {
+			return static_cast<const HasSlots<mt_policy> *>(this);
+		}
+		
+		static void countSenders(state_type *target) {
+			_atomic_exchange(&target->count, (long)target->senders.size());
+		}
+	};
+	
+	// Keeps the receiver state inside the object, guarded by the policy the
+	// object inherits.
+	template<class mt_policy>
+	class _inline_receiver : public mt_policy {
+	public:
+		typedef _receiver_state<mt_policy> state_type;
+		typedef mt_policy lock_type;
+		
+		void deactivateSlots() {
+			m_active = false;
+		}
+		
+		void activateSlots() {
+			m_active = true;
+		}
+		
+		bool areSlotsActive() const {
+			return m_active;
+		}
+		
+	protected:
+		_inline_receiver(): mt_policy(), m_active(true) {
+		}
+		
+		_inline_receiver(const _inline_receiver &original): mt_policy(original), m_active(original.m_active) {
+		}
+		
+		state_type *getState() const {
+			return const_cast<state_type *>(&m_state);
+		}
+		
+		state_type *inflate() {
+			return &m_state;
+		}
+		
+		lock_type *mutexOf(state_type *) {
+			return this;
+		}
+		
+	private:
+		state_type m_state;
+		bool m_active;
+	};
+	
+	template<class  mt_policy = SIGLY_DEFAULT_MT_POLICY>
+	class HasSlots : public _receiver<mt_policy, _inline_receiver<mt_policy> > {
+	public:
+		HasSlots() {
+			_SIGLY_REGISTER(false);
+		}
+		
+		HasSlots(const HasSlots &hs): _receiver<mt_policy, _inline_receiver<mt_policy> >(hs) {
+			_SIGLY_REGISTER(false);
+		}
+		
+		virtual ~HasSlots() {
+			_SIGLY_UNREGISTER();
+			this->disconnectAll();
+		}
+		
+		// Bytes owned by the object: itself, its sender set nodes and what the
+		// policy allocated. Connections belong to the signals. Does not lock
+		// the object.
+		std::size_t memoryUsage() const {
+			return sizeof(*this) + this->senderCount() * _SET_NODE_SIZE + _heap_size(static_cast<const mt_policy *>(this));
+		}
+		
+	private:
+		static std::size_t linksOf(const void *receiver) {
+			return static_cast<const HasSlots *>(receiver)->senderCount();
+		}
+		
+		static std::size_t bytesOf(const void *receiver) {
+			return static_cast<const HasSlots *>(receiver)->memoryUsage();
+		}
+		
+#ifdef SIGLY_ENABLE_REGISTRY
+		_registry_entry m_entry;
+#endif
+	};
+	
+	// Keeps the receiver state of the Lean policies, together with the
+	// wrapped mutex, in a block allocated by the first connection. The low
+	// bit of the pointer holds the deactivated flag, so that deactivating an
+	// unconnected object does not allocate.
+	template<class mt_policy>
+	class _lean_receiver {
+	public:
+		struct state_type : public _receiver_state<Lean<mt_policy> > {
+			mt_policy mutex;
+		};
+		
+		typedef mt_policy lock_type;
+		
+		void deactivateSlots() {
+			setFlag(INACTIVE, true);
+		}
+		
+		void activateSlots() {
+			setFlag(INACTIVE, false);
+		}
+		
+		bool areSlotsActive() const {
+			return ((size_t)m_state & INACTIVE) == 0;
+		}
+		
+		void lock() {
+			inflate()->mutex.lock();
+		}
+		
+		void unlock() {
+			getState()->mutex.unlock();
+		}
+		
+	protected:
+		_lean_receiver(): m_state(NULL) {
+		}
+		
+		_lean_receiver(const _lean_receiver &): m_state(NULL) {
+		}
+		
+		~_lean_receiver() {
+			delete getState();
+		}
+		
+		state_type *getState() const {
+			return reinterpret_cast<state_type *>((size_t)_atomic_load(&m_state) & ~(size_t)INACTIVE);
+		}
+		
+		state_type *inflate() {
+			state_type *current = getState();
+			
+			if (current == NULL) {
+				state_type *created = new state_type();
+				void *expected = _atomic_load(&m_state);
+				
+				for (;;) {
+					current = reinterpret_cast<state_type *>((size_t)expected & ~(size_t)INACTIVE);
+					
+					if (current != NULL) {
+						delete created;
+						break;
+					}
+					
+					void *desired = reinterpret_cast<void *>((size_t)created | ((size_t)expected & INACTIVE));
+					void *previous = _atomic_compare_exchange(&m_state, expected, desired);
+					
+					if (previous == expected) {
+						current = created;
+						break;
+					}
+					
+					expected = previous;
+				}
+			}
+			
+			return current;
+		}
+		
+		lock_type *mutexOf(state_type *target) {
+			return &target->mutex;
+		}
+		
+	private:
+		enum {
+			INACTIVE = 1
+		};
+		
+		void setFlag(size_t flag, bool value) {
+			void *expected = _atomic_load(&m_state);
+			
+			for (;;) {
+				void *desired = reinterpret_cast<void *>(value ? ((size_t)expected | flag) : ((size_t)expected & ~flag));
+				void *previous = _atomic_compare_exchange(&m_state, expected, desired);
+				
+				if (previous == expected) {
+					break;
+				}
+				
+				expected = previous;
+			}
+		}
+		
+		void *volatile m_state;
+	};
+	
+	// Receiver for the Lean policies. It is exactly two pointers large (the
+	// vtable pointer and the pointer to the state) until the first
+	// connection is made, at which point the sender set and the wrapped mutex
+	// are allocated together.
+	template<class mt_policy>
+	class HasSlots<Lean<mt_policy> > : public _receiver<Lean<mt_policy>, _lean_receiver<mt_policy> > {
+	public:
+		HasSlots() {
+			_SIGLY_REGISTER(false);
+		}
+		
+		HasSlots(const HasSlots &hs): _receiver<Lean<mt_policy>, _lean_receiver<mt_policy> >(hs) {
+			_SIGLY_REGISTER(false);
+		}
+		
+		HasSlots &operator=(const HasSlots &) {
+			return *this;
+		}
+		
+		virtual ~HasSlots() {
+			_SIGLY_UNREGISTER();
+			this->disconnectAll();
+		}
+		
+		// The state is counted once it has been allocated.
+		std::size_t memoryUsage() const {
+			typename _lean_receiver<mt_policy>::state_type *target = this->getState();
+			
+			if (target == NULL) {
+				return sizeof(*this);
+			}
+			
+			return sizeof(*this) + sizeof(*target) + this->senderCount() * _SET_NODE_SIZE + _heap_size(&target->mutex);
+		}
+		
+	private:
+		static std::size_t linksOf(const void *receiver) {
+			return static_cast<const HasSlots *>(receiver)->senderCount();
+		}
+		
+		static std::size_t bytesOf(const void *receiver) {
+			return static_cast<const HasSlots *>(receiver)->memoryUsage();
+		}
+		
+#ifdef SIGLY_ENABLE_REGISTRY
+		_registry_entry m_entry;
+#endif
+	};
+	
+	// Bulk disconnection behind HasSlots::disconnectAll(first, last). The
+	// senders of all the receivers are gathered first, then each distinct
+	// sender drops the connections of the whole set in a single locked pass.
+	// Connections made meanwhile are picked up by the next round.
+	template<class mt_policy, class iterator>
+	void _disconnect_receivers(iterator first, iterator last) {
+		typedef typename std::set<HasSlots<mt_policy> *> receiver_set;
+		typedef typename std::vector<_signal_base<mt_policy> *> sender_list;
+		receiver_set receivers;
+		
+		for (iterator it = first; it != last; ++it) {
+			receivers.insert(*it);
+		}
+		
+		sender_list pinned;
+		sender_list senders;
+		
+		for (;;) {
+			pinned.clear();
+			
+			for (typename receiver_set::const_iterator it = receivers.begin(); it != receivers.end(); ++it) {
+				(*it)->takeSenders(pinned);
+			}
+			
+			if (pinned.empty()) {
+				break;
+			}
+			
+			senders = pinned;
+			std::sort(senders.begin(), senders.end());
+			senders.erase(std::unique(senders.begin(), senders.end()), senders.end());
+			
+			for (typename sender_list::const_iterator it = senders.begin(); it != senders.end(); ++it) {
+				(*it)->slot_disconnect(receivers);
+			}
+			
+			for (typename sender_list::const_iterator it = pinned.begin(); it != pinned.end(); ++it) {
+				(*it)->unpin();
+			}
+		}
+		
+		for (typename receiver_set::const_iterator it = receivers.begin(); it != receivers.end(); ++it) {
+			(*it)->finishDisconnect();
+		}
+	}
+	
+	// Walks the connections of a signal for one emission; next() returns the
+	// connection whose slot should be called next, or NULL at the end. When
+	// the policy's _dispatch_traits allow it, the signal is unlocked while each
+	// slot runs: the signal then counts the emission so that connections
+	// removed meanwhile are kept until it ends, and the receiver counts the
+	// call so that disconnecting it waits for the call to return.
+	template<class mt_policy, class connections_list, bool published>
+	class _emission {
+	public:
+		typedef typename connections_list::value_type connection_type;
+		
+		_emission(_signal_base<mt_policy> *signal, const connections_list &slots)
+		: m_signal(signal), m_current(NULL), m_dest(NULL) {
+			_SIGLY_TRACE(EMIT_BEGIN, m_signal, NULL);
+			m_signal->lockShared();
+			m_it = slots.begin();
+			m_itEnd = slots.end();
+			
+			if (_dispatch_traits<mt_policy>::unlock_during_slots) {
+				_atomic_increment(&m_signal->m_emitting);
+			}
+		}
+		
+		~_emission() {
+			if (m_current != NULL) {
+				_SIGLY_TRACE(SLOT_END, m_signal, m_current);
+			}
+			
+			if (!_dispatch_traits<mt_policy>::unlock_during_slots) {
+				m_signal->unlockShared();
+				_SIGLY_TRACE(EMIT_END, m_signal, NULL);
+				return;
+			}
+			
+			if (m_current != NULL) {
+				// A slot threw; the signal is not locked.
+				leave();
+				m_signal->lockShared();
+			}
+			
+			bool collect = _atomic_decrement(&m_signal->m_emitting) == 0 && m_signal->m_has_garbage;
+			m_signal->unlockShared();
+			
+			if (collect) {
+				m_signal->collectGarbage();
+			}
+			
+			_SIGLY_TRACE(EMIT_END, m_signal, NULL);
+		}
+		
+		connection_type next() {
+			if (m_current != NULL) {
+				_SIGLY_TRACE(SLOT_END, m_signal, m_current);
+				
+				if (_dispatch_traits<mt_policy>::unlock_during_slots) {
+					leave();
+					m_signal->lockShared();
+				}
+				
+				m_current = NULL;
+				++m_it;
+			}
+			
+			while (m_it != m_itEnd) {
+				connection_type conn = *m_it;
+				
+				if (conn != NULL && conn->getdest()->areSlotsActive()) {
+					m_current = conn;
+					
+					// Fetch ahead while this slot runs; the list may only be
+					// read with the signal locked. The receiver comes from the
+					// next connection, which the previous call fetched, and the
+					// connection after it is fetched for the next call, so that
+					// neither read waits on memory.
+					typename connections_list::const_iterator ahead = m_it;
+					
+					if (++ahead != m_itEnd) {
+						if (*ahead != NULL) {
+							_SIGLY_PREFETCH((*ahead)->getdest());
+						}
+						
+						if (++ahead != m_itEnd) {
+							_SIGLY_PREFETCH(*ahead);
+						}
+					}
+					
+					if (_dispatch_traits<mt_policy>::unlock_during_slots) {
+						m_dest = conn->getdest();
+						m_dest->enterSlot();
+						m_frame.push(m_dest);
+						m_signal->unlockShared();
+					}
+					
+					_SIGLY_TRACE(SLOT_BEGIN, m_signal, conn);
+					return conn;
+				}
+				
+				++m_it;
+			}
+			
+			return NULL;
+		}
+		
+	private:
+		void leave() {
+			if (m_frame.receiver() != NULL) {
+				m_dest->leaveSlot();
+			}
+			
+			m_frame.pop();
+		}
+		
+		_signal_base<mt_policy> *m_signal;
+		typename connections_list::const_iterator m_it;
+		typename connections_list::const_iterator m_itEnd;
+		connection_type m_current;
+		HasSlots<mt_policy> *m_dest;
+		_call_frame m_frame;
+	};
+	
+	// Emission of a published signal: no lock is taken and nothing shared is
+	// written. The connections come from the array the last change published,
+	// which stays valid, along with the connections in it, until the emission
+	// leaves its _read_epoch section. Their receivers do not: a slot may
+	// destroy one, so the connections this thread removed since its
+	// outermost emission started are skipped.
+	template<class mt_policy, class connections_list>
+	class _emission<mt_policy, connections_list, true> {
+	public:
+		typedef typename connections_list::value_type connection_type;
+		
+		_emission(_signal_base<mt_policy> *signal, const connections_list &)
+		: m_signal(signal), m_current(NULL) {
+			_SIGLY_TRACE(EMIT_BEGIN, m_signal, NULL);
+			m_epoch = _read_epoch::enter();
+			long count;
+			m_signal->snapshot(m_it, count);
+			m_itEnd = m_it + count;
+		}
+		
+		~_emission() {
+			if (m_current != NULL) {
+				_SIGLY_TRACE(SLOT_END, m_signal, m_current);
+			}
+			
+			_read_epoch::leave();
+			_SIGLY_TRACE(EMIT_END, m_signal, NULL);
+		}
+		
+		connection_type next() {
+			if (m_current != NULL) {
+				_SIGLY_TRACE(SLOT_END, m_signal, m_current);
+				m_current = NULL;
+			}
+			
+			while (m_it != m_itEnd) {
+				connection_type conn = *m_it++;
+				
+				if (!m_epoch->retiredHere(conn) && conn->getdest()->areSlotsActive()) {
+					m_current = conn;
+					
+					// The receiver of the next connection, which the previous
+					// call fetched, and the connection after it. A connection
+					// retired during the emission is still allocated, and a
+					// prefetch of its destroyed receiver does not fault.
+					if (m_it != m_itEnd) {
+						_SIGLY_PREFETCH((*m_it)->getdest());
+						
+						if (m_it + 1 != m_itEnd) {
+							_SIGLY_PREFETCH(m_it[1]);
+						}
+					}
+					
+					_SIGLY_TRACE(SLOT_BEGIN, m_signal, conn);
+					return conn;
+				}
+			}
+			
+			return NULL;
+		}
+		
+	private:
+		_signal_base<mt_policy> *m_signal;
+		_read_epoch *m_epoch;
+		connection_type const *m_it;
+		connection_type const *m_itEnd;
+		connection_type m_current;
+	};
+	
+	template<class dest_type, class mt_policy>
+	class _connection0 : public _connection_base0<mt_policy> {
+	public:
+		_connection0() {
+			this->pobject = NULL;
+			this->pmemfun = NULL;
+		}
+		
+		_connection0(dest_type *pobject, void (dest_type::*pmemfun)()) {
+			m_pobject = pobject;
+			m_pmemfun = pmemfun;
+		}
+		
+		virtual _connection_base0<mt_policy>* clone() {
+			return new _connection0<dest_type, mt_policy>(*this);
+		}
+		
+		virtual _connection_base0<mt_policy>* duplicate(HasSlots<mt_policy>* pnewdest) {
+			return new _connection0<dest_type, mt_policy>((dest_type *)pnewdest, m_pmemfun);
+		}
+		
+		virtual void shoot() {
+			(m_pobject->*m_pmemfun)();
+		}
+		
+		virtual HasSlots<mt_policy>* getdest() const {
+			return m_pobject;
+		}
+		
+		virtual std::size_t size() const {
+			return sizeof(*this);
+		}
+		
+		virtual std::size_t method(const void *&bytes) const {
+			bytes = &m_pmemfun;
+			return sizeof(m_pmemfun);
+		}
+		
+		virtual const void *stub() const {
+			static const char tag = 0;
+			return &tag;
+		}
+		
+	private:
+		dest_type *m_pobject;
+		void (dest_type::* m_pmemfun)();
+	};
+	
+	template<class dest_type, class arg1_type, class mt_policy>
+	class _connection1 : public _connection_base1<arg1_type, mt_policy> {
+	public:
+		_connection1() {
+			this->pobject = NULL;
+			this->pmemfun = NULL;
+		}
+		
+		_connection1(dest_type *pobject, void (dest_type::*pmemfun)(arg1_type)) {
+			m_pobject = pobject;
+			m_pmemfun = pmemfun;
+		}
+		
+		virtual _connection_base1<arg1_type, mt_policy>* clone() {
+			return new _connection1<dest_type, arg1_type, mt_policy>(*this);
+		}
+		
+		virtual _connection_base1<arg1_type, mt_policy>* duplicate(HasSlots<mt_policy>* pnewdest) {
+			return new _connection1<dest_type, arg1_type, mt_policy>((dest_type *)pnewdest, m_pmemfun);
+		}
+		
+		virtual void shoot(arg1_type a1) {
+			(m_pobject->*m_pmemfun)(a1);
+		}
+		
+		virtual HasSlots<mt_policy>* getdest() const {
+			return m_pobject;
+		}
+		
+		virtual std::size_t size() const {
+			return sizeof(*this);
+		}
+		
+		virtual std::size_t method(const void *&bytes) const {
+			bytes = &m_pmemfun;
+			return sizeof(m_pmemfun);
+		}
+		
+		virtual const void *stub() const {
+			static const char tag = 0;
+			return &tag;
+		}
+		
+	private:
+		dest_type *m_pobject;
+		void (dest_type::* m_pmemfun)(arg1_type);
+	};
+	
+	template<class dest_type, class arg1_type, class arg2_type, class mt_policy>
+	class _connection2 : public _connection_base2<arg1_type, arg2_type, mt_policy> {
+	public:
+		_connection2() {
+			this->pobject = NULL;
+			this->pmemfun = NULL;
+		}
+		
+		_connection2(dest_type *pobject, void (dest_type::*pmemfun)(arg1_type,
+		                                                            arg2_type)) {
+			m_pobject = pobject;
+			m_pmemfun = pmemfun;
+		}
+		
+		virtual _connection_base2<arg1_type, arg2_type, mt_policy>* clone() {
+			return new _connection2<dest_type, arg1_type, arg2_type, mt_policy>(*this);
+		}
+		
+		virtual _connection_base2<arg1_type, arg2_type, mt_policy>* duplicate(HasSlots<mt_policy>* pnewdest) {
+			return new _connection2<dest_type, arg1_type, arg2_type, mt_policy>((dest_type *)pnewdest, m_pmemfun);
+		}
+		
+		virtual void shoot(arg1_type a1, arg2_type a2) {
+			(m_pobject->*m_pmemfun)(a1, a2);
+		}
+		
+		virtual HasSlots<mt_policy>* getdest() const {
+			return m_pobject;
+		}
+		
+		virtual std::size_t size() const {
+			return sizeof(*this);
+		}
+		
+		virtual std::size_t method(const void *&bytes) const {
+			bytes = &m_pmemfun;
+			return sizeof(m_pmemfun);
+		}
+		
+		virtual const void *stub() const {
+			static const char tag = 0;
+			return &tag;
+		}
+		
+	private:
+		dest_type *m_pobject;
+		void (dest_type::* m_pmemfun)(arg1_type, arg2_type);
+	};
+	
+	template<class dest_type, class arg1_type, class arg2_type, class arg3_type, class mt_policy>
+	class _connection3 : public _connection_base3<arg1_type, arg2_type, arg3_type, mt_policy> {
+	public:
+		_connection3() {
+			this->pobject = NULL;
+			this->pmemfun = NULL;
+		}
+		
+		_connection3(dest_type *pobject, void (dest_type::*pmemfun)(arg1_type,
+		                                                            arg2_type, arg3_type)) {
+			m_pobject = pobject;
+			m_pmemfun = pmemfun;
+		}
+		
+		virtual _connection_base3<arg1_type, arg2_type, arg3_type, mt_policy>* clone() {
+			return new _connection3<dest_type, arg1_type, arg2_type, arg3_type, mt_policy>(*this);
+		}
+		
+		virtual _connection_base3<arg1_type, arg2_type, arg3_type, mt_policy>* duplicate(HasSlots<mt_policy>* pnewdest) {
+			return new _connection3<dest_type, arg1_type, arg2_type, arg3_type, mt_policy>((dest_type *)pnewdest, m_pmemfun);
+		}
+		
+		virtual void shoot(arg1_type a1, arg2_type a2, arg3_type a3) {
+			(m_pobject->*m_pmemfun)(a1, a2, a3);
+		}
+		
+		virtual HasSlots<mt_policy>* getdest() const {
+			return m_pobject;
+		}
+		
+		virtual std::size_t size() const {
+			return sizeof(*this);
+		}
+		
+		virtual std::size_t method(const void *&bytes) const {
+			bytes = &m_pmemfun;
+			return sizeof(m_pmemfun);
+		}
+		
+		virtual const void *stub() const {
+			static const char tag = 0;
+			return &tag;
+		}
+		
+	private:
+		dest_type *m_pobject;
+		void (dest_type::* m_pmemfun)(arg1_type, arg2_type, arg3_type);
+	};
+	
+	template < class dest_type, class arg1_type, class arg2_type, class arg3_type,
+	class arg4_type, class mt_policy >
+	class _connection4 : public _connection_base4 < arg1_type, arg2_type,
+	arg3_type, arg4_type, mt_policy > {
+	public:
+		_connection4() {
+			this->pobject = NULL;
+			this->pmemfun = NULL;
+		}
+		
+		_connection4(dest_type *pobject, void (dest_type::*pmemfun)(arg1_type,
+		                                                            arg2_type, arg3_type, arg4_type)) {
+			m_pobject = pobject;
+			m_pmemfun = pmemfun;
+		}
+		
+		virtual _connection_base4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>* clone() {
+			return new _connection4<dest_type, arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>(*this);
+		}
+		
+		virtual _connection_base4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>* duplicate(HasSlots<mt_policy>* pnewdest) {
+			return new _connection4<dest_type, arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>((dest_type *)pnewdest, m_pmemfun);
+		}
+		
+		virtual void shoot(arg1_type a1, arg2_type a2, arg3_type a3,
+		                   arg4_type a4) {
+			(m_pobject->*m_pmemfun)(a1, a2, a3, a4);
+		}
+		
+		virtual HasSlots<mt_policy>* getdest() const {
+			return m_pobject;
+		}
+		
+		virtual std::size_t size() const {
+			return sizeof(*this);
+		}
+		
+		virtual std::size_t method(const void *&bytes) const {
+			bytes = &m_pmemfun;
+			return sizeof(m_pmemfun);
+		}
+		
+		virtual const void *stub() const {
+			static const char tag = 0;
+			return &tag;
+		}
+		
+	private:
+		dest_type *m_pobject;
+		void (dest_type::* m_pmemfun)(arg1_type, arg2_type, arg3_type,
+		                              arg4_type);
+	};
+	
+	template < class dest_type, class arg1_type, class arg2_type, class arg3_type,
+	class arg4_type, class arg5_type, class mt_policy >
+	class _connection5 : public _connection_base5 < arg1_type, arg2_type,
+	arg3_type, arg4_type, arg5_type, mt_policy > {
+	public:
+		_connection5() {
+			this->pobject = NULL;
+			this->pmemfun = NULL;
+		}
+		
+		_connection5(dest_type *pobject, void (dest_type::*pmemfun)(arg1_type,
+		                                                            arg2_type, arg3_type, arg4_type, arg5_type)) {
+			m_pobject = pobject;
+			m_pmemfun = pmemfun;
+		}
+		
+		virtual _connection_base5 < arg1_type, arg2_type, arg3_type, arg4_type,
+		arg5_type, mt_policy > * clone() {
+			return new _connection5 < dest_type, arg1_type, arg2_type, arg3_type, arg4_type,
+			arg5_type, mt_policy > (*this);
+		}
+		
+		virtual _connection_base5 < arg1_type, arg2_type, arg3_type, arg4_type,
+		arg5_type, mt_policy > * duplicate(HasSlots<mt_policy>* pnewdest) {
+			return new _connection5 < dest_type, arg1_type, arg2_type, arg3_type, arg4_type,
+			arg5_type, mt_policy > ((dest_type *)pnewdest, m_pmemfun);
+		}
+		
+		virtual void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4,
+						   arg5_type a5) {
+			(m_pobject->*m_pmemfun)(a1, a2, a3, a4, a5);
+		}
+		
+		virtual HasSlots<mt_policy>* getdest() const {
+			return m_pobject;
+		}
+		
+		virtual std::size_t size() const {
+			return sizeof(*this);
+		}
+		
+		virtual std::size_t method(const void *&bytes) const {
+			bytes = &m_pmemfun;
+			return sizeof(m_pmemfun);
+		}
+		
+		virtual const void *stub() const {
+			static const char tag = 0;
+			return &tag;
+		}
+		
+	private:
+		dest_type *m_pobject;
+		void (dest_type::* m_pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type,
+		                              arg5_type);
+	};
+	
+	template < class dest_type, class arg1_type, class arg2_type, class arg3_type,
+	class arg4_type, class arg5_type, class arg6_type, class mt_policy >
+	class _connection6 : public _connection_base6 < arg1_type, arg2_type,
+	arg3_type, arg4_type, arg5_type, arg6_type, mt_policy > {
+	public:
+		_connection6() {
+			this->pobject = NULL;
+			this->pmemfun = NULL;
+		}
+		
+		_connection6(dest_type *pobject, void (dest_type::*pmemfun)(arg1_type,
+		                                                            arg2_type, arg3_type, arg4_type, arg5_type, arg6_type)) {
+			m_pobject = pobject;
+			m_pmemfun = pmemfun;
+		}
+		
+		virtual _connection_base6 < arg1_type, arg2_type, arg3_type, arg4_type,
+		arg5_type, arg6_type, mt_policy > * clone() {
+			return new _connection6 < dest_type, arg1_type, arg2_type, arg3_type, arg4_type,
+			arg5_type, arg6_type, mt_policy > (*this);
+		}
+		
+		virtual _connection_base6 < arg1_type, arg2_type, arg3_type, arg4_type,
+		arg5_type, arg6_type, mt_policy > * duplicate(HasSlots<mt_policy>* pnewdest) {
+			return new _connection6 < dest_type, arg1_type, arg2_type, arg3_type, arg4_type,
+			arg5_type, arg6_type, mt_policy > ((dest_type *)pnewdest, m_pmemfun);
+		}
+		
+		virtual void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4,
+						   arg5_type a5, arg6_type a6) {
+			(m_pobject->*m_pmemfun)(a1, a2, a3, a4, a5, a6);
+		}
+		
+		virtual HasSlots<mt_policy>* getdest() const {
+			return m_pobject;
+		}
+		
+		virtual std::size_t size() const {
+			return sizeof(*this);
+		}
+		
+		virtual std::size_t method(const void *&bytes) const {
+			bytes = &m_pmemfun;
+			return sizeof(m_pmemfun);
+		}
+		
+		virtual const void *stub() const {
+			static const char tag = 0;
+			return &tag;
+		}
+		
+	private:
+		dest_type *m_pobject;
+		void (dest_type::* m_pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type,
+		                              arg5_type, arg6_type);
+	};
+	
+	template < class dest_type, class arg1_type, class arg2_type, class arg3_type,
+	class arg4_type, class arg5_type, class arg6_type, class arg7_type, class mt_policy >
+	class _connection7 : public _connection_base7 < arg1_type, arg2_type,
+	arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy > {
+	public:
+		_connection7() {
+			this->pobject = NULL;
+			this->pmemfun = NULL;
+		}
+		
+		_connection7(dest_type *pobject, void (dest_type::*pmemfun)(arg1_type,
+		                                                            arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type)) {
+			m_pobject = pobject;
+			m_pmemfun = pmemfun;
+		}
+		
+		virtual _connection_base7 < arg1_type, arg2_type, arg3_type, arg4_type,
+		arg5_type, arg6_type, arg7_type, mt_policy > * clone() {
+			return new _connection7 < dest_type, arg1_type, arg2_type, arg3_type, arg4_type,
+			arg5_type, arg6_type, arg7_type, mt_policy > (*this);
+		}
+		
+		virtual _connection_base7 < arg1_type, arg2_type, arg3_type, arg4_type,
+		arg5_type, arg6_type, arg7_type, mt_policy > * duplicate(HasSlots<mt_policy>* pnewdest) {
+			return new _connection7 < dest_type, arg1_type, arg2_type, arg3_type, arg4_type,
+			arg5_type, arg6_type, arg7_type, mt_policy > ((dest_type *)pnewdest, m_pmemfun);
+		}
+		
+		virtual void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4,
+						   arg5_type a5, arg6_type a6, arg7_type a7) {
+			(m_pobject->*m_pmemfun)(a1, a2, a3, a4, a5, a6, a7);
+		}
+		
+		virtual HasSlots<mt_policy>* getdest() const {
+			return m_pobject;
+		}
+		
+		virtual std::size_t size() const {
+			return sizeof(*this);
+		}
+		
+		virtual std::size_t method(const void *&bytes) const {
+			bytes = &m_pmemfun;
+			return sizeof(m_pmemfun);
+		}
+		
+		virtual const void *stub() const {
+			static const char tag = 0;
+			return &tag;
+		}
+		
+	private:
+		dest_type *m_pobject;
+		void (dest_type::* m_pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type,
+		                              arg5_type, arg6_type, arg7_type);
+	};
+	
+	template < class dest_type, class arg1_type, class arg2_type, class arg3_type,
+	class arg4_type, class arg5_type, class arg6_type, class arg7_type,
+	class arg8_type, class mt_policy >
+	class _connection8 : public _connection_base8 < arg1_type, arg2_type,
+	arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy > {
+	public:
+		_connection8() {
+			this->pobject = NULL;
+			this->pmemfun = NULL;
+		}
+		
+		_connection8(dest_type *pobject, void (dest_type::*pmemfun)(arg1_type,
+		                                                            arg2_type, arg3_type, arg4_type, arg5_type, arg6_type,
+		                                                            arg7_type, arg8_type)) {
+			m_pobject = pobject;
+			m_pmemfun = pmemfun;
+		}
+		
+		virtual _connection_base8 < arg1_type, arg2_type, arg3_type, arg4_type,
+		arg5_type, arg6_type, arg7_type, arg8_type, mt_policy > * clone() {
+			return new _connection8 < dest_type, arg1_type, arg2_type, arg3_type, arg4_type,
+			arg5_type, arg6_type, arg7_type, arg8_type, mt_policy > (*this);
+		}
+		
+		virtual _connection_base8 < arg1_type, arg2_type, arg3_type, arg4_type,
+		arg5_type, arg6_type, arg7_type, arg8_type, mt_policy > * duplicate(HasSlots<mt_policy>* pnewdest) {
+			return new _connection8 < dest_type, arg1_type, arg2_type, arg3_type, arg4_type,
+			arg5_type, arg6_type, arg7_type, arg8_type, mt_policy > ((dest_type *)pnewdest, m_pmemfun);
+		}
+		
+		virtual void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4,
+						   arg5_type a5, arg6_type a6, arg7_type a7, arg8_type a8) {
+			(m_pobject->*m_pmemfun)(a1, a2, a3, a4, a5, a6, a7, a8);
+		}
+		
+		virtual HasSlots<mt_policy>* getdest() const {
+			return m_pobject;
+		}
+		
+		virtual std::size_t size() const {
+			return sizeof(*this);
+		}
+		
+		virtual std::size_t method(const void *&bytes) const {
+			bytes = &m_pmemfun;
+			return sizeof(m_pmemfun);
+		}
+		
+		virtual const void *stub() const {
+			static const char tag = 0;
+			return &tag;
+		}
+		
+	private:
+		dest_type *m_pobject;
+		void (dest_type::* m_pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type,
+		                              arg5_type, arg6_type, arg7_type, arg8_type);
+	};
+	
+	// Calls posted to an event loop keep copies of their arguments, since
+	// references passed to the signal are only valid during the emission.
+	template<class dest_type, class mt_policy>
+	class _queued_call0 : public _queued_call {
+	public:
+		_queued_call0(const void *key, dest_type *pobject, void (dest_type::*pmemfun)())
+		: _queued_call(static_cast<HasSlots<mt_policy> *>(pobject), key), m_pobject(pobject), m_pmemfun(pmemfun) {
+		}
+		
+		virtual void enter() {
+			m_pobject->enterSlot();
+		}
+		
+		virtual void leave() {
+			m_pobject->leaveSlot();
+		}
+		
+		virtual void run() {
+			(m_pobject->*m_pmemfun)();
+		}
+		
+	private:
+		dest_type *m_pobject;
+		void (dest_type::* m_pmemfun)();
+	};
+	
+	// Connection made with a ConnectionMode other than DIRECT_CONNECTION.
+	template<class dest_type, class mt_policy>
+	class _queued_connection0 : public _connection_base0<mt_policy> {
+	public:
+		_queued_connection0(dest_type *pobject, void (dest_type::*pmemfun)(), ConnectionMode mode, const void *key)
+		: m_pobject(pobject), m_pmemfun(pmemfun), m_mode(mode), m_key(key) {
+		}
+		
+		virtual _connection_base0<mt_policy>* clone() {
+			return new _queued_connection0<dest_type, mt_policy>(*this);
+		}
+		
+		virtual _connection_base0<mt_policy>* duplicate(HasSlots<mt_policy>* pnewdest) {
+			return new _queued_connection0<dest_type, mt_policy>((dest_type *)pnewdest, m_pmemfun, m_mode, m_key);
+		}
+		
+		virtual void shoot() {
+			Executor *executor = m_pobject->executor();
+			
+			if (executor == NULL || (m_mode == AUTO_CONNECTION && executor->isCurrent())) {
+				(m_pobject->*m_pmemfun)();
+			} else {
+				executor->post(new _queued_call0<dest_type, mt_policy>(m_key != NULL ? m_key : this, m_pobject, m_pmemfun));
+			}
+		}
+		
+		virtual HasSlots<mt_policy>* getdest() const {
+			return m_pobject;
+		}
+		
+		virtual std::size_t size() const {
+			return sizeof(*this);
+		}
+		
+		virtual std::size_t method(const void *&bytes) const {
+			bytes = &m_pmemfun;
+			return sizeof(m_pmemfun);
+		}
+		
+		virtual const void *stub() const {
+			static const char tag = 0;
+			return &tag;
+		}
+		
+	private:
+		dest_type *m_pobject;
+		void (dest_type::* m_pmemfun)();
+		ConnectionMode m_mode;
+		const void *m_key;
+	};
+	
+	template<class dest_type, class arg1_type, class mt_policy>
+	class _queued_call1 : public _queued_call {
+	public:
+		_queued_call1(const void *key, dest_type *pobject, void (dest_type::*pmemfun)(arg1_type), arg1_type a1)
+		: _queued_call(static_cast<HasSlots<mt_policy> *>(pobject), key), m_pobject(pobject), m_pmemfun(pmemfun), m_a1(a1) {
+		}
+		
+		virtual void enter() {
+			m_pobject->enterSlot();
+		}
+		
+		virtual void leave() {
+			m_pobject->leaveSlot();
+		}
+		
+		virtual void run() {
+			(m_pobject->*m_pmemfun)(m_a1);
+		}
+		
+	private:
+		dest_type *m_pobject;
+		void (dest_type::* m_pmemfun)(arg1_type);
+		typename _value_type<arg1_type>::type m_a1;
+	};
+	
+	// Connection made with a ConnectionMode other than DIRECT_CONNECTION.
+	template<class dest_type, class arg1_type, class mt_policy>
+	class _queued_connection1 : public _connection_base1<arg1_type, mt_policy> {
+	public:
+		_queued_connection1(dest_type *pobject, void (dest_type::*pmemfun)(arg1_type), ConnectionMode mode, const void *key)
+		: m_pobject(pobject), m_pmemfun(pmemfun), m_mode(mode), m_key(key) {
+		}
+		
+		virtual _connection_base1<arg1_type, mt_policy>* clone() {
+			return new _queued_connection1<dest_type, arg1_type, mt_policy>(*this);
+		}
+		
+		virtual _connection_base1<arg1_type, mt_policy>* duplicate(HasSlots<mt_policy>* pnewdest) {
+			return new _queued_connection1<dest_type, arg1_type, mt_policy>((dest_type *)pnewdest, m_pmemfun, m_mode, m_key);
+		}
+		
+		virtual void shoot(arg1_type a1) {
+			Executor *executor = m_pobject->executor();
+			
+			if (executor == NULL || (m_mode == AUTO_CONNECTION && executor->isCurrent())) {
+				(m_pobject->*m_pmemfun)(a1);
+			} else {
+				executor->post(new _queued_call1<dest_type, arg1_type, mt_policy>(m_key != NULL ? m_key : this, m_pobject, m_pmemfun, a1));
+			}
+		}
+		
+		virtual HasSlots<mt_policy>* getdest() const {
+			return m_pobject;
+		}
+		
+		virtual std::size_t size() const {
+			return sizeof(*this);
+		}
+		
+		virtual std::size_t method(const void *&bytes) const {
+			bytes = &m_pmemfun;
+			return sizeof(m_pmemfun);
+		}
+		
+		virtual const void *stub() const {
+			static const char tag = 0;
+			return &tag;
+		}
+		
+	private:
+		dest_type *m_pobject;
+		void (dest_type::* m_pmemfun)(arg1_type);
+		ConnectionMode m_mode;
+		const void *m_key;
+	};
+	
+	template<class dest_type, class arg1_type, class arg2_type, class mt_policy>
+	class _queued_call2 : public _queued_call {
+	public:
+		_queued_call2(const void *key, dest_type *pobject, void (dest_type::*pmemfun)(arg1_type, arg2_type), arg1_type a1, arg2_type a2)
+		: _queued_call(static_cast<HasSlots<mt_policy> *>(pobject), key), m_pobject(pobject), m_pmemfun(pmemfun), m_a1(a1), m_a2(a2) {
+		}
+		
+		virtual void enter() {
+			m_pobject->enterSlot();
+		}
+		
+		virtual void leave() {
+			m_pobject->leaveSlot();
+		}
+		
+		virtual void run() {
+			(m_pobject->*m_pmemfun)(m_a1, m_a2);
+		}
+		
+	private:
+		dest_type *m_pobject;
+		void (dest_type::* m_pmemfun)(arg1_type, arg2_type);
+		typename _value_type<arg1_type>::type m_a1;
+		typename _value_type<arg2_type>::type m_a2;
+	};
+	
+	// Connection made with a ConnectionMode other than DIRECT_CONNECTION.
+	template<class dest_type, class arg1_type, class arg2_type, class mt_policy>
+	class _queued_connection2 : public _connection_base2<arg1_type, arg2_type, mt_policy> {
+	public:
+		_queued_connection2(dest_type *pobject, void (dest_type::*pmemfun)(arg1_type, arg2_type), ConnectionMode mode, const void *key)
+		: m_pobject(pobject), m_pmemfun(pmemfun), m_mode(mode), m_key(key) {
+		}
+		
+		virtual _connection_base2<arg1_type, arg2_type, mt_policy>* clone() {
+			return new _queued_connection2<dest_type, arg1_type, arg2_type, mt_policy>(*this);
+		}
+		
+		virtual _connection_base2<arg1_type, arg2_type, mt_policy>* duplicate(HasSlots<mt_policy>* pnewdest) {
+			return new _queued_connection2<dest_type, arg1_type, arg2_type, mt_policy>((dest_type *)pnewdest, m_pmemfun, m_mode, m_key);
+		}
+		
+		virtual void shoot(arg1_type a1, arg2_type a2) {
+			Executor *executor = m_pobject->executor();
+			
+			if (executor == NULL || (m_mode == AUTO_CONNECTION && executor->isCurrent())) {
+				(m_pobject->*m_pmemfun)(a1, a2);
+			} else {
+				executor->post(new _queued_call2<dest_type, arg1_type, arg2_type, mt_policy>(m_key != NULL ? m_key : this, m_pobject, m_pmemfun, a1, a2));
+			}
+		}
+		
+		virtual HasSlots<mt_policy>* getdest() const {
+			return m_pobject;
+		}
+		
+		virtual std::size_t size() const {
+			return sizeof(*this);
+		}
+		
+		virtual std::size_t method(const void *&bytes) const {
+			bytes = &m_pmemfun;
+			return sizeof(m_pmemfun);
+		}
+		
+		virtual const void *stub() const {
+			static const char tag = 0;
+			return &tag;
+		}
+		
+	private:
+		dest_type *m_pobject;
+		void (dest_type::* m_pmemfun)(arg1_type, arg2_type);
+		ConnectionMode m_mode;
+		const void *m_key;
+	};
+	
+	template<class dest_type, class arg1_type, class arg2_type, class arg3_type, class mt_policy>
+	class _queued_call3 : public _queued_call {
+	public:
+		_queued_call3(const void *key, dest_type *pobject, void (dest_type::*pmemfun)(arg1_type, arg2_type, arg3_type), arg1_type a1, arg2_type a2, arg3_type a3)
+		: _queued_call(static_cast<HasSlots<mt_policy> *>(pobject), key), m_pobject(pobject), m_pmemfun(pmemfun), m_a1(a1), m_a2(a2), m_a3(a3) {
+		}
+		
+		virtual void enter() {
+			m_pobject->enterSlot();
+		}
+		
+		virtual void leave() {
+			m_pobject->leaveSlot();
+		}
+		
+		virtual void run() {
+			(m_pobject->*m_pmemfun)(m_a1, m_a2, m_a3);
+		}
+		
+	private:
+		dest_type *m_pobject;
+		void (dest_type::* m_pmemfun)(arg1_type, arg2_type, arg3_type);
+		typename _value_type<arg1_type>::type m_a1;
+		typename _value_type<arg2_type>::type m_a2;
+		typename _value_type<arg3_type>::type m_a3;
+	};
+	
+	// Connection made with a ConnectionMode other than DIRECT_CONNECTION.
+	template<class dest_type, class arg1_type, class arg2_type, class arg3_type, class mt_policy>
+	class _queued_connection3 : public _connection_base3<arg1_type, arg2_type, arg3_type, mt_policy> {
+	public:
+		_queued_connection3(dest_type *pobject, void (dest_type::*pmemfun)(arg1_type, arg2_type, arg3_type), ConnectionMode mode, const void *key)
+		: m_pobject(pobject), m_pmemfun(pmemfun), m_mode(mode), m_key(key) {
+		}
+		
+		virtual _connection_base3<arg1_type, arg2_type, arg3_type, mt_policy>* clone() {
+			return new _queued_connection3<dest_type, arg1_type, arg2_type, arg3_type, mt_policy>(*this);
+		}
+		
+		virtual _connection_base3<arg1_type, arg2_type, arg3_type, mt_policy>* duplicate(HasSlots<mt_policy>* pnewdest) {
+			return new _queued_connection3<dest_type, arg1_type, arg2_type, arg3_type, mt_policy>((dest_type *)pnewdest, m_pmemfun, m_mode, m_key);
+		}
+		
+		virtual void shoot(arg1_type a1, arg2_type a2, arg3_type a3) {
+			Executor *executor = m_pobject->executor();
+			
+			if (executor == NULL || (m_mode == AUTO_CONNECTION && executor->isCurrent())) {
+				(m_pobject->*m_pmemfun)(a1, a2, a3);
+			} else {
+				executor->post(new _queued_call3<dest_type, arg1_type, arg2_type, arg3_type, mt_policy>(m_key != NULL ? m_key : this, m_pobject, m_pmemfun, a1, a2, a3));
+			}
+		}
+		
+		virtual HasSlots<mt_policy>* getdest() const {
+			return m_pobject;
+		}
+		
+		virtual std::size_t size() const {
+			return sizeof(*this);
+		}
+		
+		virtual std::size_t method(const void *&bytes) const {
+			bytes = &m_pmemfun;
+			return sizeof(m_pmemfun);
+		}
+		
+		virtual const void *stub() const {
+			static const char tag = 0;
+			return &tag;
+		}
+		
+	private:
+		dest_type *m_pobject;
+		void (dest_type::* m_pmemfun)(arg1_type, arg2_type, arg3_type);
+		ConnectionMode m_mode;
+		const void *m_key;
+	};
+	
+	template<class dest_type, class arg1_type, class arg2_type, class arg3_type, class arg4_type, class mt_policy>
+	class _queued_call4 : public _queued_call {
+	public:
+		_queued_call4(const void *key, dest_type *pobject, void (dest_type::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type), arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4)
+		: _queued_call(static_cast<HasSlots<mt_policy> *>(pobject), key), m_pobject(pobject), m_pmemfun(pmemfun), m_a1(a1), m_a2(a2), m_a3(a3), m_a4(a4) {
+		}
+		
+		virtual void enter() {
+			m_pobject->enterSlot();
+		}
+		
+		virtual void leave() {
+			m_pobject->leaveSlot();
+		}
+		
+		virtual void run() {
+			(m_pobject->*m_pmemfun)(m_a1, m_a2, m_a3, m_a4);
+		}
+		
+	private:
+		dest_type *m_pobject;
+		void (dest_type::* m_pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type);
+		typename _value_type<arg1_type>::type m_a1;
+		typename _value_type<arg2_type>::type m_a2;
+		typename _value_type<arg3_type>::type m_a3;
+		typename _value_type<arg4_type>::type m_a4;
+	};
+	
+	// Connection made with a ConnectionMode other than DIRECT_CONNECTION.
+	template<class dest_type, class arg1_type, class arg2_type, class arg3_type, class arg4_type, class mt_policy>
+	class _queued_connection4 : public _connection_base4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy> {
+	public:
+		_queued_connection4(dest_type *pobject, void (dest_type::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type), ConnectionMode mode, const void *key)
+		: m_pobject(pobject), m_pmemfun(pmemfun), m_mode(mode), m_key(key) {
+		}
+		
+		virtual _connection_base4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>* clone() {
+			return new _queued_connection4<dest_type, arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>(*this);
+		}
+		
+		virtual _connection_base4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>* duplicate(HasSlots<mt_policy>* pnewdest) {
+			return new _queued_connection4<dest_type, arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>((dest_type *)pnewdest, m_pmemfun, m_mode, m_key);
+		}
+		
+		virtual void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4) {
+			Executor *executor = m_pobject->executor();
+			
+			if (executor == NULL || (m_mode == AUTO_CONNECTION && executor->isCurrent())) {
+				(m_pobject->*m_pmemfun)(a1, a2, a3, a4);
+			} else {
+				executor->post(new _queued_call4<dest_type, arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>(m_key != NULL ? m_key : this, m_pobject, m_pmemfun, a1, a2, a3, a4));
+			}
+		}
+		
+		virtual HasSlots<mt_policy>* getdest() const {
+			return m_pobject;
+		}
+		
+		virtual std::size_t size() const {
+			return sizeof(*this);
+		}
+		
+		virtual std::size_t method(const void *&bytes) const {
+			bytes = &m_pmemfun;
+			return sizeof(m_pmemfun);
+		}
+		
+		virtual const void *stub() const {
+			static const char tag = 0;
+			return &tag;
+		}
+		
+	private:
+		dest_type *m_pobject;
+		void (dest_type::* m_pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type);
+		ConnectionMode m_mode;
+		const void *m_key;
+	};
+	
+	template<class dest_type, class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class mt_policy>
+	class _queued_call5 : public _queued_call {
+	public:
+		_queued_call5(const void *key, dest_type *pobject, void (dest_type::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type), arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5)
+		: _queued_call(static_cast<HasSlots<mt_policy> *>(pobject), key), m_pobject(pobject), m_pmemfun(pmemfun), m_a1(a1), m_a2(a2), m_a3(a3), m_a4(a4), m_a5(a5) {
+		}
+		
+		virtual void enter() {
+			m_pobject->enterSlot();
+		}
+		
+		virtual void leave() {
+			m_pobject->leaveSlot();
+		}
+		
+		virtual void run() {
+			(m_pobject->*m_pmemfun)(m_a1, m_a2, m_a3, m_a4, m_a5);
+		}
+		
+	private:
+		dest_type *m_pobject;
+		void (dest_type::* m_pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type);
+		typename _value_type<arg1_type>::type m_a1;
+		typename _value_type<arg2_type>::type m_a2;
+		typename _value_type<arg3_type>::type m_a3;
+		typename _value_type<arg4_type>::type m_a4;
+		typename _value_type<arg5_type>::type m_a5;
+	};
+	
+	// Connection made with a ConnectionMode other than DIRECT_CONNECTION.
+	template<class dest_type, class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class mt_policy>
+	class _queued_connection5 : public _connection_base5<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy> {
+	public:
+		_queued_connection5(dest_type *pobject, void (dest_type::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type), ConnectionMode mode, const void *key)
+		: m_pobject(pobject), m_pmemfun(pmemfun), m_mode(mode), m_key(key) {
+		}
+		
+		virtual _connection_base5<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy>* clone() {
+			return new _queued_connection5<dest_type, arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy>(*this);
+		}
+		
+		virtual _connection_base5<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy>* duplicate(HasSlots<mt_policy>* pnewdest) {
+			return new _queued_connection5<dest_type, arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy>((dest_type *)pnewdest, m_pmemfun, m_mode, m_key);
+		}
+		
+		virtual void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5) {
+			Executor *executor = m_pobject->executor();
+			
+			if (executor == NULL || (m_mode == AUTO_CONNECTION && executor->isCurrent())) {
+				(m_pobject->*m_pmemfun)(a1, a2, a3, a4, a5);
+			} else {
+				executor->post(new _queued_call5<dest_type, arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy>(m_key != NULL ? m_key : this, m_pobject, m_pmemfun, a1, a2, a3, a4, a5));
+			}
+		}
+		
+		virtual HasSlots<mt_policy>* getdest() const {
+			return m_pobject;
+		}
+		
+		virtual std::size_t size() const {
+			return sizeof(*this);
+		}
+		
+		virtual std::size_t method(const void *&bytes) const {
+			bytes = &m_pmemfun;
+			return sizeof(m_pmemfun);
+		}
+		
+		virtual const void *stub() const {
+			static const char tag = 0;
+			return &tag;
+		}
+		
+	private:
+		dest_type *m_pobject;
+		void (dest_type::* m_pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type);
+		ConnectionMode m_mode;
+		const void *m_key;
+	};
+	
+	template<class dest_type, class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class mt_policy>
+	class _queued_call6 : public _queued_call {
+	public:
+		_queued_call6(const void *key, dest_type *pobject, void (dest_type::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type), arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6)
+		: _queued_call(static_cast<HasSlots<mt_policy> *>(pobject), key), m_pobject(pobject), m_pmemfun(pmemfun), m_a1(a1), m_a2(a2), m_a3(a3), m_a4(a4), m_a5(a5), m_a6(a6) {
+		}
+		
+		virtual void enter() {
+			m_pobject->enterSlot();
+		}
+		
+		virtual void leave() {
+			m_pobject->leaveSlot();
+		}
+		
+		virtual void run() {
+			(m_pobject->*m_pmemfun)(m_a1, m_a2, m_a3, m_a4, m_a5, m_a6);
+		}
+		
+	private:
+		dest_type *m_pobject;
+		void (dest_type::* m_pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type);
+		typename _value_type<arg1_type>::type m_a1;
+		typename _value_type<arg2_type>::type m_a2;
+		typename _value_type<arg3_type>::type m_a3;
+		typename _value_type<arg4_type>::type m_a4;
+		typename _value_type<arg5_type>::type m_a5;
+		typename _value_type<arg6_type>::type m_a6;
+	};
+	
+	// Connection made with a ConnectionMode other than DIRECT_CONNECTION.
+	template<class dest_type, class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class mt_policy>
+	class _queued_connection6 : public _connection_base6<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy> {
+	public:
+		_queued_connection6(dest_type *pobject, void (dest_type::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type), ConnectionMode mode, const void *key)
+		: m_pobject(pobject), m_pmemfun(pmemfun), m_mode(mode), m_key(key) {
+		}
+		
+		virtual _connection_base6<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy>* clone() {
+			return new _queued_connection6<dest_type, arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy>(*this);
+		}
+		
+		virtual _connection_base6<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy>* duplicate(HasSlots<mt_policy>* pnewdest) {
+			return new _queued_connection6<dest_type, arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy>((dest_type *)pnewdest, m_pmemfun, m_mode, m_key);
+		}
+		
+		virtual void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6) {
+			Executor *executor = m_pobject->executor();
+			
+			if (executor == NULL || (m_mode == AUTO_CONNECTION && executor->isCurrent())) {
+				(m_pobject->*m_pmemfun)(a1, a2, a3, a4, a5, a6);
+			} else {
+				executor->post(new _queued_call6<dest_type, arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy>(m_key != NULL ? m_key : this, m_pobject, m_pmemfun, a1, a2, a3, a4, a5, a6));
+			}
+		}
+		
+		virtual HasSlots<mt_policy>* getdest() const {
+			return m_pobject;
+		}
+		
+		virtual std::size_t size() const {
+			return sizeof(*this);
+		}
+		
+		virtual std::size_t method(const void *&bytes) const {
+			bytes = &m_pmemfun;
+			return sizeof(m_pmemfun);
+		}
+		
+		virtual const void *stub() const {
+			static const char tag = 0;
+			return &tag;
+		}
+		
+	private:
+		dest_type *m_pobject;
+		void (dest_type::* m_pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type);
+		ConnectionMode m_mode;
+		const void *m_key;
+	};
+	
+	template<class dest_type, class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class arg7_type, class mt_policy>
+	class _queued_call7 : public _queued_call {
+	public:
+		_queued_call7(const void *key, dest_type *pobject, void (dest_type::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type), arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6, arg7_type a7)
+		: _queued_call(static_cast<HasSlots<mt_policy> *>(pobject), key), m_pobject(pobject), m_pmemfun(pmemfun), m_a1(a1), m_a2(a2), m_a3(a3), m_a4(a4), m_a5(a5), m_a6(a6), m_a7(a7) {
+		}
+		
+		virtual void enter() {
+			m_pobject->enterSlot();
+		}
+		
+		virtual void leave() {
+			m_pobject->leaveSlot();
+		}
+		
+		virtual void run() {
+			(m_pobject->*m_pmemfun)(m_a1, m_a2, m_a3, m_a4, m_a5, m_a6, m_a7);
+		}
+		
+	private:
+		dest_type *m_pobject;
+		void (dest_type::* m_pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type);
+		typename _value_type<arg1_type>::type m_a1;
+		typename _value_type<arg2_type>::type m_a2;
+		typename _value_type<arg3_type>::type m_a3;
+		typename _value_type<arg4_type>::type m_a4;
+		typename _value_type<arg5_type>::type m_a5;
+		typename _value_type<arg6_type>::type m_a6;
+		typename _value_type<arg7_type>::type m_a7;
+	};
+	
+	// Connection made with a ConnectionMode other than DIRECT_CONNECTION.
+	template<class dest_type, class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class arg7_type, class mt_policy>
+	class _queued_connection7 : public _connection_base7<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy> {
+	public:
+		_queued_connection7(dest_type *pobject, void (dest_type::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type), ConnectionMode mode, const void *key)
+		: m_pobject(pobject), m_pmemfun(pmemfun), m_mode(mode), m_key(key) {
+		}
+		
+		virtual _connection_base7<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy>* clone() {
+			return new _queued_connection7<dest_type, arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy>(*this);
+		}
+		
+		virtual _connection_base7<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy>* duplicate(HasSlots<mt_policy>* pnewdest) {
+			return new _queued_connection7<dest_type, arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy>((dest_type *)pnewdest, m_pmemfun, m_mode, m_key);
+		}
+		
+		virtual void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6, arg7_type a7) {
+			Executor *executor = m_pobject->executor();
+			
+			if (executor == NULL || (m_mode == AUTO_CONNECTION && executor->isCurrent())) {
+				(m_pobject->*m_pmemfun)(a1, a2, a3, a4, a5, a6, a7);
+			} else {
+				executor->post(new _queued_call7<dest_type, arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy>(m_key != NULL ? m_key : this, m_pobject, m_pmemfun, a1, a2, a3, a4, a5, a6, a7));
+			}
+		}
+		
+		virtual HasSlots<mt_policy>* getdest() const {
+			return m_pobject;
+		}
+		
+		virtual std::size_t size() const {
+			return sizeof(*this);
+		}
+		
+		virtual std::size_t method(const void *&bytes) const {
+			bytes = &m_pmemfun;
+			return sizeof(m_pmemfun);
+		}
+		
+		virtual const void *stub() const {
+			static const char tag = 0;
+			return &tag;
+		}
+		
+	private:
+		dest_type *m_pobject;
+		void (dest_type::* m_pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type);
+		ConnectionMode m_mode;
+		const void *m_key;
+	};
+	
+	template<class dest_type, class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class arg7_type, class arg8_type, class mt_policy>
+	class _queued_call8 : public _queued_call {
+	public:
+		_queued_call8(const void *key, dest_type *pobject, void (dest_type::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type), arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6, arg7_type a7, arg8_type a8)
+		: _queued_call(static_cast<HasSlots<mt_policy> *>(pobject), key), m_pobject(pobject), m_pmemfun(pmemfun), m_a1(a1), m_a2(a2), m_a3(a3), m_a4(a4), m_a5(a5), m_a6(a6), m_a7(a7), m_a8(a8) {
+		}
+		
+		virtual void enter() {
+			m_pobject->enterSlot();
+		}
+		
+		virtual void leave() {
+			m_pobject->leaveSlot();
+		}
+		
+		virtual void run() {
+			(m_pobject->*m_pmemfun)(m_a1, m_a2, m_a3, m_a4, m_a5, m_a6, m_a7, m_a8);
+		}
+		
+	private:
+		dest_type *m_pobject;
+		void (dest_type::* m_pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type);
+		typename _value_type<arg1_type>::type m_a1;
+		typename _value_type<arg2_type>::type m_a2;
+		typename _value_type<arg3_type>::type m_a3;
+		typename _value_type<arg4_type>::type m_a4;
+		typename _value_type<arg5_type>::type m_a5;
+		typename _value_type<arg6_type>::type m_a6;
+		typename _value_type<arg7_type>::type m_a7;
+		typename _value_type<arg8_type>::type m_a8;
+	};
+	
+	// Connection made with a ConnectionMode other than DIRECT_CONNECTION.
+	template<class dest_type, class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class arg7_type, class arg8_type, class mt_policy>
+	class _queued_connection8 : public _connection_base8<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy> {
+	public:
+		_queued_connection8(dest_type *pobject, void (dest_type::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type), ConnectionMode mode, const void *key)
+		: m_pobject(pobject), m_pmemfun(pmemfun), m_mode(mode), m_key(key) {
+		}
+		
+		virtual _connection_base8<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy>* clone() {
+			return new _queued_connection8<dest_type, arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy>(*this);
+		}
+		
+		virtual _connection_base8<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy>* duplicate(HasSlots<mt_policy>* pnewdest) {
+			return new _queued_connection8<dest_type, arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy>((dest_type *)pnewdest, m_pmemfun, m_mode, m_key);
+		}
+		
+		virtual void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6, arg7_type a7, arg8_type a8) {
+			Executor *executor = m_pobject->executor();
+			
+			if (executor == NULL || (m_mode == AUTO_CONNECTION && executor->isCurrent())) {
+				(m_pobject->*m_pmemfun)(a1, a2, a3, a4, a5, a6, a7, a8);
+			} else {
+				executor->post(new _queued_call8<dest_type, arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy>(m_key != NULL ? m_key : this, m_pobject, m_pmemfun, a1, a2, a3, a4, a5, a6, a7, a8));
+			}
+		}
+		
+		virtual HasSlots<mt_policy>* getdest() const {
+			return m_pobject;
+		}
+		
+		virtual std::size_t size() const {
+			return sizeof(*this);
+		}
+		
+		virtual std::size_t method(const void *&bytes) const {
+			bytes = &m_pmemfun;
+			return sizeof(m_pmemfun);
+		}
+		
+		virtual const void *stub() const {
+			static const char tag = 0;
+			return &tag;
+		}
+		
+	private:
+		dest_type *m_pobject;
+		void (dest_type::* m_pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type);
+		ConnectionMode m_mode;
+		const void *m_key;
+	};
+	
+	// The original connection of a demoted one, shared with the calls it
+	// posted, which may run after the signal has dropped the connection.
+	template<class connection_type>
+	class _demoted_target {
+	public:
+		_demoted_target(connection_type *conn): m_conn(conn), m_refs(1) {
+		}
+		
+		connection_type *connection() const {
+			return m_conn;
+		}
+		
+		void acquire() {
+			_atomic_increment(&m_refs);
+		}
+		
+		void release() {
+			if (_atomic_decrement(&m_refs) == 0) {
+				delete m_conn;
+				delete this;
+			}
+		}
+		
+	private:
+		_demoted_target(const _demoted_target &);
+		_demoted_target &operator=(const _demoted_target &);
+		
+		connection_type *m_conn;
+		volatile long m_refs;
+	};
+	
+	// Call posted by a demoted connection, running its original connection.
+	template<class mt_policy>
+	class _demoted_call0 : public _queued_call {
+	public:
+		typedef _demoted_target<_connection_base0<mt_policy> > target_type;
+		
+		_demoted_call0(target_type *target)
+		: _queued_call(target->connection()->getdest(), target), m_target(target) {
+			m_target->acquire();
+		}
+		
+		~_demoted_call0() {
+			m_target->release();
+		}
+		
+		virtual void enter() {
+			m_target->connection()->getdest()->enterSlot();
+		}
+		
+		virtual void leave() {
+			m_target->connection()->getdest()->leaveSlot();
+		}
+		
+		virtual void run() {
+			m_target->connection()->shoot();
+		}
+		
+	private:
+		target_type *m_target;
+	};
+	
+	// Connection demoted by a latency budget: posts the calls of the
+	// original connection to the worker instead of making them.
+	template<class mt_policy>
+	class _demoted_connection0 : public _connection_base0<mt_policy> {
+	public:
+		typedef _demoted_target<_connection_base0<mt_policy> > target_type;
+		
+		_demoted_connection0(_connection_base0<mt_policy> *conn, Executor *worker)
+		: m_target(new target_type(conn)), m_worker(worker) {
+		}
+		
+		~_demoted_connection0() {
+			m_target->release();
+		}
+		
+		virtual _connection_base0<mt_policy>* clone() {
+			return new _demoted_connection0<mt_policy>(static_cast<_connection_base0<mt_policy> *>(m_target->connection()->clone()), m_worker);
+		}
+		
+		virtual _connection_base0<mt_policy>* duplicate(HasSlots<mt_policy>* pnewdest) {
+			return new _demoted_connection0<mt_policy>(static_cast<_connection_base0<mt_policy> *>(m_target->connection()->duplicate(pnewdest)), m_worker);
+		}
+		
+		virtual void shoot() {
+			m_worker->post(new _demoted_call0<mt_policy>(m_target));
+		}
+		
+		// Already demoted.
+		virtual _connection_base<mt_policy> *demote(Executor *) {
+			return NULL;
+		}
+		
+		virtual HasSlots<mt_policy>* getdest() const {
+			return m_target->connection()->getdest();
+		}
+		
+		virtual std::size_t size() const {
+			return sizeof(*this) + sizeof(target_type) + m_target->connection()->size();
+		}
+		
+		virtual std::size_t method(const void *&bytes) const {
+			return m_target->connection()->method(bytes);
+		}
+		
+		virtual const void *stub() const {
+			return m_target->connection()->stub();
+		}
+		
+	private:
+		target_type *m_target;
+		Executor *m_worker;
+	};
+	
+	// Call posted by a demoted connection, running its original connection.
+	template<class arg1_type, class mt_policy>
+	class _demoted_call1 : public _queued_call {
+	public:
+		typedef _demoted_target<_connection_base1<arg1_type, mt_policy> > target_type;
+		
+		_demoted_call1(target_type *target, arg1_type a1)
+		: _queued_call(target->connection()->getdest(), target), m_target(target), m_a1(a1) {
+			m_target->acquire();
+		}
+		
+		~_demoted_call1() {
+			m_target->release();
+		}
+		
+		virtual void enter() {
+			m_target->connection()->getdest()->enterSlot();
+		}
+		
+		virtual void leave() {
+			m_target->connection()->getdest()->leaveSlot();
+		}
+		
+		virtual void run() {
+			m_target->connection()->shoot(m_a1);
+		}
+		
+	private:
+		target_type *m_target;
+		typename _value_type<arg1_type>::type m_a1;
+	};
+	
+	// Connection demoted by a latency budget: posts the calls of the
+	// original connection to the worker instead of making them.
+	template<class arg1_type, class mt_policy>
+	class _demoted_connection1 : public _connection_base1<arg1_type, mt_policy> {
+	public:
+		typedef _demoted_target<_connection_base1<arg1_type, mt_policy> > target_type;
+		
+		_demoted_connection1(_connection_base1<arg1_type, mt_policy> *conn, Executor *worker)
+		: m_target(new target_type(conn)), m_worker(worker) {
+		}
+		
+		~_demoted_connection1() {
+			m_target->release();
+		}
+		
+		virtual _connection_base1<arg1_type, mt_policy>* clone() {
+			return new _demoted_connection1<arg1_type, mt_policy>(static_cast<_connection_base1<arg1_type, mt_policy> *>(m_target->connection()->clone()), m_worker);
+		}
+		
+		virtual _connection_base1<arg1_type, mt_policy>* duplicate(HasSlots<mt_policy>* pnewdest) {
+			return new _demoted_connection1<arg1_type, mt_policy>(static_cast<_connection_base1<arg1_type, mt_policy> *>(m_target->connection()->duplicate(pnewdest)), m_worker);
+		}
+		
+		virtual void shoot(arg1_type a1) {
+			m_worker->post(new _demoted_call1<arg1_type, mt_policy>(m_target, a1));
+		}
+		
+		// Already demoted.
+		virtual _connection_base<mt_policy> *demote(Executor *) {
+			return NULL;
+		}
+		
+		virtual HasSlots<mt_policy>* getdest() const {
+			return m_target->connection()->getdest();
+		}
+		
+		virtual std::size_t size() const {
+			return sizeof(*this) + sizeof(target_type) + m_target->connection()->size();
+		}
+		
+		virtual std::size_t method(const void *&bytes) const {
+			return m_target->connection()->method(bytes);
+		}
+		
+		virtual const void *stub() const {
+			return m_target->connection()->stub();
+		}
+		
+	private:
+		target_type *m_target;
+		Executor *m_worker;
+	};
+	
+	// Call posted by a demoted connection, running its original connection.
+	template<class arg1_type, class arg2_type, class mt_policy>
+	class _demoted_call2 : public _queued_call {
+	public:
+		typedef _demoted_target<_connection_base2<arg1_type, arg2_type, mt_policy> > target_type;
+		
+		_demoted_call2(target_type *target, arg1_type a1, arg2_type a2)
+		: _queued_call(target->connection()->getdest(), target), m_target(target), m_a1(a1), m_a2(a2) {
+			m_target->acquire();
+		}
+		
+		~_demoted_call2() {
+			m_target->release();
+		}
+		
+		virtual void enter() {
+			m_target->connection()->getdest()->enterSlot();
+		}
+		
+		virtual void leave() {
+			m_target->connection()->getdest()->leaveSlot();
+		}
+		
+		virtual void run() {
+			m_target->connection()->shoot(m_a1, m_a2);
+		}
+		
+	private:
+		target_type *m_target;
+		typename _value_type<arg1_type>::type m_a1;
+		typename _value_type<arg2_type>::type m_a2;
+	};
+	
+	// Connection demoted by a latency budget: posts the calls of the
+	// original connection to the worker instead of making them.
+	template<class arg1_type, class arg2_type, class mt_policy>
+	class _demoted_connection2 : public _connection_base2<arg1_type, arg2_type, mt_policy> {
+	public:
+		typedef _demoted_target<_connection_base2<arg1_type, arg2_type, mt_policy> > target_type;
+		
+		_demoted_connection2(_connection_base2<arg1_type, arg2_type, mt_policy> *conn, Executor *worker)
+		: m_target(new target_type(conn)), m_worker(worker) {
+		}
+		
+		~_demoted_connection2() {
+			m_target->release();
+		}
+		
+		virtual _connection_base2<arg1_type, arg2_type, mt_policy>* clone() {
+			return new _demoted_connection2<arg1_type, arg2_type, mt_policy>(static_cast<_connection_base2<arg1_type, arg2_type, mt_policy> *>(m_target->connection()->clone()), m_worker);
+		}
+		
+		virtual _connection_base2<arg1_type, arg2_type, mt_policy>* duplicate(HasSlots<mt_policy>* pnewdest) {
+			return new _demoted_connection2<arg1_type, arg2_type, mt_policy>(static_cast<_connection_base2<arg1_type, arg2_type, mt_policy> *>(m_target->connection()->duplicate(pnewdest)), m_worker);
+		}
+		
+		virtual void shoot(arg1_type a1, arg2_type a2) {
+			m_worker->post(new _demoted_call2<arg1_type, arg2_type, mt_policy>(m_target, a1, a2));
+		}
+		
+		// Already demoted.
+		virtual _connection_base<mt_policy> *demote(Executor *) {
+			return NULL;
+		}
+		
+		virtual HasSlots<mt_policy>* getdest() const {
+			return m_target->connection()->getdest();
+		}
+		
+		virtual std::size_t size() const {
+			return sizeof(*this) + sizeof(target_type) + m_target->connection()->size();
+		}
+		
+		virtual std::size_t method(const void *&bytes) const {
+			return m_target->connection()->method(bytes);
+		}
+		
+		virtual const void *stub() const {
+			return m_target->connection()->stub();
+		}
+		
+	private:
+		target_type *m_target;
+		Executor *m_worker;
+	};
+	
+	// Call posted by a demoted connection, running its original connection.
+	template<class arg1_type, class arg2_type, class arg3_type, class mt_policy>
+	class _demoted_call3 : public _queued_call {
+	public:
+		typedef _demoted_target<_connection_base3<arg1_type, arg2_type, arg3_type, mt_policy> > target_type;
+		
+		_demoted_call3(target_type *target, arg1_type a1, arg2_type a2, arg3_type a3)
+		: _queued_call(target->connection()->getdest(), target), m_target(target), m_a1(a1), m_a2(a2), m_a3(a3) {
+			m_target->acquire();
+		}
+		
+		~_demoted_call3() {
+			m_target->release();
+		}
+		
+		virtual void enter() {
+			m_target->connection()->getdest()->enterSlot();
+		}
+		
+		virtual void leave() {
+			m_target->connection()->getdest()->leaveSlot();
+		}
+		
+		virtual void run() {
+			m_target->connection()->shoot(m_a1, m_a2, m_a3);
+		}
+		
+	private:
+		target_type *m_target;
+		typename _value_type<arg1_type>::type m_a1;
+		typename _value_type<arg2_type>::type m_a2;
+		typename _value_type<arg3_type>::type m_a3;
+	};
+	
+	// Connection demoted by a latency budget: posts the calls of the
+	// original connection to the worker instead of making them.
+	template<class arg1_type, class arg2_type, class arg3_type, class mt_policy>
+	class _demoted_connection3 : public _connection_base3<arg1_type, arg2_type, arg3_type, mt_policy> {
+	public:
+		typedef _demoted_target<_connection_base3<arg1_type, arg2_type, arg3_type, mt_policy> > target_type;
+		
+		_demoted_connection3(_connection_base3<arg1_type, arg2_type, arg3_type, mt_policy> *conn, Executor *worker)
+		: m_target(new target_type(conn)), m_worker(worker) {
+		}
+		
+		~_demoted_connection3() {
+			m_target->release();
+		}
+		
+		virtual _connection_base3<arg1_type, arg2_type, arg3_type, mt_policy>* clone() {
+			return new _demoted_connection3<arg1_type, arg2_type, arg3_type, mt_policy>(static_cast<_connection_base3<arg1_type, arg2_type, arg3_type, mt_policy> *>(m_target->connection()->clone()), m_worker);
+		}
+		
+		virtual _connection_base3<arg1_type, arg2_type, arg3_type, mt_policy>* duplicate(HasSlots<mt_policy>* pnewdest) {
+			return new _demoted_connection3<arg1_type, arg2_type, arg3_type, mt_policy>(static_cast<_connection_base3<arg1_type, arg2_type, arg3_type, mt_policy> *>(m_target->connection()->duplicate(pnewdest)), m_worker);
+		}
+		
+		virtual void shoot(arg1_type a1, arg2_type a2, arg3_type a3) {
+			m_worker->post(new _demoted_call3<arg1_type, arg2_type, arg3_type, mt_policy>(m_target, a1, a2, a3));
+		}
+		
+		// Already demoted.
+		virtual _connection_base<mt_policy> *demote(Executor *) {
+			return NULL;
+		}
+		
+		virtual HasSlots<mt_policy>* getdest() const {
+			return m_target->connection()->getdest();
+		}
+		
+		virtual std::size_t size() const {
+			return sizeof(*this) + sizeof(target_type) + m_target->connection()->size();
+		}
+		
+		virtual std::size_t method(const void *&bytes) const {
+			return m_target->connection()->method(bytes);
+		}
+		
+		virtual const void *stub() const {
+			return m_target->connection()->stub();
+		}
+		
+	private:
+		target_type *m_target;
+		Executor *m_worker;
+	};
+	
+	// Call posted by a demoted connection, running its original connection.
+	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class mt_policy>
+	class _demoted_call4 : public _queued_call {
+	public:
+		typedef _demoted_target<_connection_base4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy> > target_type;
+		
+		_demoted_call4(target_type *target, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4)
+		: _queued_call(target->connection()->getdest(), target), m_target(target), m_a1(a1), m_a2(a2), m_a3(a3), m_a4(a4) {
+			m_target->acquire();
+		}
+		
+		~_demoted_call4() {
+			m_target->release();
+		}
+		
+		virtual void enter() {
+			m_target->connection()->getdest()->enterSlot();
+		}
+		
+		virtual void leave() {
+			m_target->connection()->getdest()->leaveSlot();
+		}
+		
+		virtual void run() {
+			m_target->connection()->shoot(m_a1, m_a2, m_a3, m_a4);
+		}
+		
+	private:
+		target_type *m_target;
+		typename _value_type<arg1_type>::type m_a1;
+		typename _value_type<arg2_type>::type m_a2;
+		typename _value_type<arg3_type>::type m_a3;
+		typename _value_type<arg4_type>::type m_a4;
+	};
+	
+	// Connection demoted by a latency budget: posts the calls of the
+	// original connection to the worker instead of making them.
+	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class mt_policy>
+	class _demoted_connection4 : public _connection_base4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy> {
+	public:
+		typedef _demoted_target<_connection_base4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy> > target_type;
+		
+		_demoted_connection4(_connection_base4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy> *conn, Executor *worker)
+		: m_target(new target_type(conn)), m_worker(worker) {
+		}
+		
+		~_demoted_connection4() {
+			m_target->release();
+		}
+		
+		virtual _connection_base4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>* clone() {
+			return new _demoted_connection4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>(static_cast<_connection_base4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy> *>(m_target->connection()->clone()), m_worker);
+		}
+		
+		virtual _connection_base4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>* duplicate(HasSlots<mt_policy>* pnewdest) {
+			return new _demoted_connection4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>(static_cast<_connection_base4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy> *>(m_target->connection()->duplicate(pnewdest)), m_worker);
+		}
+		
+		virtual void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4) {
+			m_worker->post(new _demoted_call4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>(m_target, a1, a2, a3, a4));
+		}
+		
+		// Already demoted.
+		virtual _connection_base<mt_policy> *demote(Executor *) {
+			return NULL;
+		}
+		
+		virtual HasSlots<mt_policy>* getdest() const {
+			return m_target->connection()->getdest();
+		}
+		
+		virtual std::size_t size() const {
+			return sizeof(*this) + sizeof(target_type) + m_target->connection()->size();
+		}
+		
+		virtual std::size_t method(const void *&bytes) const {
+			return m_target->connection()->method(bytes);
+		}
+		
+		virtual const void *stub() const {
+			return m_target->connection()->stub();
+		}
+		
+	private:
+		target_type *m_target;
+		Executor *m_worker;
+	};
+	
+	// Call posted by a demoted connection, running its original connection.
+	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class mt_policy>
+	class _demoted_call5 : public _queued_call {
+	public:
+		typedef _demoted_target<_connection_base5<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy> > target_type;
+		
+		_demoted_call5(target_type *target, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5)
+		: _queued_call(target->connection()->getdest(), target), m_target(target), m_a1(a1), m_a2(a2), m_a3(a3), m_a4(a4), m_a5(a5) {
+			m_target->acquire();
+		}
+		
+		~_demoted_call5() {
+			m_target->release();
+		}
+		
+		virtual void enter() {
+			m_target->connection()->getdest()->enterSlot();
+		}
+		
+		virtual void leave() {
+			m_target->connection()->getdest()->leaveSlot();
+		}
+		
+		virtual void run() {
+			m_target->connection()->shoot(m_a1, m_a2, m_a3, m_a4, m_a5);
+		}
+		
+	private:
+		target_type *m_target;
+		typename _value_type<arg1_type>::type m_a1;
+		typename _value_type<arg2_type>::type m_a2;
+		typename _value_type<arg3_type>::type m_a3;
+		typename _value_type<arg4_type>::type m_a4;
+		typename _value_type<arg5_type>::type m_a5;
+	};
+	
+	// Connection demoted by a latency budget: posts the calls of the
+	// original connection to the worker instead of making them.
+	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class mt_policy>
+	class _demoted_connection5 : public _connection_base5<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy> {
+	public:
+		typedef _demoted_target<_connection_base5<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy> > target_type;
+		
+		_demoted_connection5(_connection_base5<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy> *conn, Executor *worker)
+		: m_target(new target_type(conn)), m_worker(worker) {
+		}
+		
+		~_demoted_connection5() {
+			m_target->release();
+		}
+		
+		virtual _connection_base5<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy>* clone() {
+			return new _demoted_connection5<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy>(static_cast<_connection_base5<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy> *>(m_target->connection()->clone()), m_worker);
+		}
+		
+		virtual _connection_base5<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy>* duplicate(HasSlots<mt_policy>* pnewdest) {
+			return new _demoted_connection5<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy>(static_cast<_connection_base5<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy> *>(m_target->connection()->duplicate(pnewdest)), m_worker);
+		}
+		
+		virtual void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5) {
+			m_worker->post(new _demoted_call5<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy>(m_target, a1, a2, a3, a4, a5));
+		}
+		
+		// Already demoted.
+		virtual _connection_base<mt_policy> *demote(Executor *) {
+			return NULL;
+		}
+		
+		virtual HasSlots<mt_policy>* getdest() const {
+			return m_target->connection()->getdest();
+		}
+		
+		virtual std::size_t size() const {
+			return sizeof(*this) + sizeof(target_type) + m_target->connection()->size();
+		}
+		
+		virtual std::size_t method(const void *&bytes) const {
+			return m_target->connection()->method(bytes);
+		}
+		
+		virtual const void *stub() const {
+			return m_target->connection()->stub();
+		}
+		
+	private:
+		target_type *m_target;
+		Executor *m_worker;
+	};
+	
+	// Call posted by a demoted connection, running its original connection.
+	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class mt_policy>
+	class _demoted_call6 : public _queued_call {
+	public:
+		typedef _demoted_target<_connection_base6<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy> > target_type;
+		
+		_demoted_call6(target_type *target, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6)
+		: _queued_call(target->connection()->getdest(), target), m_target(target), m_a1(a1), m_a2(a2), m_a3(a3), m_a4(a4), m_a5(a5), m_a6(a6) {
+			m_target->acquire();
+		}
+		
+		~_demoted_call6() {
+			m_target->release();
+		}
+		
+		virtual void enter() {
+			m_target->connection()->getdest()->enterSlot();
+		}
+		
+		virtual void leave() {
+			m_target->connection()->getdest()->leaveSlot();
+		}
+		
+		virtual void run() {
+			m_target->connection()->shoot(m_a1, m_a2, m_a3, m_a4, m_a5, m_a6);
+		}
+		
+	private:
+		target_type *m_target;
+		typename _value_type<arg1_type>::type m_a1;
+		typename _value_type<arg2_type>::type m_a2;
+		typename _value_type<arg3_type>::type m_a3;
+		typename _value_type<arg4_type>::type m_a4;
+		typename _value_type<arg5_type>::type m_a5;
+		typename _value_type<arg6_type>::type m_a6;
+	};
+	
+	// Connection demoted by a latency budget: posts the calls of the
+	// original connection to the worker instead of making them.
+	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class mt_policy>
+	class _demoted_connection6 : public _connection_base6<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy> {
+	public:
+		typedef _demoted_target<_connection_base6<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy> > target_type;
+		
+		_demoted_connection6(_connection_base6<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy> *conn, Executor *worker)
+		: m_target(new target_type(conn)), m_worker(worker) {
+		}
+		
+		~_demoted_connection6() {
+			m_target->release();
+		}
+		
+		virtual _connection_base6<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy>* clone() {
+			return new _demoted_connection6<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy>(static_cast<_connection_base6<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy> *>(m_target->connection()->clone()), m_worker);
+		}
+		
+		virtual _connection_base6<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy>* duplicate(HasSlots<mt_policy>* pnewdest) {
+			return new _demoted_connection6<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy>(static_cast<_connection_base6<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy> *>(m_target->connection()->duplicate(pnewdest)), m_worker);
+		}
+		
+		virtual void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6) {
+			m_worker->post(new _demoted_call6<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy>(m_target, a1, a2, a3, a4, a5, a6));
+		}
+		
+		// Already demoted.
+		virtual _connection_base<mt_policy> *demote(Executor *) {
+			return NULL;
+		}
+		
+		virtual HasSlots<mt_policy>* getdest() const {
+			return m_target->connection()->getdest();
+		}
+		
+		virtual std::size_t size() const {
+			return sizeof(*this) + sizeof(target_type) + m_target->connection()->size();
+		}
+		
+		virtual std::size_t method(const void *&bytes) const {
+			return m_target->connection()->method(bytes);
+		}
+		
+		virtual const void *stub() const {
+			return m_target->connection()->stub();
+		}
+		
+	private:
+		target_type *m_target;
+		Executor *m_worker;
+	};
+	
+	// Call posted by a demoted connection, running its original connection.
+	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class arg7_type, class mt_policy>
+	class _demoted_call7 : public _queued_call {
+	public:
+		typedef _demoted_target<_connection_base7<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy> > target_type;
+		
+		_demoted_call7(target_type *target, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6, arg7_type a7)
+		: _queued_call(target->connection()->getdest(), target), m_target(target), m_a1(a1), m_a2(a2), m_a3(a3), m_a4(a4), m_a5(a5), m_a6(a6), m_a7(a7) {
+			m_target->acquire();
+		}
+		
+		~_demoted_call7() {
+			m_target->release();
+		}
+		
+		virtual void enter() {
+			m_target->connection()->getdest()->enterSlot();
+		}
+		
+		virtual void leave() {
+			m_target->connection()->getdest()->leaveSlot();
+		}
+		
+		virtual void run() {
+			m_target->connection()->shoot(m_a1, m_a2, m_a3, m_a4, m_a5, m_a6, m_a7);
+		}
+		
+	private:
+		target_type *m_target;
+		typename _value_type<arg1_type>::type m_a1;
+		typename _value_type<arg2_type>::type m_a2;
+		typename _value_type<arg3_type>::type m_a3;
+		typename _value_type<arg4_type>::type m_a4;
+		typename _value_type<arg5_type>::type m_a5;
+		typename _value_type<arg6_type>::type m_a6;
+		typename _value_type<arg7_type>::type m_a7;
+	};
+	
+	// Connection demoted by a latency budget: posts the calls of the
+	// original connection to the worker instead of making them.
+	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class arg7_type, class mt_policy>
+	class _demoted_connection7 : public _connection_base7<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy> {
+	public:
+		typedef _demoted_target<_connection_base7<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy> > target_type;
+		
+		_demoted_connection7(_connection_base7<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy> *conn, Executor *worker)
+		: m_target(new target_type(conn)), m_worker(worker) {
+		}
+		
+		~_demoted_connection7() {
+			m_target->release();
+		}
+		
+		virtual _connection_base7<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy>* clone() {
+			return new _demoted_connection7<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy>(static_cast<_connection_base7<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy> *>(m_target->connection()->clone()), m_worker);
+		}
+		
+		virtual _connection_base7<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy>* duplicate(HasSlots<mt_policy>* pnewdest) {
+			return new _demoted_connection7<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy>(static_cast<_connection_base7<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy> *>(m_target->connection()->duplicate(pnewdest)), m_worker);
+		}
+		
+		virtual void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6, arg7_type a7) {
+			m_worker->post(new _demoted_call7<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy>(m_target, a1, a2, a3, a4, a5, a6, a7));
+		}
+		
+		// Already demoted.
+		virtual _connection_base<mt_policy> *demote(Executor *) {
+			return NULL;
+		}
+		
+		virtual HasSlots<mt_policy>* getdest() const {
+			return m_target->connection()->getdest();
+		}
+		
+		virtual std::size_t size() const {
+			return sizeof(*this) + sizeof(target_type) + m_target->connection()->size();
+		}
+		
+		virtual std::size_t method(const void *&bytes) const {
+			return m_target->connection()->method(bytes);
+		}
+		
+		virtual const void *stub() const {
+			return m_target->connection()->stub();
+		}
+		
+	private:
+		target_type *m_target;
+		Executor *m_worker;
+	};
+	
+	// Call posted by a demoted connection, running its original connection.
+	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class arg7_type, class arg8_type, class mt_policy>
+	class _demoted_call8 : public _queued_call {
+	public:
+		typedef _demoted_target<_connection_base8<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy> > target_type;
+		
+		_demoted_call8(target_type *target, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6, arg7_type a7, arg8_type a8)
+		: _queued_call(target->connection()->getdest(), target), m_target(target), m_a1(a1), m_a2(a2), m_a3(a3), m_a4(a4), m_a5(a5), m_a6(a6), m_a7(a7), m_a8(a8) {
+			m_target->acquire();
+		}
+		
+		~_demoted_call8() {
+			m_target->release();
+		}
+		
+		virtual void enter() {
+			m_target->connection()->getdest()->enterSlot();
+		}
+		
+		virtual void leave() {
+			m_target->connection()->getdest()->leaveSlot();
+		}
+		
+		virtual void run() {
+			m_target->connection()->shoot(m_a1, m_a2, m_a3, m_a4, m_a5, m_a6, m_a7, m_a8);
+		}
+		
+	private:
+		target_type *m_target;
+		typename _value_type<arg1_type>::type m_a1;
+		typename _value_type<arg2_type>::type m_a2;
+		typename _value_type<arg3_type>::type m_a3;
+		typename _value_type<arg4_type>::type m_a4;
+		typename _value_type<arg5_type>::type m_a5;
+		typename _value_type<arg6_type>::type m_a6;
+		typename _value_type<arg7_type>::type m_a7;
+		typename _value_type<arg8_type>::type m_a8;
+	};
+	
+	// Connection demoted by a latency budget: posts the calls of the
+	// original connection to the worker instead of making them.
+	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class arg7_type, class arg8_type, class mt_policy>
+	class _demoted_connection8 : public _connection_base8<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy> {
+	public:
+		typedef _demoted_target<_connection_base8<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy> > target_type;
+		
+		_demoted_connection8(_connection_base8<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy> *conn, Executor *worker)
+		: m_target(new target_type(conn)), m_worker(worker) {
+		}
+		
+		~_demoted_connection8() {
+			m_target->release();
+		}
+		
+		virtual _connection_base8<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy>* clone() {
+			return new _demoted_connection8<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy>(static_cast<_connection_base8<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy> *>(m_target->connection()->clone()), m_worker);
+		}
+		
+		virtual _connection_base8<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy>* duplicate(HasSlots<mt_policy>* pnewdest) {
+			return new _demoted_connection8<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy>(static_cast<_connection_base8<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy> *>(m_target->connection()->duplicate(pnewdest)), m_worker);
+		}
+		
+		virtual void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6, arg7_type a7, arg8_type a8) {
+			m_worker->post(new _demoted_call8<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy>(m_target, a1, a2, a3, a4, a5, a6, a7, a8));
+		}
+		
+		// Already demoted.
+		virtual _connection_base<mt_policy> *demote(Executor *) {
+			return NULL;
+		}
+		
+		virtual HasSlots<mt_policy>* getdest() const {
+			return m_target->connection()->getdest();
+		}
+		
+		virtual std::size_t size() const {
+			return sizeof(*this) + sizeof(target_type) + m_target->connection()->size();
+		}
+		
+		virtual std::size_t method(const void *&bytes) const {
+			return m_target->connection()->method(bytes);
+		}
+		
+		virtual const void *stub() const {
+			return m_target->connection()->stub();
+		}
+		
+	private:
+		target_type *m_target;
+		Executor *m_worker;
+	};
+	
+	template<class mt_policy = SIGLY_DEFAULT_MT_POLICY>
+	class Signal0 : public _signal_base<mt_policy> {
+	public:
+		typedef typename _signal_base<mt_policy>::connections_list connections_list;
+		typedef typename _signal_base<mt_policy>::const_iterator const_iterator;
+		typedef _connection_base0<mt_policy> connection_type;
+		
+		using _signal_base<mt_policy>::disconnect;
+		
+		Signal0() {
+			;
+		}
+		
+		Signal0(const Signal0<mt_policy>& s)
+		: _signal_base<mt_policy>(s) {
+			;
+		}
+		
+		template<class desttype>
+		void connect(desttype *pclass, void (desttype::*pmemfun)()) {
+			_connection0<desttype, mt_policy>* conn =
+			new _connection0<desttype, mt_policy>(pclass, pmemfun);
+			this->attach(conn);
+		}
+		
+		// Connects the slot so that it runs on the receiver's event loop, see
+		// ConnectionMode. The key, if any, is the coalescing key of the calls
+		// posted, see COALESCE; calls with the same key and receiver replace
+		// each other whichever connection posted them.
+		template<class desttype>
+		void connect(desttype *pclass, void (desttype::*pmemfun)(), ConnectionMode mode, const void *key = NULL) {
+			if (mode == DIRECT_CONNECTION) {
+				connect(pclass, pmemfun);
+			} else {
+				this->attach(new _queued_connection0<desttype, mt_policy>(pclass, pmemfun, mode, key));
+			}
+		}
+		
+		// Connects the slot unless it is connected to this receiver already,
+		// in any mode. Returns whether a connection was made.
+		template<class desttype>
+		bool connectUnique(desttype *pclass, void (desttype::*pmemfun)(), ConnectionMode mode = DIRECT_CONNECTION, const void *key = NULL) {
+			if (mode == DIRECT_CONNECTION) {
+				return this->attachUnique(new _connection0<desttype, mt_policy>(pclass, pmemfun));
+			}
+			
+			return this->attachUnique(new _queued_connection0<desttype, mt_policy>(pclass, pmemfun, mode, key));
+		}
+		
+		// Disconnects one slot of the receiver, leaving its other slots
+		// connected. Returns whether the slot was connected.
+		template<class desttype>
+		bool disconnect(desttype *pclass, void (desttype::*pmemfun)()) {
+			return this->detach(pclass, &pmemfun, sizeof(pmemfun));
+		}
+		
+		void shoot() {
+			if (_atomic_load(&this->m_trampolined) != 0) {
+				_trampoline trampoline;
+				
+				if (!trampoline.outermost()) {
+					trampoline.defer(new _deferred_emission0<Signal0>(this), &this->m_pins);
+					return;
+				}
+				
+				dispatch();
+				trampoline.drain();
+				return;
+			}
+			
+			dispatch();
+		}
+		
+		void operator()() {
+			shoot();
+		}
+		
+	private:
+		friend class _deferred_emission0<Signal0>;
+		
+		void dispatch() {
+			_latency_budget<mt_policy> *budget = this->latencyBudget();
+			
+			{
+				_emission<mt_policy, connections_list> emission(this, this->m_connected_slots);
+				
+				while (typename connections_list::value_type conn = emission.next()) {
+					_slot_clock<mt_policy> timer(budget, this, conn);
+					static_cast<connection_type *>(conn)->shoot();
+					timer.stop();
+				}
+			}
+			
+			this->settle(budget);
+		}
+	};
+	
+	template<class arg1_type, class mt_policy = SIGLY_DEFAULT_MT_POLICY>
+	class Signal1 : public _signal_base<mt_policy> {
+	public:
+		typedef typename _signal_base<mt_policy>::connections_list connections_list;
+		typedef typename _signal_base<mt_policy>::const_iterator const_iterator;
+		typedef _connection_base1<arg1_type, mt_policy> connection_type;
+		
+		using _signal_base<mt_policy>::disconnect;
+		
+		Signal1() {
+			;
+		}
+		
+		Signal1(const Signal1<arg1_type, mt_policy>& s)
+		: _signal_base<mt_policy>(s) {
+			;
+		}
+		
+		template<class desttype>
+		void connect(desttype *pclass, void (desttype::*pmemfun)(arg1_type)) {
+			_connection1<desttype, arg1_type, mt_policy>* conn =
+			new _connection1<desttype, arg1_type, mt_policy>(pclass, pmemfun);
+			this->attach(conn);
+		}
+		
+		// Connects the slot so that it runs on the receiver's event loop, see
+		// ConnectionMode. The key, if any, is the coalescing key of the calls
+		// posted, see COALESCE; calls with the same key and receiver replace
+		// each other whichever connection posted them.
+		template<class desttype>
+		void connect(desttype *pclass, void (desttype::*pmemfun)(arg1_type), ConnectionMode mode, const void *key = NULL) {
+			if (mode == DIRECT_CONNECTION) {
+				connect(pclass, pmemfun);
+			} else {
+				this->attach(new _queued_connection1<desttype, arg1_type, mt_policy>(pclass, pmemfun, mode, key));
+			}
+		}
+		
+		// Connects the slot unless it is connected to this receiver already,
+		// in any mode. Returns whether a connection was made.
+		template<class desttype>
+		bool connectUnique(desttype *pclass, void (desttype::*pmemfun)(arg1_type), ConnectionMode mode = DIRECT_CONNECTION, const void *key = NULL) {
+			if (mode == DIRECT_CONNECTION) {
+				return this->attachUnique(new _connection1<desttype, arg1_type, mt_policy>(pclass, pmemfun));
+			}
+			
+			return this->attachUnique(new _queued_connection1<desttype, arg1_type, mt_policy>(pclass, pmemfun, mode, key));
+		}
+		
+		// Disconnects one slot of the receiver, leaving its other slots
+		// connected. Returns whether the slot was connected.
+		template<class desttype>
+		bool disconnect(desttype *pclass, void (desttype::*pmemfun)(arg1_type)) {
+			return this->detach(pclass, &pmemfun, sizeof(pmemfun));
+		}
+		
+		void shoot(arg1_type a1) {
+			if (_atomic_load(&this->m_trampolined) != 0) {
+				_trampoline trampoline;
+				
+				if (!trampoline.outermost()) {
+					trampoline.defer(new _deferred_emission1<Signal1, arg1_type>(this, a1), &this->m_pins);
+					return;
+				}
+				
+				dispatch(a1);
+				trampoline.drain();
+				return;
+			}
+			
+			dispatch(a1);
+		}
+		
+		void operator()(arg1_type a1) {
+			shoot(a1);
+		}
+		
+	private:
+		friend class _deferred_emission1<Signal1, arg1_type>;
+		
+		void dispatch(arg1_type a1) {
+			_latency_budget<mt_policy> *budget = this->latencyBudget();
+			
+			{
+				_emission<mt_policy, connections_list> emission(this, this->m_connected_slots);
+				
+				while (typename connections_list::value_type conn = emission.next()) {
+					_slot_clock<mt_policy> timer(budget, this, conn);
+					static_cast<connection_type *>(conn)->shoot(a1);
+					timer.stop();
+				}
+			}
+			
+			this->settle(budget);
+		}
+	};
+	
+	template<class arg1_type, typename arg2_type, typename mt_policy = SIGLY_DEFAULT_MT_POLICY>
+	class Signal2 : public _signal_base<mt_policy> {
+	public:
+		typedef typename _signal_base<mt_policy>::connections_list connections_list;
+		typedef typename _signal_base<mt_policy>::const_iterator const_iterator;
+		typedef _connection_base2<arg1_type, arg2_type, mt_policy> connection_type;
+		
+		using _signal_base<mt_policy>::disconnect;
+		
+		Signal2() {
+			;
+		}
+		
+		Signal2(const Signal2<arg1_type, arg2_type, mt_policy>& s)
+		: _signal_base<mt_policy>(s) {
+			;
+		}
+		
+		template<class desttype>
+		void connect(desttype *pclass, void (desttype::*pmemfun)(arg1_type,
+		                                                         arg2_type)) {
+			_connection2<desttype, arg1_type, arg2_type, mt_policy>* conn = new
+			_connection2<desttype, arg1_type, arg2_type, mt_policy>(pclass, pmemfun);
+			this->attach(conn);
+		}
+		
+		// Connects the slot so that it runs on the receiver's event loop, see
+		// ConnectionMode. The key, if any, is the coalescing key of the calls
+		// posted, see COALESCE; calls with the same key and receiver replace
+		// each other whichever connection posted them.
+		template<class desttype>
+		void connect(desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type), ConnectionMode mode, const void *key = NULL) {
+			if (mode == DIRECT_CONNECTION) {
+				connect(pclass, pmemfun);
+			} else {
+				this->attach(new _queued_connection2<desttype, arg1_type, arg2_type, mt_policy>(pclass, pmemfun, mode, key));
+			}
+		}
+		
+		// Connects the slot unless it is connected to this receiver already,
+		// in any mode. Returns whether a connection was made.
+		template<class desttype>
+		bool connectUnique(desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type), ConnectionMode mode = DIRECT_CONNECTION, const void *key = NULL) {
+			if (mode == DIRECT_CONNECTION) {
+				return this->attachUnique(new _connection2<desttype, arg1_type, arg2_type, mt_policy>(pclass, pmemfun));
+			}
+			
+			return this->attachUnique(new _queued_connection2<desttype, arg1_type, arg2_type, mt_policy>(pclass, pmemfun, mode, key));
+		}
+		
+		// Disconnects one slot of the receiver, leaving its other slots
+		// connected. Returns whether the slot was connected.
+		template<class desttype>
+		bool disconnect(desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type)) {
+			return this->detach(pclass, &pmemfun, sizeof(pmemfun));
+		}
+		
+		void shoot(arg1_type a1, arg2_type a2) {
+			if (_atomic_load(&this->m_trampolined) != 0) {
+				_trampoline trampoline;
+				
+				if (!trampoline.outermost()) {
+					trampoline.defer(new _deferred_emission2<Signal2, arg1_type, arg2_type>(this, a1, a2), &this->m_pins);
+					return;
+				}
+				
+				dispatch(a1, a2);
+				trampoline.drain();
+				return;
+			}
+			
+			dispatch(a1, a2);
+		}
+		
+		void operator()(arg1_type a1, arg2_type a2) {
+			shoot(a1,a2);
+		}
+		
+	private:
+		friend class _deferred_emission2<Signal2, arg1_type, arg2_type>;
+		
+		void dispatch(arg1_type a1, arg2_type a2) {
+			_latency_budget<mt_policy> *budget = this->latencyBudget();
+			
+			{
+				_emission<mt_policy, connections_list> emission(this, this->m_connected_slots);
+				
+				while (typename connections_list::value_type conn = emission.next()) {
+					_slot_clock<mt_policy> timer(budget, this, conn);
+					static_cast<connection_type *>(conn)->shoot(a1, a2);
+					timer.stop();
+				}
+			}
+			
+			this->settle(budget);
+		}
+	};
+	
+	template<class arg1_type, typename arg2_type, typename arg3_type, typename mt_policy = SIGLY_DEFAULT_MT_POLICY>
+	class Signal3 : public _signal_base<mt_policy> {
+	public:
+		typedef typename _signal_base<mt_policy>::connections_list connections_list;
+		typedef typename _signal_base<mt_policy>::const_iterator const_iterator;
+		typedef _connection_base3<arg1_type, arg2_type, arg3_type, mt_policy> connection_type;
+		
+		using _signal_base<mt_policy>::disconnect;
+		
+		Signal3() {
+			;
+		}
+		
+		Signal3(const Signal3<arg1_type, arg2_type, arg3_type, mt_policy>& s)
+		: _signal_base<mt_policy>(s) {
+			;
+		}
+		
+		template<class desttype>
+		void connect(desttype *pclass, void (desttype::*pmemfun)(arg1_type,
+		                                                         arg2_type, arg3_type)) {
+			_connection3<desttype, arg1_type, arg2_type, arg3_type, mt_policy>* conn =
+			new _connection3<desttype, arg1_type, arg2_type, arg3_type, mt_policy>(pclass,
+																				   pmemfun);
+			this->attach(conn);
+		}
+		
+		// Connects the slot so that it runs on the receiver's event loop, see
+		// ConnectionMode. The key, if any, is the coalescing key of the calls
+		// posted, see COALESCE; calls with the same key and receiver replace
+		// each other whichever connection posted them.
+		template<class desttype>
+		void connect(desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type, arg3_type), ConnectionMode mode, const void *key = NULL) {
+			if (mode == DIRECT_CONNECTION) {
+				connect(pclass, pmemfun);
+			} else {
+				this->attach(new _queued_connection3<desttype, arg1_type, arg2_type, arg3_type, mt_policy>(pclass, pmemfun, mode, key));
+			}
+		}
+		
+		// Connects the slot unless it is connected to this receiver already,
+		// in any mode. Returns whether a connection was made.
+		template<class desttype>
+		bool connectUnique(desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type, arg3_type), ConnectionMode mode = DIRECT_CONNECTION, const void *key = NULL) {
+			if (mode == DIRECT_CONNECTION) {
+				return this->attachUnique(new _connection3<desttype, arg1_type, arg2_type, arg3_type, mt_policy>(pclass, pmemfun));
+			}
+			
+			return this->attachUnique(new _queued_connection3<desttype, arg1_type, arg2_type, arg3_type, mt_policy>(pclass, pmemfun, mode, key));
+		}
+		
+		// Disconnects one slot of the receiver, leaving its other slots
+		// connected. Returns whether the slot was connected.
+		template<class desttype>
+		bool disconnect(desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type, arg3_type)) {
+			return this->detach(pclass, &pmemfun, sizeof(pmemfun));
+		}
+		
+		void shoot(arg1_type a1, arg2_type a2, arg3_type a3) {
+			if (_atomic_load(&this->m_trampolined) != 0) {
+				_trampoline trampoline;
+				
+				if (!trampoline.outermost()) {
+					trampoline.defer(new _deferred_emission3<Signal3, arg1_type, arg2_type, arg3_type>(this, a1, a2, a3), &this->m_pins);
+					return;
+				}
+				
+				dispatch(a1, a2, a3);
+				trampoline.drain();
+				return;
+			}
+			
+			dispatch(a1, a2, a3);
+		}
+		
+		void operator()(arg1_type a1, arg2_type a2, arg3_type a3) {
+			shoot(a1,a2,a3);
+		}
+		
+	private:
+		friend class _deferred_emission3<Signal3, arg1_type, arg2_type, arg3_type>;
+		
+		void dispatch(arg1_type a1, arg2_type a2, arg3_type a3) {
+			_latency_budget<mt_policy> *budget = this->latencyBudget();
+			
+			{
+				_emission<mt_policy, connections_list> emission(this, this->m_connected_slots);
+				
+				while (typename connections_list::value_type conn = emission.next()) {
+					_slot_clock<mt_policy> timer(budget, this, conn);
+					static_cast<connection_type *>(conn)->shoot(a1, a2, a3);
+					timer.stop();
+				}
+			}
+			
+			this->settle(budget);
+		}
+	};
+	
+	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class mt_policy = SIGLY_DEFAULT_MT_POLICY>
+	class Signal4 : public _signal_base<mt_policy> {
+	public:
+		typedef typename _signal_base<mt_policy>::connections_list connections_list;
+		typedef typename _signal_base<mt_policy>::const_iterator const_iterator;
+		typedef _connection_base4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy> connection_type;
+		
+		using _signal_base<mt_policy>::disconnect;
+		
+		Signal4() {
+			;
+		}
+		
+		Signal4(const Signal4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>& s)
+		: _signal_base<mt_policy>(s) {
+			;
+		}
+		
+		template<class desttype>
+		void connect(desttype *pclass, void (desttype::*pmemfun)(arg1_type,
+		                                                         arg2_type, arg3_type, arg4_type)) {
+			_connection4<desttype, arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>*
+			conn = new _connection4 < desttype, arg1_type, arg2_type, arg3_type,
+			arg4_type, mt_policy > (pclass, pmemfun);
+			this->attach(conn);
+		}
+		
+		// Connects the slot so that it runs on the receiver's event loop, see
+		// ConnectionMode. The key, if any, is the coalescing key of the calls
+		// posted, see COALESCE; calls with the same key and receiver replace
+		// each other whichever connection posted them.
+		template<class desttype>
+		void connect(desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type), ConnectionMode mode, const void *key = NULL) {
+			if (mode == DIRECT_CONNECTION) {
+				connect(pclass, pmemfun);
+			} else {
+				this->attach(new _queued_connection4<desttype, arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>(pclass, pmemfun, mode, key));
+			}
+		}
+		
+		// Connects the slot unless it is connected to this receiver already,
+		// in any mode. Returns whether a connection was made.
+		template<class desttype>
+		bool connectUnique(desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type), ConnectionMode mode = DIRECT_CONNECTION, const void *key = NULL) {
+			if (mode == DIRECT_CONNECTION) {
+				return this->attachUnique(new _connection4<desttype, arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>(pclass, pmemfun));
+			}
+			
+			return this->attachUnique(new _queued_connection4<desttype, arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>(pclass, pmemfun, mode, key));
+		}
+		
+		// Disconnects one slot of the receiver, leaving its other slots
+		// connected. Returns whether the slot was connected.
+		template<class desttype>
+		bool disconnect(desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type)) {
+			return this->detach(pclass, &pmemfun, sizeof(pmemfun));
+		}
+		
+		void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4) {
+			if (_atomic_load(&this->m_trampolined) != 0) {
+				_trampoline trampoline;
+				
+				if (!trampoline.outermost()) {
+					trampoline.defer(new _deferred_emission4<Signal4, arg1_type, arg2_type, arg3_type, arg4_type>(this, a1, a2, a3, a4), &this->m_pins);
+					return;
+				}
+				
+				dispatch(a1, a2, a3, a4);
+				trampoline.drain();
+				return;
+			}
+			
+			dispatch(a1, a2, a3, a4);
+		}
+		
+		void operator()(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4) {
+			shoot(a1,a2,a3,a4);
+		}
+		
+	private:
+		friend class _deferred_emission4<Signal4, arg1_type, arg2_type, arg3_type, arg4_type>;
+		
+		void dispatch(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4) {
+			_latency_budget<mt_policy> *budget = this->latencyBudget();
+			
+			{
+				_emission<mt_policy, connections_list> emission(this, this->m_connected_slots);
+				
+				while (typename connections_list::value_type conn = emission.next()) {
+					_slot_clock<mt_policy> timer(budget, this, conn);
+					static_cast<connection_type *>(conn)->shoot(a1, a2, a3, a4);
+					timer.stop();
+				}
+			}
+			
+			this->settle(budget);
+		}
+	};
+	
+	template < class arg1_type, class arg2_type, class arg3_type, class arg4_type,
+	class arg5_type, class mt_policy = SIGLY_DEFAULT_MT_POLICY >
+	class Signal5 : public _signal_base<mt_policy> {
+	public:
+		typedef typename _signal_base<mt_policy>::connections_list connections_list;
+		typedef typename _signal_base<mt_policy>::const_iterator const_iterator;
+		typedef _connection_base5<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy> connection_type;
+		
+		using _signal_base<mt_policy>::disconnect;
+		
+		Signal5() {
+			;
+		}
+		
+		Signal5(const Signal5 < arg1_type, arg2_type, arg3_type, arg4_type,
+		        arg5_type, mt_policy > & s)
+		: _signal_base<mt_policy>(s) {
+			;
+		}
+		
+		template<class desttype>
+		void connect(desttype *pclass, void (desttype::*pmemfun)(arg1_type,
+		                                                         arg2_type, arg3_type, arg4_type, arg5_type)) {
+			_connection5 < desttype, arg1_type, arg2_type, arg3_type, arg4_type,
+			arg5_type, mt_policy > * conn = new _connection5 < desttype, arg1_type, arg2_type,
+			arg3_type, arg4_type, arg5_type, mt_policy > (pclass, pmemfun);
+			this->attach(conn);
+		}
+		
+		// Connects the slot so that it runs on the receiver's event loop, see
+		// ConnectionMode. The key, if any, is the coalescing key of the calls
+		// posted, see COALESCE; calls with the same key and receiver replace
+		// each other whichever connection posted them.
+		template<class desttype>
+		void connect(desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type), ConnectionMode mode, const void *key = NULL) {
+			if (mode == DIRECT_CONNECTION) {
+				connect(pclass, pmemfun);
+			} else {
+				this->attach(new _queued_connection5<desttype, arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy>(pclass, pmemfun, mode, key));
+			}
+		}
+		
+		// Connects the slot unless it is connected to this receiver already,
+		// in any mode. Returns whether a connection was made.
+		template<class desttype>
+		bool connectUnique(desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type), ConnectionMode mode = DIRECT_CONNECTION, const void *key = NULL) {
+			if (mode == DIRECT_CONNECTION) {
+				return this->attachUnique(new _connection5<desttype, arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy>(pclass, pmemfun));
+			}
+			
+			return this->attachUnique(new _queued_connection5<desttype, arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy>(pclass, pmemfun, mode, key));
+		}
+		
+		// Disconnects one slot of the receiver, leaving its other slots
+		// connected. Returns whether the slot was connected.
+		template<class desttype>
+		bool disconnect(desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type)) {
+			return this->detach(pclass, &pmemfun, sizeof(pmemfun));
+		}
+		
+		void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4,
+		           arg5_type a5) {
+			if (_atomic_load(&this->m_trampolined) != 0) {
+				_trampoline trampoline;
+				
+				if (!trampoline.outermost()) {
+					trampoline.defer(new _deferred_emission5<Signal5, arg1_type, arg2_type, arg3_type, arg4_type, arg5_type>(this, a1, a2, a3, a4, a5), &this->m_pins);
+					return;
+				}
+				
+				dispatch(a1, a2, a3, a4, a5);
+				trampoline.drain();
+				return;
+			}
+			
+			dispatch(a1, a2, a3, a4, a5);
+		}
+		
+		void operator()(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4,
+		                arg5_type a5) {
+			shoot(a1,a2,a3,a4,a5);
+		}
+		
+	private:
+		friend class _deferred_emission5<Signal5, arg1_type, arg2_type, arg3_type, arg4_type, arg5_type>;
+		
+		void dispatch(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4,
+		              arg5_type a5) {
+			_latency_budget<mt_policy> *budget = this->latencyBudget();
+			
+			{
+				_emission<mt_policy, connections_list> emission(this, this->m_connected_slots);
+				
+				while (typename connections_list::value_type conn = emission.next()) {
+					_slot_clock<mt_policy> timer(budget, this, conn);
+					static_cast<connection_type *>(conn)->shoot(a1, a2, a3, a4, a5);
+					timer.stop();
+				}
+			}
+			
+			this->settle(budget);
+		}
+	};
+	
+	
+	template < class arg1_type, class arg2_type, class arg3_type, class arg4_type,
+	class arg5_type, class arg6_type, class mt_policy = SIGLY_DEFAULT_MT_POLICY >
+	class Signal6 : public _signal_base<mt_policy> {
+	public:
+		typedef typename _signal_base<mt_policy>::connections_list connections_list;
+		typedef typename _signal_base<mt_policy>::const_iterator const_iterator;
+		typedef _connection_base6<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy> connection_type;
+		
+		using _signal_base<mt_policy>::disconnect;
+		
+		Signal6() {
+			;
+		}
+		
+		Signal6(const Signal6 < arg1_type, arg2_type, arg3_type, arg4_type,
+		        arg5_type, arg6_type, mt_policy > & s)
+		: _signal_base<mt_policy>(s) {
+			;
+		}
+		
+		template<class desttype>
+		void connect(desttype *pclass, void (desttype::*pmemfun)(arg1_type,
+		                                                         arg2_type, arg3_type, arg4_type, arg5_type, arg6_type)) {
+			_connection6 < desttype, arg1_type, arg2_type, arg3_type, arg4_type,
+			arg5_type, arg6_type, mt_policy > * conn =
+			new _connection6 < desttype, arg1_type, arg2_type, arg3_type,
+			arg4_type, arg5_type, arg6_type, mt_policy > (pclass, pmemfun);
+			this->attach(conn);
+		}
+		
+		// Connects the slot so that it runs on the receiver's event loop, see
+		// ConnectionMode. The key, if any, is the coalescing key of the calls
+		// posted, see COALESCE; calls with the same key and receiver replace
+		// each other whichever connection posted them.
+		template<class desttype>
+		void connect(desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type), ConnectionMode mode, const void *key = NULL) {
+			if (mode == DIRECT_CONNECTION) {
+				connect(pclass, pmemfun);
+			} else {
+				this->attach(new _queued_connection6<desttype, arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy>(pclass, pmemfun, mode, key));
+			}
+		}
+		
+		// Connects the slot unless it is connected to this receiver already,
+		// in any mode. Returns whether a connection was made.
+		template<class desttype>
+		bool connectUnique(desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type), ConnectionMode mode = DIRECT_CONNECTION, const void *key = NULL) {
+			if (mode == DIRECT_CONNECTION) {
+				return this->attachUnique(new _connection6<desttype, arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy>(pclass, pmemfun));
+			}
+			
+			return this->attachUnique(new _queued_connection6<desttype, arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy>(pclass, pmemfun, mode, key));
+		}
+		
+		// Disconnects one slot of the receiver, leaving its other slots
+		// connected. Returns whether the slot was connected.
+		template<class desttype>
+		bool disconnect(desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type)) {
+			return this->detach(pclass, &pmemfun, sizeof(pmemfun));
+		}
+		
+		void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4,
+		           arg5_type a5, arg6_type a6) {
+			if (_atomic_load(&this->m_trampolined) != 0) {
+				_trampoline trampoline;
+				
+				if (!trampoline.outermost()) {
+					trampoline.defer(new _deferred_emission6<Signal6, arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type>(this, a1, a2, a3, a4, a5, a6), &this->m_pins);
+					return;
+				}
+				
+				dispatch(a1, a2, a3, a4, a5, a6);
+				trampoline.drain();
+				return;
+			}
+			
+			dispatch(a1, a2, a3, a4, a5, a6);
+		}
+		
+		void operator()(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4,
+		                arg5_type a5, arg6_type a6) {
+				shoot(a1,a2,a3,a4,a5,a6);
+
+		}
+		
+	private:
+		friend class _deferred_emission6<Signal6, arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type>;
+		
+		void dispatch(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4,
+		              arg5_type a5, arg6_type a6) {
+			_latency_budget<mt_policy> *budget = this->latencyBudget();
+			
+			{
+				_emission<mt_policy, connections_list> emission(this, this->m_connected_slots);
+				
+				while (typename connections_list::value_type conn = emission.next()) {
+					_slot_clock<mt_policy> timer(budget, this, conn);
+					static_cast<connection_type *>(conn)->shoot(a1, a2, a3, a4, a5, a6);
+					timer.stop();
+				}
+			}
+			
+			this->settle(budget);
+		}
+	};
+	
+	template < class arg1_type, class arg2_type, class arg3_type, class arg4_type,
+	class arg5_type, class arg6_type, class arg7_type, class mt_policy = SIGLY_DEFAULT_MT_POLICY >
+	class Signal7 : public _signal_base<mt_policy> {
+	public:
+		typedef typename _signal_base<mt_policy>::connections_list connections_list;
+		typedef typename _signal_base<mt_policy>::const_iterator const_iterator;
+		typedef _connection_base7<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy> connection_type;
+		
+		using _signal_base<mt_policy>::disconnect;
+		
+		Signal7() {
+			;
+		}
+		
+		Signal7(const Signal7 < arg1_type, arg2_type, arg3_type, arg4_type,
+		        arg5_type, arg6_type, arg7_type, mt_policy > & s)
+		: _signal_base<mt_policy>(s) {
+			;
+		}
+		
+		template<class desttype>
+		void connect(desttype *pclass, void (desttype::*pmemfun)(arg1_type,
+		                                                         arg2_type, arg3_type, arg4_type, arg5_type, arg6_type,
+		                                                         arg7_type)) {
+			_connection7 < desttype, arg1_type, arg2_type, arg3_type, arg4_type,
+			arg5_type, arg6_type, arg7_type, mt_policy > * conn =
+			new _connection7 < desttype, arg1_type, arg2_type, arg3_type,
+			arg4_type, arg5_type, arg6_type, arg7_type, mt_policy > (pclass, pmemfun);
+			this->attach(conn);
+		}
+		
+		// Connects the slot so that it runs on the receiver's event loop, see
+		// ConnectionMode. The key, if any, is the coalescing key of the calls
+		// posted, see COALESCE; calls with the same key and receiver replace
+		// each other whichever connection posted them.
+		template<class desttype>
+		void connect(desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type), ConnectionMode mode, const void *key = NULL) {
+			if (mode == DIRECT_CONNECTION) {
+				connect(pclass, pmemfun);
+			} else {
+				this->attach(new _queued_connection7<desttype, arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy>(pclass, pmemfun, mode, key));
+			}
+		}
+		
+		// Connects the slot unless it is connected to this receiver already,
+		// in any mode. Returns whether a connection was made.
+		template<class desttype>
+		bool connectUnique(desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type), ConnectionMode mode = DIRECT_CONNECTION, const void *key = NULL) {
+			if (mode == DIRECT_CONNECTION) {
+				return this->attachUnique(new _connection7<desttype, arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy>(pclass, pmemfun));
+			}
+			
+			return this->attachUnique(new _queued_connection7<desttype, arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy>(pclass, pmemfun, mode, key));
+		}
+		
+		// Disconnects one slot of the receiver, leaving its other slots
+		// connected. Returns whether the slot was connected.
+		template<class desttype>
+		bool disconnect(desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type)) {
+			return this->detach(pclass, &pmemfun, sizeof(pmemfun));
+		}
+		
+		void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4,
+		           arg5_type a5, arg6_type a6, arg7_type a7) {
+			if (_atomic_load(&this->m_trampolined) != 0) {
+				_trampoline trampoline;
+				
+				if (!trampoline.outermost()) {
+					trampoline.defer(new _deferred_emission7<Signal7, arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type>(this, a1, a2, a3, a4, a5, a6, a7), &this->m_pins);
+					return;
+				}
+				
+				dispatch(a1, a2, a3, a4, a5, a6, a7);
+				trampoline.drain();
+				return;
+			}
+			
+			dispatch(a1, a2, a3, a4, a5, a6, a7);
+		}
+		
+		void operator()(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4,
+		                arg5_type a5, arg6_type a6, arg7_type a7) {
+				shoot(a1,a2,a3,a4,a5,a6,a7);
+
+		}
+		
+	private:
+		friend class _deferred_emission7<Signal7, arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type>;
+		
+		void dispatch(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4,
+		              arg5_type a5, arg6_type a6, arg7_type a7) {
+			_latency_budget<mt_policy> *budget = this->latencyBudget();
+			
+			{
+				_emission<mt_policy, connections_list> emission(this, this->m_connected_slots);
+				
+				while (typename connections_list::value_type conn = emission.next()) {
+					_slot_clock<mt_policy> timer(budget, this, conn);
+					static_cast<connection_type *>(conn)->shoot(a1, a2, a3, a4, a5, a6, a7);
+					timer.stop();
+				}
+			}
+			
+			this->settle(budget);
+		}
+	};
+	
+	template < class arg1_type, class arg2_type, class arg3_type, class arg4_type,
+	class arg5_type, class arg6_type, class arg7_type, class arg8_type, class mt_policy = SIGLY_DEFAULT_MT_POLICY >
+	class Signal8 : public _signal_base<mt_policy> {
+	public:
+		typedef typename _signal_base<mt_policy>::connections_list connections_list;
+		typedef typename _signal_base<mt_policy>::const_iterator const_iterator;
+		typedef _connection_base8<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy> connection_type;
+		
+		using _signal_base<mt_policy>::disconnect;
+		
+		Signal8() {
+			;
+		}
+		
+		Signal8(const Signal8 < arg1_type, arg2_type, arg3_type, arg4_type,
+		        arg5_type, arg6_type, arg7_type, arg8_type, mt_policy > & s)
+		: _signal_base<mt_policy>(s) {
+			;
+		}
+		
+		template<class desttype>
+		void connect(desttype *pclass, void (desttype::*pmemfun)(arg1_type,
+		                                                         arg2_type, arg3_type, arg4_type, arg5_type, arg6_type,
+		                                                         arg7_type, arg8_type)) {
+			_connection8 < desttype, arg1_type, arg2_type, arg3_type, arg4_type,
+			arg5_type, arg6_type, arg7_type, arg8_type, mt_policy > * conn =
+			new _connection8 < desttype, arg1_type, arg2_type, arg3_type,
+			arg4_type, arg5_type, arg6_type, arg7_type,
+			arg8_type, mt_policy > (pclass, pmemfun);
+			this->attach(conn);
+		}
+		
+		// Connects the slot so that it runs on the receiver's event loop, see
+		// ConnectionMode. The key, if any, is the coalescing key of the calls
+		// posted, see COALESCE; calls with the same key and receiver replace
+		// each other whichever connection posted them.
+		template<class desttype>
+		void connect(desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type), ConnectionMode mode, const void *key = NULL) {
+			if (mode == DIRECT_CONNECTION) {
+				connect(pclass, pmemfun);
+			} else {
+				this->attach(new _queued_connection8<desttype, arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy>(pclass, pmemfun, mode, key));
+			}
+		}
+		
+		// Connects the slot unless it is connected to this receiver already,
+		// in any mode. Returns whether a connection was made.
+		template<class desttype>
+		bool connectUnique(desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type), ConnectionMode mode = DIRECT_CONNECTION, const void *key = NULL) {
+			if (mode == DIRECT_CONNECTION) {
+				return this->attachUnique(new _connection8<desttype, arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy>(pclass, pmemfun));
+			}
+			
+			return this->attachUnique(new _queued_connection8<desttype, arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy>(pclass, pmemfun, mode, key));
+		}
+		
+		// Disconnects one slot of the receiver, leaving its other slots
+		// connected. Returns whether the slot was connected.
+		template<class desttype>
+		bool disconnect(desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type)) {
+			return this->detach(pclass, &pmemfun, sizeof(pmemfun));
+		}
+		
+		void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4,
+		           arg5_type a5, arg6_type a6, arg7_type a7, arg8_type a8) {
+			if (_atomic_load(&this->m_trampolined) != 0) {
+				_trampoline trampoline;
+				
+				if (!trampoline.outermost()) {
+					trampoline.defer(new _deferred_emission8<Signal8, arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type>(this, a1, a2, a3, a4, a5, a6, a7, a8), &this->m_pins);
+					return;
+				}
+				
+				dispatch(a1, a2, a3, a4, a5, a6, a7, a8);
+				trampoline.drain();
+				return;
+			}
+			
+			dispatch(a1, a2, a3, a4, a5, a6, a7, a8);
+		}
+		
+		void operator()(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4,
+		                arg5_type a5, arg6_type a6, arg7_type a7, arg8_type a8) {
+				shoot(a1,a2,a3,a4,a5,a6,a7,a8);
+
+		}
+		
+	private:
+		friend class _deferred_emission8<Signal8, arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type>;
+		
+		void dispatch(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4,
+		              arg5_type a5, arg6_type a6, arg7_type a7, arg8_type a8) {
+			_latency_budget<mt_policy> *budget = this->latencyBudget();
+			
+			{
+				_emission<mt_policy, connections_list> emission(this, this->m_connected_slots);
+				
+				while (typename connections_list::value_type conn = emission.next()) {
+					_slot_clock<mt_policy> timer(budget, this, conn);
+					static_cast<connection_type *>(conn)->shoot(a1, a2, a3, a4, a5, a6, a7, a8);
+					timer.stop();
+				}
+			}
+			
+			this->settle(budget);
+		}
+	};
+	
+#ifndef _SIGLY_SINGLE_THREADED
+	// Time a slot may take on the emitting thread, for the signals given
+	// this budget with setLatencyBudget(). A connection whose slot overruns
+	// it the given number of times in a row is demoted: from the end of the emission,
+	// its calls are posted to the worker pool with copies of their arguments,
+	// and demoted(signal, receiver) is emitted on the emitting thread. The
+	// budget must outlive the signals it is given to.
+	template<class mt_policy = SIGLY_DEFAULT_MT_POLICY>
+	class LatencyBudget : public _latency_budget<mt_policy> {
+	public:
+		LatencyBudget(double microseconds, unsigned long strikes, ThreadPool *worker)
+		: _latency_budget<mt_policy>(microseconds, strikes, worker) {
+		}
+		
+		Signal2<_signal_base<mt_policy> *, HasSlots<mt_policy> *, mt_policy> demoted;
+		
+	private:
+		virtual void report(_signal_base<mt_policy> *signal, HasSlots<mt_policy> *receiver) {
+			demoted(signal, receiver);
+		}
+	};
+#endif // _SIGLY_SINGLE_THREADED
+	
+	// Routes emissions by the value of their first argument. Each key and each
+	// key range gets its own inner signal, so shoot() only visits the slots
+	// connected to that key, to a range containing it, or to every key
+	// (connectAll). Finding the key costs O(log K). The ranges are kept as an
+	// interval tree, so finding the M ranges containing the key costs
+	// O(log R + M); connecting a new range costs O(R). Receivers disconnect
+	// from the inner signals directly; compact() frees the ones left without
+	// connections.
+	template<class signal_type, class key_type, class mt_policy>
+	class _keyed_signal_base : public mt_policy {
+	protected:
+		typedef std::map<key_type, signal_type *> exact_map;
+		typedef typename exact_map::const_iterator exact_iterator;
+		
+		// A range subscription, first and last included. maxLast is the
+		// greatest last key of the ranges below this one in the tree.
+		struct range_entry {
+			range_entry(const key_type &first, const key_type &last): first(first), last(last), maxLast(last), signal(NULL) {
+			}
+			
+			key_type first;
+			key_type last;
+			key_type maxLast;
+			signal_type *signal;
+		};
+		
+		// Sorted by first then last key, and read as an implicit balanced
+		// tree: the entry in the middle of a span is the root of that span.
+		typedef std::vector<range_entry> range_list;
+		
+		// Walks the tree in order, skipping the subtrees that end before the
+		// key and stopping at the first range that starts after it.
+		class range_cursor {
+		public:
+			range_cursor(const range_list &ranges, const key_type &key): m_ranges(ranges), m_key(key), m_depth(0) {
+				descend(0, ranges.size());
+			}
+			
+			// The next range containing the key, or NULL.
+			signal_type *next() {
+				while (m_depth > 0) {
+					--m_depth;
+					std::size_t mid = m_mid[m_depth];
+					std::size_t end = m_end[m_depth];
+					
+					if (mid >= m_ranges.size() || m_key < m_ranges[mid].first) {
+						m_depth = 0;
+						break;
+					}
+					
+					descend(mid + 1, end);
+					
+					if (!(m_ranges[mid].last < m_key)) {
+						return m_ranges[mid].signal;
+					}
+				}
+				
+				return NULL;
+			}
+			
+		private:
+			// Pushes the left spine of the span.
+			void descend(std::size_t begin, std::size_t end) {
+				while (begin < end && end <= m_ranges.size()) {
+					std::size_t mid = begin + (end - begin) / 2;
+					
+					if (m_ranges[mid].maxLast < m_key) {
+						return;
+					}
+					
+					m_mid[m_depth] = mid;
+					m_end[m_depth] = end;
+					++m_depth;
+					end = mid;
+				}
+			}
+			
+			enum {
+				DEPTH = sizeof(std::size_t) * 8
+			};
+			
+			const range_list &m_ranges;
+			const key_type &m_key;
+			std::size_t m_depth;
+			std::size_t m_mid[DEPTH];
+			std::size_t m_end[DEPTH];
+		};
+		
+	public:
+		// The signals a key is shot to, besides the wildcard one, collected
+		// with the keyed signal locked. The keyed signal is unlocked for the
+		// shoots, so that their slots may connect and disconnect, and counts
+		// the emission meanwhile: the signals it prunes are kept until the
+		// last emission ends.
+		class emission {
+		public:
+			emission(_keyed_signal_base *keyed, const key_type &key)
+			: m_keyed(keyed), m_signals(m_local), m_count(0), m_capacity(LOCAL) {
+				shared_lock_block<mt_policy> lock(keyed);
+				_atomic_increment(&keyed->m_emitting);
+				
+				try {
+					signal_type *exact = keyed->find(key);
+					
+					if (exact != NULL) {
+						add(exact);
+					}
+					
+					for (range_cursor cursor(keyed->m_ranges, key); signal_type *range = cursor.next();) {
+						add(range);
+					}
+				} catch (...) {
+					if (m_signals != m_local) {
+						delete [] m_signals;
+					}
+					
+					_atomic_decrement(&keyed->m_emitting);
+					throw;
+				}
+			}
+			
+			~emission() {
+				if (m_signals != m_local) {
+					delete [] m_signals;
+				}
+				
+				m_keyed->leave();
+			}
+			
+			std::size_t size() const {
+				return m_count;
+			}
+			
+			signal_type *operator[](std::size_t i) const {
+				return m_signals[i];
+			}
+			
+		private:
+			emission(const emission &);
+			emission &operator=(const emission &);
+			
+			void add(signal_type *signal) {
+				if (m_count == m_capacity) {
+					signal_type **grown = new signal_type *[m_capacity * 2];
+					std::copy(m_signals, m_signals + m_count, grown);
+					
+					if (m_signals != m_local) {
+						delete [] m_signals;
+					}
+					
+					m_signals = grown;
+					m_capacity *= 2;
+				}
+				
+				m_signals[m_count++] = signal;
+			}
+			
+			enum {
+				LOCAL = 8
+			};
+			
+			_keyed_signal_base *m_keyed;
+			signal_type *m_local[LOCAL];
+			signal_type **m_signals;
+			std::size_t m_count;
+			std::size_t m_capacity;
+		};
+		
+		_keyed_signal_base(): m_emitting(0) {
+			;
+		}
+		
+		_keyed_signal_base(const _keyed_signal_base &s)
+		: mt_policy(s), m_ranges(s.m_ranges), m_wildcard(s.m_wildcard), m_emitting(0) {
+			for (exact_iterator it = s.m_exact.begin(); it != s.m_exact.end(); ++it) {
+				m_exact.insert(std::make_pair(it->first, new signal_type(*it->second)));
+			}
+			
+			for (std::size_t i = 0; i < m_ranges.size(); ++i) {
+				m_ranges[i].signal = new signal_type(*s.m_ranges[i].signal);
+			}
+		}
+		
+		~_keyed_signal_base() {
+			disconnectAll();
+			
+			for (std::size_t i = 0; i < m_pruned.size(); ++i) {
+				delete m_pruned[i];
+			}
+		}
+		
+		void disconnectAll() {
+			lock_block<mt_policy> lock(this);
+			reserve(m_exact.size() + m_ranges.size());
+			
+			for (exact_iterator it = m_exact.begin(); it != m_exact.end(); ++it) {
+				discard(it->second);
+			}
+			
+			for (std::size_t i = 0; i < m_ranges.size(); ++i) {
+				discard(m_ranges[i].signal);
+			}
+			
+			m_exact.clear();
+			m_ranges.clear();
+			m_wildcard.disconnectAll();
+		}
+		
+		void disconnect(HasSlots<mt_policy>* pclass) {
+			lock_block<mt_policy> lock(this);
+			
+			for (exact_iterator it = m_exact.begin(); it != m_exact.end(); ++it) {
+				it->second->disconnect(pclass);
+			}
+			
+			for (std::size_t i = 0; i < m_ranges.size(); ++i) {
+				m_ranges[i].signal->disconnect(pclass);
+			}
+			
+			m_wildcard.disconnect(pclass);
+			prune();
+		}
+		
+		void compact() {
+			lock_block<mt_policy> lock(this);
+			prune();
+		}
+		
+	protected:
+		signal_type *find(const key_type &key) const {
+			exact_iterator it = m_exact.find(key);
+			return it != m_exact.end() ? it->second : NULL;
+		}
+		
+		signal_type *exact(const key_type &key) {
+			typename exact_map::iterator it = m_exact.lower_bound(key);
+			
+			if (it == m_exact.end() || key < it->first) {
+				it = m_exact.insert(it, std::make_pair(key, new signal_type()));
+			}
+			
+			return it->second;
+		}
+		
+		signal_type *range(const key_type &first, const key_type &last) {
+			range_entry entry(first, last);
+			typename range_list::iterator it = std::lower_bound(m_ranges.begin(), m_ranges.end(), entry, &_keyed_signal_base::before);
+			
+			if (it != m_ranges.end() && !before(entry, *it)) {
+				return it->signal;
+			}
+			
+			it = m_ranges.insert(it, entry);
+			
+			try {
+				it->signal = new signal_type();
+			} catch (...) {
+				m_ranges.erase(it);
+				throw;
+			}
+			
+			index(0, m_ranges.size());
+			return it->signal;
+		}
+		
+		exact_map m_exact;
+		range_list m_ranges;
+		signal_type m_wildcard;
+		
+	private:
+		friend class emission;
+		
+		// Ends an emission; the last one out deletes the signals pruned
+		// meanwhile. The count can only rise again with the keyed signal
+		// locked, so it is checked again under the lock.
+		void leave() {
+			if (_atomic_decrement(&m_emitting) == 0) {
+				lock_block<mt_policy> lock(this);
+				
+				if (_atomic_load(&m_emitting) == 0) {
+					for (std::size_t i = 0; i < m_pruned.size(); ++i) {
+						delete m_pruned[i];
+					}
+					
+					m_pruned.clear();
+				}
+			}
+		}
+		
+		// Makes room for keeping count more pruned signals, should an
+		// emission run, before any of them is removed.
+		void reserve(std::size_t count) {
+			if (_atomic_load(&m_emitting) != 0) {
+				m_pruned.reserve(m_pruned.size() + count);
+			}
+		}
+		
+		// Deletes the removed signal, unless an emission may be shooting it.
+		void discard(signal_type *signal) {
+			if (_atomic_load(&m_emitting) != 0) {
+				m_pruned.push_back(signal);
+			} else {
+				delete signal;
+			}
+		}
+		
+		static bool before(const range_entry &a, const range_entry &b) {
+			return a.first < b.first || (!(b.first < a.first) && a.last < b.last);
+		}
+		
+		// Computes maxLast over the span and returns the entry holding it.
+		const range_entry *index(std::size_t begin, std::size_t end) {
+			if (begin >= end) {
+				return NULL;
+			}
+			
+			std::size_t mid = begin + (end - begin) / 2;
+			range_entry &root = m_ranges[mid];
+			root.maxLast = root.last;
+			const range_entry *left = index(begin, mid);
+			const range_entry *right = index(mid + 1, end);
+			
+			if (left != NULL && root.maxLast < left->maxLast) {
+				root.maxLast = left->maxLast;
+			}
+			
+			if (right != NULL && root.maxLast < right->maxLast) {
+				root.maxLast = right->maxLast;
+			}
+			
+			return &root;
+		}
+		
+		void prune() {
+			reserve(m_exact.size() + m_ranges.size());
+			
+			for (typename exact_map::iterator it = m_exact.begin(); it != m_exact.end();) {
+				if (it->second->empty()) {
+					discard(it->second);
+					m_exact.erase(it++);
+				} else {
+					++it;
+				}
+			}
+			
+			std::size_t kept = 0;
+			
+			for (std::size_t i = 0; i < m_ranges.size(); ++i) {
+				if (m_ranges[i].signal->empty()) {
+					discard(m_ranges[i].signal);
+				} else {
+					m_ranges[kept++] = m_ranges[i];
+				}
+			}
+			
+			if (kept != m_ranges.size()) {
+				m_ranges.erase(m_ranges.begin() + kept, m_ranges.end());
+				index(0, m_ranges.size());
+			}
+		}
+		
+		std::vector<signal_type *> m_pruned;
+		volatile long m_emitting;
+	};
+	
+	template<class arg1_type, class mt_policy = SIGLY_DEFAULT_MT_POLICY>
+	class KeyedSignal1 : public _keyed_signal_base<Signal1<arg1_type, mt_policy>, typename _value_type<arg1_type>::type, mt_policy> {
+	public:
+		typedef typename _value_type<arg1_type>::type key_type;
+		typedef Signal1<arg1_type, mt_policy> signal_type;
+		typedef typename _keyed_signal_base<signal_type, key_type, mt_policy>::emission emission;
+		
+		template<class desttype>
+		void connect(const key_type &key, desttype *pclass, void (desttype::*pmemfun)(arg1_type)) {
+			lock_block<mt_policy> lock(this);
+			this->exact(key)->connect(pclass, pmemfun);
+		}
+		
+		template<class desttype>
+		void connect(const key_type &first, const key_type &last, desttype *pclass, void (desttype::*pmemfun)(arg1_type)) {
+			lock_block<mt_policy> lock(this);
+			this->range(first, last)->connect(pclass, pmemfun);
+		}
+		
+		template<class desttype>
+		void connectAll(desttype *pclass, void (desttype::*pmemfun)(arg1_type)) {
+			lock_block<mt_policy> lock(this);
+			this->m_wildcard.connect(pclass, pmemfun);
+		}
+		
+		void shoot(arg1_type a1) {
+			emission signals(this, a1);
+			
+			for (std::size_t i = 0; i < signals.size(); ++i) {
+				signals[i]->shoot(a1);
+			}
+			
+			this->m_wildcard.shoot(a1);
+		}
+		
+		void operator()(arg1_type a1) {
+			shoot(a1);
+		}
+	};
+	
+	template<class arg1_type, class arg2_type, class mt_policy = SIGLY_DEFAULT_MT_POLICY>
+	class KeyedSignal2 : public _keyed_signal_base<Signal2<arg1_type, arg2_type, mt_policy>, typename _value_type<arg1_type>::type, mt_policy> {
+	public:
+		typedef typename _value_type<arg1_type>::type key_type;
+		typedef Signal2<arg1_type, arg2_type, mt_policy> signal_type;
+		typedef typename _keyed_signal_base<signal_type, key_type, mt_policy>::emission emission;
+		
+		template<class desttype>
+		void connect(const key_type &key, desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type)) {
+			lock_block<mt_policy> lock(this);
+			this->exact(key)->connect(pclass, pmemfun);
+		}
+		
+		template<class desttype>
+		void connect(const key_type &first, const key_type &last, desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type)) {
+			lock_block<mt_policy> lock(this);
+			this->range(first, last)->connect(pclass, pmemfun);
+		}
+		
+		template<class desttype>
+		void connectAll(desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type)) {
+			lock_block<mt_policy> lock(this);
+			this->m_wildcard.connect(pclass, pmemfun);
+		}
+		
+		void shoot(arg1_type a1, arg2_type a2) {
+			emission signals(this, a1);
+			
+			for (std::size_t i = 0; i < signals.size(); ++i) {
+				signals[i]->shoot(a1, a2);
+			}
+			
+			this->m_wildcard.shoot(a1, a2);
+		}
+		
+		void operator()(arg1_type a1, arg2_type a2) {
+			shoot(a1, a2);
+		}
+	};
+	
+	template<class arg1_type, class arg2_type, class arg3_type, class mt_policy = SIGLY_DEFAULT_MT_POLICY>
+	class KeyedSignal3 : public _keyed_signal_base<Signal3<arg1_type, arg2_type, arg3_type, mt_policy>, typename _value_type<arg1_type>::type, mt_policy> {
+	public:
+		typedef typename _value_type<arg1_type>::type key_type;
+		typedef Signal3<arg1_type, arg2_type, arg3_type, mt_policy> signal_type;
+		typedef typename _keyed_signal_base<signal_type, key_type, mt_policy>::emission emission;
+		
+		template<class desttype>
+		void connect(const key_type &key, desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type, arg3_type)) {
+			lock_block<mt_policy> lock(this);
+			this->exact(key)->connect(pclass, pmemfun);
+		}
+		
+		template<class desttype>
+		void connect(const key_type &first, const key_type &last, desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type, arg3_type)) {
+			lock_block<mt_policy> lock(this);
+			this->range(first, last)->connect(pclass, pmemfun);
+		}
+		
+		template<class desttype>
+		void connectAll(desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type, arg3_type)) {
+			lock_block<mt_policy> lock(this);
+			this->m_wildcard.connect(pclass, pmemfun);
+		}
+		
+		void shoot(arg1_type a1, arg2_type a2, arg3_type a3) {
+			emission signals(this, a1);
+			
+			for (std::size_t i = 0; i < signals.size(); ++i) {
+				signals[i]->shoot(a1, a2, a3);
+			}
+			
+			this->m_wildcard.shoot(a1, a2, a3);
+		}
+		
+		void operator()(arg1_type a1, arg2_type a2, arg3_type a3) {
+			shoot(a1, a2, a3);
+		}
 	};
 	
-	template < class arg1_type, class arg2_type, class arg3_type, class arg4_type,
-	class arg5_type, class arg6_type, class mt_policy >
-	class _connection_base6 {
+	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class mt_policy = SIGLY_DEFAULT_MT_POLICY>
+	class KeyedSignal4 : public _keyed_signal_base<Signal4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>, typename _value_type<arg1_type>::type, mt_policy> {
 	public:
-		virtual ~_connection_base6() {}
-		virtual HasSlots<mt_policy>* getdest() const = 0;
-		virtual void shoot(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type,
-		                   arg6_type) = 0;
-		virtual _connection_base6 < arg1_type, arg2_type, arg3_type, arg4_type,
-		arg5_type, arg6_type, mt_policy > * clone() = 0;
-		virtual _connection_base6 < arg1_type, arg2_type, arg3_type, arg4_type,
-		arg5_type, arg6_type, mt_policy > * duplicate(HasSlots<mt_policy>* pnewdest) = 0;
+		typedef typename _value_type<arg1_type>::type key_type;
+		typedef Signal4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy> signal_type;
+		typedef typename _keyed_signal_base<signal_type, key_type, mt_policy>::emission emission;
+		
+		template<class desttype>
+		void connect(const key_type &key, desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type)) {
+			lock_block<mt_policy> lock(this);
+			this->exact(key)->connect(pclass, pmemfun);
+		}
+		
+		template<class desttype>
+		void connect(const key_type &first, const key_type &last, desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type)) {
+			lock_block<mt_policy> lock(this);
+			this->range(first, last)->connect(pclass, pmemfun);
+		}
+		
+		template<class desttype>
+		void connectAll(desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type)) {
+			lock_block<mt_policy> lock(this);
+			this->m_wildcard.connect(pclass, pmemfun);
+		}
+		
+		void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4) {
+			emission signals(this, a1);
+			
+			for (std::size_t i = 0; i < signals.size(); ++i) {
+				signals[i]->shoot(a1, a2, a3, a4);
+			}
+			
+			this->m_wildcard.shoot(a1, a2, a3, a4);
+		}
+		
+		void operator()(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4) {
+			shoot(a1, a2, a3, a4);
+		}
 	};
 	
-	template < class arg1_type, class arg2_type, class arg3_type, class arg4_type,
-	class arg5_type, class arg6_type, class arg7_type, class mt_policy >
-	class _connection_base7 {
+	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class mt_policy = SIGLY_DEFAULT_MT_POLICY>
+	class KeyedSignal5 : public _keyed_signal_base<Signal5<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy>, typename _value_type<arg1_type>::type, mt_policy> {
 	public:
-		virtual ~_connection_base7() {}
-		virtual HasSlots<mt_policy>* getdest() const = 0;
-		virtual void shoot(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type,
-		                   arg6_type, arg7_type) = 0;
-		virtual _connection_base7 < arg1_type, arg2_type, arg3_type, arg4_type,
-		arg5_type, arg6_type, arg7_type, mt_policy > * clone() = 0;
-		virtual _connection_base7 < arg1_type, arg2_type, arg3_type, arg4_type,
-		arg5_type, arg6_type, arg7_type, mt_policy > * duplicate(HasSlots<mt_policy>* pnewdest) = 0;
+		typedef typename _value_type<arg1_type>::type key_type;
+		typedef Signal5<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy> signal_type;
+		typedef typename _keyed_signal_base<signal_type, key_type, mt_policy>::emission emission;
+		
+		template<class desttype>
+		void connect(const key_type &key, desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type)) {
+			lock_block<mt_policy> lock(this);
+			this->exact(key)->connect(pclass, pmemfun);
+		}
+		
+		template<class desttype>
+		void connect(const key_type &first, const key_type &last, desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type)) {
+			lock_block<mt_policy> lock(this);
+			this->range(first, last)->connect(pclass, pmemfun);
+		}
+		
+		template<class desttype>
+		void connectAll(desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type)) {
+			lock_block<mt_policy> lock(this);
+			this->m_wildcard.connect(pclass, pmemfun);
+		}
+		
+		void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5) {
+			emission signals(this, a1);
+			
+			for (std::size_t i = 0; i < signals.size(); ++i) {
+				signals[i]->shoot(a1, a2, a3, a4, a5);
+			}
+			
+			this->m_wildcard.shoot(a1, a2, a3, a4, a5);
+		}
+		
+		void operator()(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5) {
+			shoot(a1, a2, a3, a4, a5);
+		}
 	};
 	
-	template < class arg1_type, class arg2_type, class arg3_type, class arg4_type,
-	class arg5_type, class arg6_type, class arg7_type, class arg8_type, class mt_policy >
-	class _connection_base8 {
+	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class mt_policy = SIGLY_DEFAULT_MT_POLICY>
+	class KeyedSignal6 : public _keyed_signal_base<Signal6<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy>, typename _value_type<arg1_type>::type, mt_policy> {
 	public:
-		virtual ~_connection_base8() {}
-		virtual HasSlots<mt_policy>* getdest() const = 0;
-		virtual void shoot(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type,
-		                   arg6_type, arg7_type, arg8_type) = 0;
-		virtual _connection_base8 < arg1_type, arg2_type, arg3_type, arg4_type,
-		arg5_type, arg6_type, arg7_type, arg8_type, mt_policy > * clone() = 0;
-		virtual _connection_base8 < arg1_type, arg2_type, arg3_type, arg4_type,
-		arg5_type, arg6_type, arg7_type, arg8_type, mt_policy > * duplicate(HasSlots<mt_policy>* pnewdest) = 0;
+		typedef typename _value_type<arg1_type>::type key_type;
+		typedef Signal6<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy> signal_type;
+		typedef typename _keyed_signal_base<signal_type, key_type, mt_policy>::emission emission;
+		
+		template<class desttype>
+		void connect(const key_type &key, desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type)) {
+			lock_block<mt_policy> lock(this);
+			this->exact(key)->connect(pclass, pmemfun);
+		}
+		
+		template<class desttype>
+		void connect(const key_type &first, const key_type &last, desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type)) {
+			lock_block<mt_policy> lock(this);
+			this->range(first, last)->connect(pclass, pmemfun);
+		}
+		
+		template<class desttype>
+		void connectAll(desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type)) {
+			lock_block<mt_policy> lock(this);
+			this->m_wildcard.connect(pclass, pmemfun);
+		}
+		
+		void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6) {
+			emission signals(this, a1);
+			
+			for (std::size_t i = 0; i < signals.size(); ++i) {
+				signals[i]->shoot(a1, a2, a3, a4, a5, a6);
+			}
+			
+			this->m_wildcard.shoot(a1, a2, a3, a4, a5, a6);
+		}
+		
+		void operator()(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6) {
+			shoot(a1, a2, a3, a4, a5, a6);
+		}
 	};
 	
-	template<class mt_policy>
-	class _signal_base : public mt_policy {
+	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class arg7_type, class mt_policy = SIGLY_DEFAULT_MT_POLICY>
+	class KeyedSignal7 : public _keyed_signal_base<Signal7<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy>, typename _value_type<arg1_type>::type, mt_policy> {
 	public:
-		virtual void slot_disconnect(HasSlots<mt_policy>* pslot) = 0;
-		virtual void slot_duplicate(const HasSlots<mt_policy>* poldslot, HasSlots<mt_policy>* pnewslot) = 0;
-	};
-	
-	template<class  mt_policy = SIGLY_DEFAULT_MT_POLICY>
-	class HasSlots : public mt_policy {
-	private:
-		typedef typename std::set<_signal_base<mt_policy> *> sender_set;
-		typedef typename sender_set::const_iterator const_iterator;
+		typedef typename _value_type<arg1_type>::type key_type;
+		typedef Signal7<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy> signal_type;
+		typedef typename _keyed_signal_base<signal_type, key_type, mt_policy>::emission emission;
 		
-	public:
-		HasSlots(): mt_policy(), active(true) {
+		template<class desttype>
+		void connect(const key_type &key, desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type)) {
+			lock_block<mt_policy> lock(this);
+			this->exact(key)->connect(pclass, pmemfun);
+		}
+		
+		template<class desttype>
+		void connect(const key_type &first, const key_type &last, desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type)) {
+			lock_block<mt_policy> lock(this);
+			this->range(first, last)->connect(pclass, pmemfun);
 		}
 		
-		HasSlots(const HasSlots &hs): mt_policy(hs) {
+		template<class desttype>
+		void connectAll(desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type)) {
 			lock_block<mt_policy> lock(this);
-			const_iterator it = hs.m_senders.begin();
-			const_iterator itEnd = hs.m_senders.end();
+			this->m_wildcard.connect(pclass, pmemfun);
+		}
+		
+		void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6, arg7_type a7) {
+			emission signals(this, a1);
 			
-			while (it != itEnd) {
-				(*it)->slot_duplicate(&hs, this);
-				m_senders.insert(*it);
-				++it;
+			for (std::size_t i = 0; i < signals.size(); ++i) {
+				signals[i]->shoot(a1, a2, a3, a4, a5, a6, a7);
 			}
+			
+			this->m_wildcard.shoot(a1, a2, a3, a4, a5, a6, a7);
 		}
 		
-		void signalConnect(_signal_base<mt_policy>* sender) {
-			lock_block<mt_policy> lock(this);
-			m_senders.insert(sender);
+		void operator()(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6, arg7_type a7) {
+			shoot(a1, a2, a3, a4, a5, a6, a7);
 		}
+	};
+	
+	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class arg7_type, class arg8_type, class mt_policy = SIGLY_DEFAULT_MT_POLICY>
+	class KeyedSignal8 : public _keyed_signal_base<Signal8<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy>, typename _value_type<arg1_type>::type, mt_policy> {
+	public:
+		typedef typename _value_type<arg1_type>::type key_type;
+		typedef Signal8<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy> signal_type;
+		typedef typename _keyed_signal_base<signal_type, key_type, mt_policy>::emission emission;
 		
-		void signalDisconnect(_signal_base<mt_policy>* sender) {
+		template<class desttype>
+		void connect(const key_type &key, desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type)) {
 			lock_block<mt_policy> lock(this);
-			m_senders.erase(sender);
+			this->exact(key)->connect(pclass, pmemfun);
 		}
 		
-		virtual ~HasSlots() {
-			disconnectAll();
+		template<class desttype>
+		void connect(const key_type &first, const key_type &last, desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type)) {
+			lock_block<mt_policy> lock(this);
+			this->range(first, last)->connect(pclass, pmemfun);
 		}
 		
-		void disconnectAll() {
+		template<class desttype>
+		void connectAll(desttype *pclass, void (desttype::*pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type)) {
 			lock_block<mt_policy> lock(this);
-			const_iterator it = m_senders.begin();
-			const_iterator itEnd = m_senders.end();
+			this->m_wildcard.connect(pclass, pmemfun);
+		}
+		
+		void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6, arg7_type a7, arg8_type a8) {
+			emission signals(this, a1);
 			
-			while (it != itEnd) {
-				(*it)->slot_disconnect(this);
-				++it;
+			for (std::size_t i = 0; i < signals.size(); ++i) {
+				signals[i]->shoot(a1, a2, a3, a4, a5, a6, a7, a8);
 			}
 			
-			m_senders.erase(m_senders.begin(), m_senders.end());
+			this->m_wildcard.shoot(a1, a2, a3, a4, a5, a6, a7, a8);
 		}
 		
-		void deactivateSlots() {
-			active = false;
+		void operator()(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6, arg7_type a7, arg8_type a8) {
+			shoot(a1, a2, a3, a4, a5, a6, a7, a8);
+		}
+	};
+	
+	class _reactive;
+	
+	// Update of the reactive values of the calling thread. The outermost
+	// one collects the observed values that were invalidated and refreshes
+	// them when it is flushed, so that each is recomputed once however many
+	// of its inputs changed.
+	class _reactive_tick {
+	public:
+		_reactive_tick(): m_outer(current()) {
+			if (m_outer == NULL) {
+				current() = this;
+			}
 		}
 		
-		void activateSlots() {
-			active = true;
+		~_reactive_tick() {
+			if (m_outer == NULL) {
+				discard();
+				current() = NULL;
+			}
 		}
 		
-		bool areSlotsActive() const {
-			return active;
+		static _reactive_tick *&current() {
+			static _SIGLY_THREAD_LOCAL _reactive_tick *tick = NULL;
+			return tick;
+		}
+		
+		inline void flush();
+		inline void discard();
+		
+		// Drops a value that is being destroyed.
+		void forget(_reactive *value) {
+			m_queue.erase(std::remove(m_queue.begin(), m_queue.end(), value), m_queue.end());
+			std::replace(m_round.begin(), m_round.end(), value, static_cast<_reactive *>(NULL));
 		}
 		
+		std::vector<_reactive *> m_queue;
+		
 	private:
-		sender_set m_senders;
-		bool active;
+		_reactive_tick(const _reactive_tick &);
+		_reactive_tick &operator=(const _reactive_tick &);
+		
+		_reactive_tick *m_outer;
+		// The values being refreshed.
+		std::vector<_reactive *> m_round;
 	};
 	
-	template<class mt_policy>
-	class _signal_base0 : public _signal_base<mt_policy> {
+	template<class T>
+	struct _default_equal {
+		bool operator()(const T &a, const T &b) const {
+			return a == b;
+		}
+	};
+	
+	// Equality of the bytes of two values, for Property types without an
+	// operator== or for which comparing the members one by one costs more.
+	// Only use it on types that can be copied with memcpy; padding bytes
+	// that differ make equal values look changed.
+	struct BitwiseEqual {
+		template<class T>
+		bool operator()(const T &a, const T &b) const {
+			return std::memcmp(&a, &b, sizeof(T)) == 0;
+		}
+	};
+	
+	// A value that emits changed(value) and changedFrom(old, value) when it
+	// is set to a value that is not equal to the current one, and nothing
+	// otherwise. The old value is only copied while changedFrom has
+	// connections. Signals are emitted after the property is unlocked, so
+	// slots may read or set it; concurrent changes may reach slots in a
+	// different order than they were made. The Computed values that depend
+	// on the property are refreshed once every slot has seen the change.
+	template<class T, class mt_policy = SIGLY_DEFAULT_MT_POLICY, class equal = _default_equal<T> >
+	class Property : public mt_policy {
 	public:
-		typedef typename std::list<_connection_base0<mt_policy> *>  connections_list;
-		typedef typename connections_list::const_iterator const_iterator;
-		typedef typename connections_list::iterator iterator;
+		Property(): m_value() {
+		}
 		
-		_signal_base0() {
-			;
+		explicit Property(const T &value): m_value(value) {
 		}
 		
-		_signal_base0(const _signal_base0 &s)
-		: _signal_base<mt_policy>(s) {
-			lock_block<mt_policy> lock(this);
-			const_iterator  it = s.m_connected_slots.begin();
-			const_iterator itEnd = s.m_connected_slots.end();
+		Property(const Property &other): mt_policy(other), changed(other.changed), changedFrom(other.changedFrom), m_value(other.get()), m_equal(other.m_equal) {
+		}
+		
+		Property &operator=(const Property &other) {
+			set(other.get());
+			return *this;
+		}
+		
+		Property &operator=(const T &value) {
+			set(value);
+			return *this;
+		}
+		
+		T get() const {
+			lock_block<mt_policy> lock(const_cast<Property *>(this));
+			return m_value;
+		}
+		
+		operator T() const {
+			return get();
+		}
+		
+		// Returns whether the value changed.
+		bool set(const T &value) {
+			if (changedFrom.connectionCount() != 0) {
+				return replace(value);
+			}
 			
-			while (it != itEnd) {
-				(*it)->getdest()->signalConnect(this);
-				m_connected_slots.push_back((*it)->clone());
+			{
+				lock_block<mt_policy> lock(this);
 				
-				++it;
+				if (m_equal(m_value, value)) {
+					return false;
+				}
+				
+				m_value = value;
 			}
+			
+			_reactive_tick tick;
+			changed(value);
+			tick.flush();
+			return true;
 		}
 		
-		~_signal_base0() {
-			disconnectAll();
-		}
+		Signal1<const T &, mt_policy> changed;
+		Signal2<const T &, const T &, mt_policy> changedFrom;
 		
-		void disconnectAll() {
-			lock_block<mt_policy> lock(this);
-			const_iterator it  = m_connected_slots.begin();
-			const_iterator itEnd = m_connected_slots.end();
+	private:
+		bool replace(const T &value) {
+			T old(value);
 			
-			while (it != itEnd) {
-				(*it)->getdest()->signalDisconnect(this);
-				delete *it;
+			{
+				lock_block<mt_policy> lock(this);
 				
-				++it;
+				if (m_equal(m_value, value)) {
+					return false;
+				}
+				
+				std::swap(m_value, old);
 			}
 			
-			m_connected_slots.erase(m_connected_slots.begin(), m_connected_slots.end());
+			_reactive_tick tick;
+			changed(value);
+			changedFrom(old, value);
+			tick.flush();
+			return true;
 		}
 		
-		void disconnect(HasSlots<mt_policy>* pclass) {
-			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
+		T m_value;
+		equal m_equal;
+	};
+	
+	// Node of the dependency graph of the reactive values. A value is dirty
+	// when one of its inputs changed since it was last computed; all the
+	// values that depend on a dirty one are dirty too.
+	class _reactive {
+	public:
+		_reactive(): m_level(0), m_dirty(true), m_queued(false) {
+		}
+		
+		virtual ~_reactive() {
+			for (std::size_t i = 0; i < m_dependencies.size(); ++i) {
+				std::vector<_reactive *> &dependents = m_dependencies[i]->m_dependents;
+				dependents.erase(std::find(dependents.begin(), dependents.end(), this));
+			}
 			
-			while (it != itEnd) {
-				if ((*it)->getdest() == pclass) {
-					delete *it;
-					m_connected_slots.erase(iterator(it++));
-					pclass->signalDisconnect(this);
-					continue;
+			for (std::size_t i = 0; i < m_dependents.size(); ++i) {
+				std::vector<_reactive *> &dependencies = m_dependents[i]->m_dependencies;
+				dependencies.erase(std::find(dependencies.begin(), dependencies.end(), this));
+			}
+			
+			if (m_queued) {
+				_reactive_tick::current()->forget(this);
+			}
+		}
+		
+		// Marks the value and those that depend on it dirty, then refreshes
+		// the observed ones unless a ReactiveBatch is open.
+		void invalidate() {
+			_reactive_tick tick;
+			mark();
+			tick.flush();
+		}
+		
+		// Recomputes the value if it is dirty and emits its change.
+		virtual void refresh() = 0;
+		
+		static bool before(const _reactive *a, const _reactive *b) {
+			return a->m_level < b->m_level;
+		}
+		
+		// One more than the level of its deepest dependency, so that
+		// refreshing by increasing level follows the graph.
+		unsigned long m_level;
+		bool m_dirty;
+		bool m_queued;
+		
+	protected:
+		void addDependency(_reactive *dependency) {
+			m_dependencies.push_back(dependency);
+			dependency->m_dependents.push_back(this);
+			raise(dependency->m_level + 1);
+			inputAdded();
+		}
+		
+		// Invalidates the value once an input is connected, then computes it
+		// and the dirty values that depend on it. Only a value that turns
+		// dirty spreads the change to its dependents, so values left dirty
+		// since they were created would never refresh their observers.
+		void inputAdded() {
+			invalidate();
+			std::vector<_reactive *> values(1, this);
+			
+			for (std::size_t i = 0; i < values.size(); ++i) {
+				for (std::size_t j = 0; j < values[i]->m_dependents.size(); ++j) {
+					_reactive *dependent = values[i]->m_dependents[j];
+					
+					if (dependent->m_dirty && std::find(values.begin(), values.end(), dependent) == values.end()) {
+						values.push_back(dependent);
+					}
 				}
-				
-				++it;
+			}
+			
+			std::stable_sort(values.begin(), values.end(), &_reactive::before);
+			
+			for (std::size_t i = 0; i < values.size(); ++i) {
+				values[i]->settle();
 			}
 		}
 		
-		void slot_disconnect(HasSlots<mt_policy>* pslot) {
-			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
+		// Computes the value if it is dirty, without emitting its change.
+		virtual void settle() = 0;
+		
+		virtual bool observed() const = 0;
+		
+	private:
+		void mark() {
+			// A value observed since it turned dirty still has to be
+			// refreshed.
+			if (!m_queued && observed()) {
+				m_queued = true;
+				_reactive_tick::current()->m_queue.push_back(this);
+			}
 			
-			while (it != itEnd) {
-				iterator itNext = it;
-				++itNext;
+			if (m_dirty) {
+				return;
+			}
+			
+			m_dirty = true;
+			
+			for (std::size_t i = 0; i < m_dependents.size(); ++i) {
+				m_dependents[i]->mark();
+			}
+		}
+		
+		void raise(unsigned long level) {
+			if (level > m_level) {
+				m_level = level;
 				
-				if ((*it)->getdest() == pslot) {
-					delete *it;
-					m_connected_slots.erase(it);
+				for (std::size_t i = 0; i < m_dependents.size(); ++i) {
+					m_dependents[i]->raise(level + 1);
 				}
-				
-				it = itNext;
 			}
 		}
 		
-		void slot_duplicate(const HasSlots<mt_policy>* oldtarget, HasSlots<mt_policy>* newtarget) {
-			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
+		std::vector<_reactive *> m_dependencies;
+		std::vector<_reactive *> m_dependents;
+	};
+	
+	inline void _reactive_tick::flush() {
+		if (m_outer != NULL) {
+			return;
+		}
+		
+		// Values invalidated by the slots called here join the next round.
+		while (!m_queue.empty()) {
+			m_round.swap(m_queue);
+			std::stable_sort(m_round.begin(), m_round.end(), &_reactive::before);
 			
-			while (it != itEnd) {
-				if ((*it)->getdest() == oldtarget) {
-					m_connected_slots.push_back((*it)->duplicate(newtarget));
-				}
+			for (std::size_t i = 0; i < m_round.size(); ++i) {
+				_reactive *value = m_round[i];
 				
-				++it;
+				if (value != NULL) {
+					value->m_queued = false;
+					value->refresh();
+				}
+			}
+			
+			m_round.clear();
+		}
+	}
+	
+	inline void _reactive_tick::discard() {
+		for (std::size_t i = 0; i < m_queue.size(); ++i) {
+			m_queue[i]->m_queued = false;
+		}
+		
+		for (std::size_t i = 0; i < m_round.size(); ++i) {
+			if (m_round[i] != NULL) {
+				m_round[i]->m_queued = false;
 			}
 		}
 		
-	protected:
-		connections_list m_connected_slots;
+		m_queue.clear();
+		m_round.clear();
+	}
+	
+	// Groups changes to the inputs of reactive values: the values that
+	// depend on them are refreshed once, when the outermost batch of the
+	// thread ends. The slots it calls then must not throw.
+	class ReactiveBatch {
+	public:
+		ReactiveBatch() {
+		}
+		
+		~ReactiveBatch() {
+			m_tick.flush();
+		}
+		
+	private:
+		ReactiveBatch(const ReactiveBatch &);
+		ReactiveBatch &operator=(const ReactiveBatch &);
+		
+		_reactive_tick m_tick;
+	};
+	
+	template<class T>
+	class _compute_base {
+	public:
+		virtual ~_compute_base() {
+		}
+		
+		virtual T compute() = 0;
 	};
 	
-	template<class arg1_type, class mt_policy>
-	class _signal_base1 : public _signal_base<mt_policy> {
+	template<class T, class dest_type, class pmemfun_type>
+	class _compute_method : public _compute_base<T> {
 	public:
-		typedef typename std::list<_connection_base1<arg1_type, mt_policy> *>  connections_list;
-		typedef typename connections_list::const_iterator const_iterator;
-		typedef typename connections_list::iterator iterator;
+		_compute_method(dest_type *pobject, pmemfun_type pmemfun): m_pobject(pobject), m_pmemfun(pmemfun) {
+		}
 		
-		_signal_base1() {
-			;
+		virtual T compute() {
+			return (m_pobject->*m_pmemfun)();
 		}
 		
-		_signal_base1(const _signal_base1<arg1_type, mt_policy>& s)
-		: _signal_base<mt_policy>(s) {
-			lock_block<mt_policy> lock(this);
-			const_iterator it = s.m_connected_slots.begin();
-			const_iterator itEnd = s.m_connected_slots.end();
-			
-			while (it != itEnd) {
-				(*it)->getdest()->signalConnect(this);
-				m_connected_slots.push_back((*it)->clone());
-				
-				++it;
-			}
+	private:
+		dest_type *m_pobject;
+		pmemfun_type m_pmemfun;
+	};
+	
+	// A value derived from Properties, other Computed values or signals that
+	// tell something changed. A change of an input only marks the value
+	// dirty; it is recomputed by the member function given to the
+	// constructor the next time get() is called, or, while changed has
+	// connections, once the change is over, after the values it depends on
+	// and only if one of them changed. changed is emitted when the result
+	// differs from the previous one. dependsOn() computes the value, so that
+	// the changes of its inputs reach the slots connected afterwards. A value
+	// that went dirty while nothing observed it is refreshed by the next
+	// change that reaches it, which does not cross a dirty value it depends
+	// on: get() it once when connecting to changed late. A graph of reactive
+	// values is used from one thread at a time and must not have cycles.
+	template<class T, class mt_policy = SIGLY_DEFAULT_MT_POLICY, class equal = _default_equal<T> >
+	class Computed : public HasSlots<mt_policy>, public _reactive {
+	public:
+		template<class dest_type>
+		Computed(dest_type *pobject, T (dest_type::*pmemfun)()): m_compute(new _compute_method<T, dest_type, T (dest_type::*)()>(pobject, pmemfun)), m_value(), m_changed(false) {
 		}
 		
-		void slot_duplicate(const HasSlots<mt_policy>* oldtarget, HasSlots<mt_policy>* newtarget) {
-			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
-			
-			while (it != itEnd) {
-				if ((*it)->getdest() == oldtarget) {
-					m_connected_slots.push_back((*it)->duplicate(newtarget));
-				}
-				
-				++it;
-			}
+		template<class dest_type>
+		Computed(dest_type *pobject, T (dest_type::*pmemfun)() const): m_compute(new _compute_method<T, dest_type, T (dest_type::*)() const>(pobject, pmemfun)), m_value(), m_changed(false) {
 		}
 		
-		~_signal_base1() {
-			disconnectAll();
+		~Computed() {
+			delete m_compute;
 		}
 		
-		void disconnectAll() {
-			lock_block<mt_policy> lock(this);
-			const_iterator it = m_connected_slots.begin();
-			const_iterator itEnd = m_connected_slots.end();
-			
-			while (it != itEnd) {
-				(*it)->getdest()->signalDisconnect(this);
-				delete *it;
-				
-				++it;
+		template<class value_type, class policy, class value_equal>
+		void dependsOn(Property<value_type, policy, value_equal> &property) {
+			property.changed.connect(this, &Computed::template inputChanged<const value_type &>);
+			inputAdded();
+		}
+		
+		template<class value_type, class policy, class value_equal>
+		void dependsOn(Computed<value_type, policy, value_equal> &value) {
+			addDependency(&value);
+		}
+		
+		template<class policy>
+		void dependsOn(Signal0<policy> &signal) {
+			signal.connect(this, &Computed::inputChanged);
+			inputAdded();
+		}
+		
+		const T &get() {
+			if (m_dirty) {
+				update();
 			}
 			
-			m_connected_slots.erase(m_connected_slots.begin(), m_connected_slots.end());
+			return m_value;
 		}
 		
-		void disconnect(HasSlots<mt_policy>* pclass) {
-			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
+		operator const T &() {
+			return get();
+		}
+		
+		Signal1<const T &, mt_policy> changed;
+		
+	protected:
+		virtual void refresh() {
+			if (m_dirty) {
+				update();
+			}
 			
-			while (it != itEnd) {
-				if ((*it)->getdest() == pclass) {
-					delete *it;
-					m_connected_slots.erase(iterator(it++));
-					pclass->signalDisconnect(this);
-					continue;
-				}
-				
-				++it;
+			if (m_changed) {
+				m_changed = false;
+				T value(m_value);
+				changed(value);
 			}
 		}
 		
-		void slot_disconnect(HasSlots<mt_policy>* pslot) {
-			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
-			
-			while (it != itEnd) {
-				iterator itNext = it;
-				++itNext;
+		virtual void settle() {
+			if (m_dirty) {
+				update();
 				
-				if ((*it)->getdest() == pslot) {
-					delete *it;
-					m_connected_slots.erase(it);
+				// Nothing observed the previous value, unless a refresh is
+				// pending.
+				if (!m_queued) {
+					m_changed = false;
 				}
-				
-				it = itNext;
 			}
 		}
 		
+		virtual bool observed() const {
+			return changed.connectionCount() != 0;
+		}
 		
-	protected:
-		connections_list m_connected_slots;
+	private:
+		Computed(const Computed &);
+		Computed &operator=(const Computed &);
+		
+		void update() {
+			T value(m_compute->compute());
+			m_dirty = false;
+			
+			if (!m_equal(value, m_value)) {
+				std::swap(m_value, value);
+				m_changed = true;
+			}
+		}
+		
+		void inputChanged() {
+			invalidate();
+		}
+		
+		template<class arg_type>
+		void inputChanged(arg_type) {
+			invalidate();
+		}
+		
+		_compute_base<T> *m_compute;
+		T m_value;
+		equal m_equal;
+		bool m_changed;
 	};
 	
-	template<class arg1_type, class arg2_type, class mt_policy>
-	class _signal_base2 : public _signal_base<mt_policy> {
+	// Signal emission held by a Scheduler timer, with copies of its
+	// arguments.
+	class _timed_emission {
 	public:
-		typedef typename std::list<_connection_base2<arg1_type, arg2_type, mt_policy> *>
-		connections_list;
-		typedef typename connections_list::const_iterator const_iterator;
-		typedef typename connections_list::iterator iterator;
-		
-		_signal_base2() {
-			;
+		virtual ~_timed_emission() {
 		}
 		
-		_signal_base2(const _signal_base2<arg1_type, arg2_type, mt_policy>& s)
-		: _signal_base<mt_policy>(s) {
-			lock_block<mt_policy> lock(this);
-			const_iterator it = s.m_connected_slots.begin();
-			const_iterator itEnd = s.m_connected_slots.end();
-			
-			while (it != itEnd) {
-				(*it)->getdest()->signalConnect(this);
-				m_connected_slots.push_back((*it)->clone());
-				
-				++it;
-			}
+		virtual void fire() = 0;
+	};
+	
+	template<class mt_policy>
+	class _timed_emission0 : public _timed_emission {
+	public:
+		_timed_emission0(Signal0<mt_policy> *signal): m_signal(signal) {
 		}
 		
-		void slot_duplicate(const HasSlots<mt_policy>* oldtarget, HasSlots<mt_policy>* newtarget) {
-			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
-			
-			while (it != itEnd) {
-				if ((*it)->getdest() == oldtarget) {
-					m_connected_slots.push_back((*it)->duplicate(newtarget));
-				}
-				
-				++it;
-			}
+		virtual void fire() {
+			m_signal->shoot();
 		}
 		
-		~_signal_base2() {
-			disconnectAll();
+	private:
+		Signal0<mt_policy> *m_signal;
+	};
+	
+	template<class arg1_type, class mt_policy>
+	class _timed_emission1 : public _timed_emission {
+	public:
+		_timed_emission1(Signal1<arg1_type, mt_policy> *signal, arg1_type a1): m_signal(signal), m_a1(a1) {
 		}
 		
-		void disconnectAll() {
-			lock_block<mt_policy> lock(this);
-			const_iterator it = m_connected_slots.begin();
-			const_iterator itEnd = m_connected_slots.end();
-			
-			while (it != itEnd) {
-				(*it)->getdest()->signalDisconnect(this);
-				delete *it;
-				
-				++it;
-			}
-			
-			m_connected_slots.erase(m_connected_slots.begin(), m_connected_slots.end());
+		virtual void fire() {
+			m_signal->shoot(m_a1);
 		}
 		
-		void disconnect(HasSlots<mt_policy>* pclass) {
-			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
-			
-			while (it != itEnd) {
-				if ((*it)->getdest() == pclass) {
-					delete *it;
-					m_connected_slots.erase(iterator(it++));
-					pclass->signalDisconnect(this);
-					continue;
-				}
-				
-				++it;
-			}
+	private:
+		Signal1<arg1_type, mt_policy> *m_signal;
+		typename _value_type<arg1_type>::type m_a1;
+	};
+	
+	template<class arg1_type, class arg2_type, class mt_policy>
+	class _timed_emission2 : public _timed_emission {
+	public:
+		_timed_emission2(Signal2<arg1_type, arg2_type, mt_policy> *signal, arg1_type a1, arg2_type a2): m_signal(signal), m_a1(a1), m_a2(a2) {
 		}
 		
-		void slot_disconnect(HasSlots<mt_policy>* pslot) {
-			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
-			
-			while (it != itEnd) {
-				iterator itNext = it;
-				++itNext;
-				
-				if ((*it)->getdest() == pslot) {
-					delete *it;
-					m_connected_slots.erase(it);
-				}
-				
-				it = itNext;
-			}
+		virtual void fire() {
+			m_signal->shoot(m_a1, m_a2);
 		}
 		
-	protected:
-		connections_list m_connected_slots;
+	private:
+		Signal2<arg1_type, arg2_type, mt_policy> *m_signal;
+		typename _value_type<arg1_type>::type m_a1;
+		typename _value_type<arg2_type>::type m_a2;
 	};
 	
 	template<class arg1_type, class arg2_type, class arg3_type, class mt_policy>
-	class _signal_base3 : public _signal_base<mt_policy> {
+	class _timed_emission3 : public _timed_emission {
 	public:
-		typedef std::list<_connection_base3<arg1_type, arg2_type, arg3_type, mt_policy> *>
-		connections_list;
+		_timed_emission3(Signal3<arg1_type, arg2_type, arg3_type, mt_policy> *signal, arg1_type a1, arg2_type a2, arg3_type a3): m_signal(signal), m_a1(a1), m_a2(a2), m_a3(a3) {
+		}
 		
-		typedef typename connections_list::const_iterator const_iterator;
-		typedef typename connections_list::iterator iterator;
-		_signal_base3() {
-			;
+		virtual void fire() {
+			m_signal->shoot(m_a1, m_a2, m_a3);
 		}
 		
-		_signal_base3(const _signal_base3<arg1_type, arg2_type, arg3_type, mt_policy>& s)
-		: _signal_base<mt_policy>(s) {
-			lock_block<mt_policy> lock(this);
-			const_iterator it = s.m_connected_slots.begin();
-			const_iterator itEnd = s.m_connected_slots.end();
-			
-			while (it != itEnd) {
-				(*it)->getdest()->signalConnect(this);
-				m_connected_slots.push_back((*it)->clone());
-				
-				++it;
-			}
+	private:
+		Signal3<arg1_type, arg2_type, arg3_type, mt_policy> *m_signal;
+		typename _value_type<arg1_type>::type m_a1;
+		typename _value_type<arg2_type>::type m_a2;
+		typename _value_type<arg3_type>::type m_a3;
+	};
+	
+	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class mt_policy>
+	class _timed_emission4 : public _timed_emission {
+	public:
+		_timed_emission4(Signal4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy> *signal, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4): m_signal(signal), m_a1(a1), m_a2(a2), m_a3(a3), m_a4(a4) {
 		}
 		
-		void slot_duplicate(const HasSlots<mt_policy>* oldtarget, HasSlots<mt_policy>* newtarget) {
-			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
-			
-			while (it != itEnd) {
-				if ((*it)->getdest() == oldtarget) {
-					m_connected_slots.push_back((*it)->duplicate(newtarget));
-				}
-				
-				++it;
-			}
+		virtual void fire() {
+			m_signal->shoot(m_a1, m_a2, m_a3, m_a4);
 		}
 		
-		~_signal_base3() {
-			disconnectAll();
+	private:
+		Signal4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy> *m_signal;
+		typename _value_type<arg1_type>::type m_a1;
+		typename _value_type<arg2_type>::type m_a2;
+		typename _value_type<arg3_type>::type m_a3;
+		typename _value_type<arg4_type>::type m_a4;
+	};
+	
+	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class mt_policy>
+	class _timed_emission5 : public _timed_emission {
+	public:
+		_timed_emission5(Signal5<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy> *signal, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5): m_signal(signal), m_a1(a1), m_a2(a2), m_a3(a3), m_a4(a4), m_a5(a5) {
 		}
 		
-		void disconnectAll() {
-			lock_block<mt_policy> lock(this);
-			const_iterator it = m_connected_slots.begin();
-			const_iterator itEnd = m_connected_slots.end();
-			
-			while (it != itEnd) {
-				(*it)->getdest()->signalDisconnect(this);
-				delete *it;
-				
-				++it;
-			}
-			
-			m_connected_slots.erase(m_connected_slots.begin(), m_connected_slots.end());
+		virtual void fire() {
+			m_signal->shoot(m_a1, m_a2, m_a3, m_a4, m_a5);
 		}
 		
-		void disconnect(HasSlots<mt_policy>* pclass) {
-			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
-			
-			while (it != itEnd) {
-				if ((*it)->getdest() == pclass) {
-					delete *it;
-					m_connected_slots.erase(iterator(it++));
-					pclass->signalDisconnect(this);
-					continue;
-				}
-				
-				++it;
-			}
+	private:
+		Signal5<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy> *m_signal;
+		typename _value_type<arg1_type>::type m_a1;
+		typename _value_type<arg2_type>::type m_a2;
+		typename _value_type<arg3_type>::type m_a3;
+		typename _value_type<arg4_type>::type m_a4;
+		typename _value_type<arg5_type>::type m_a5;
+	};
+	
+	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class mt_policy>
+	class _timed_emission6 : public _timed_emission {
+	public:
+		_timed_emission6(Signal6<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy> *signal, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6): m_signal(signal), m_a1(a1), m_a2(a2), m_a3(a3), m_a4(a4), m_a5(a5), m_a6(a6) {
 		}
 		
-		void slot_disconnect(HasSlots<mt_policy>* pslot) {
-			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
-			
-			while (it != itEnd) {
-				iterator itNext = it;
-				++itNext;
-				
-				if ((*it)->getdest() == pslot) {
-					delete *it;
-					m_connected_slots.erase(it);
-				}
-				
-				it = itNext;
-			}
+		virtual void fire() {
+			m_signal->shoot(m_a1, m_a2, m_a3, m_a4, m_a5, m_a6);
 		}
 		
-	protected:
-		connections_list m_connected_slots;
+	private:
+		Signal6<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy> *m_signal;
+		typename _value_type<arg1_type>::type m_a1;
+		typename _value_type<arg2_type>::type m_a2;
+		typename _value_type<arg3_type>::type m_a3;
+		typename _value_type<arg4_type>::type m_a4;
+		typename _value_type<arg5_type>::type m_a5;
+		typename _value_type<arg6_type>::type m_a6;
 	};
 	
-	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class mt_policy>
-	class _signal_base4 : public _signal_base<mt_policy> {
+	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class arg7_type, class mt_policy>
+	class _timed_emission7 : public _timed_emission {
 	public:
-		typedef std::list < _connection_base4 < arg1_type, arg2_type, arg3_type,
-		arg4_type, mt_policy > * >  connections_list;
-		typedef typename connections_list::const_iterator const_iterator;
-		typedef typename connections_list::iterator iterator;
+		_timed_emission7(Signal7<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy> *signal, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6, arg7_type a7): m_signal(signal), m_a1(a1), m_a2(a2), m_a3(a3), m_a4(a4), m_a5(a5), m_a6(a6), m_a7(a7) {
+		}
 		
-		_signal_base4() {
-			;
+		virtual void fire() {
+			m_signal->shoot(m_a1, m_a2, m_a3, m_a4, m_a5, m_a6, m_a7);
 		}
 		
-		_signal_base4(const _signal_base4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>& s)
-		: _signal_base<mt_policy>(s) {
-			lock_block<mt_policy> lock(this);
-			const_iterator it = s.m_connected_slots.begin();
-			const_iterator itEnd = s.m_connected_slots.end();
-			
-			while (it != itEnd) {
-				(*it)->getdest()->signalConnect(this);
-				m_connected_slots.push_back((*it)->clone());
-				
-				++it;
-			}
+	private:
+		Signal7<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy> *m_signal;
+		typename _value_type<arg1_type>::type m_a1;
+		typename _value_type<arg2_type>::type m_a2;
+		typename _value_type<arg3_type>::type m_a3;
+		typename _value_type<arg4_type>::type m_a4;
+		typename _value_type<arg5_type>::type m_a5;
+		typename _value_type<arg6_type>::type m_a6;
+		typename _value_type<arg7_type>::type m_a7;
+	};
+	
+	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class arg7_type, class arg8_type, class mt_policy>
+	class _timed_emission8 : public _timed_emission {
+	public:
+		_timed_emission8(Signal8<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy> *signal, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6, arg7_type a7, arg8_type a8): m_signal(signal), m_a1(a1), m_a2(a2), m_a3(a3), m_a4(a4), m_a5(a5), m_a6(a6), m_a7(a7), m_a8(a8) {
+		}
+		
+		virtual void fire() {
+			m_signal->shoot(m_a1, m_a2, m_a3, m_a4, m_a5, m_a6, m_a7, m_a8);
+		}
+		
+	private:
+		Signal8<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy> *m_signal;
+		typename _value_type<arg1_type>::type m_a1;
+		typename _value_type<arg2_type>::type m_a2;
+		typename _value_type<arg3_type>::type m_a3;
+		typename _value_type<arg4_type>::type m_a4;
+		typename _value_type<arg5_type>::type m_a5;
+		typename _value_type<arg6_type>::type m_a6;
+		typename _value_type<arg7_type>::type m_a7;
+		typename _value_type<arg8_type>::type m_a8;
+	};
+	
+	// Entry of a Scheduler's timing wheel. Entries are reused once their
+	// timer is done; the generation tells apart the timers that used one.
+	struct _timer {
+		// Bytes for the emission, so that small argument lists are not
+		// allocated on their own.
+		enum { STORAGE = 6 * sizeof(void *) };
+		
+		_timer(): m_next(NULL), m_link(NULL), m_expires(0), m_period(0), m_generation(0), m_emission(NULL) {
 		}
 		
-		void slot_duplicate(const HasSlots<mt_policy>* oldtarget, HasSlots<mt_policy>* newtarget) {
-			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
-			
-			while (it != itEnd) {
-				if ((*it)->getdest() == oldtarget) {
-					m_connected_slots.push_back((*it)->duplicate(newtarget));
+		void *storage(std::size_t size) {
+			return size <= sizeof(m_storage) ? static_cast<void *>(&m_storage) : ::operator new(size);
+		}
+		
+		void clear() {
+			if (m_emission != NULL) {
+				m_emission->~_timed_emission();
+				
+				if (static_cast<void *>(m_emission) != static_cast<void *>(&m_storage)) {
+					::operator delete(m_emission);
 				}
 				
-				++it;
+				m_emission = NULL;
 			}
 		}
 		
-		~_signal_base4() {
-			disconnectAll();
-		}
-		
-		void disconnectAll() {
-			lock_block<mt_policy> lock(this);
-			const_iterator it = m_connected_slots.begin();
-			const_iterator itEnd = m_connected_slots.end();
+		void link(_timer *&head) {
+			m_next = head;
+			m_link = &head;
 			
-			while (it != itEnd) {
-				(*it)->getdest()->signalDisconnect(this);
-				delete *it;
-				
-				++it;
+			if (head != NULL) {
+				head->m_link = &m_next;
 			}
 			
-			m_connected_slots.erase(m_connected_slots.begin(), m_connected_slots.end());
+			head = this;
 		}
 		
-		void disconnect(HasSlots<mt_policy>* pclass) {
-			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
+		void unlink() {
+			*m_link = m_next;
 			
-			while (it != itEnd) {
-				if ((*it)->getdest() == pclass) {
-					delete *it;
-					this->m_connected_slots.erase(iterator(it++));
-					pclass->signalDisconnect(this);
-					continue;
-				}
-				
-				++it;
+			if (m_next != NULL) {
+				m_next->m_link = m_link;
 			}
+			
+			m_next = NULL;
+			m_link = NULL;
+		}
+		
+		_timer *m_next;
+		// The pointer to this entry, NULL while it is not in a list.
+		_timer **m_link;
+		unsigned long m_expires;
+		unsigned long m_period;
+		unsigned long m_generation;
+		_timed_emission *m_emission;
+		
+		union {
+			void *pointers[STORAGE / sizeof(void *)];
+			double number;
+		} m_storage;
+	};
+	
+	// Identifies a timer started by a Scheduler, for Scheduler::cancel().
+	class TimerHandle {
+	public:
+		TimerHandle(): m_timer(NULL), m_generation(0) {
 		}
 		
-		void slot_disconnect(HasSlots<mt_policy>* pslot) {
-			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
-			
-			while (it != itEnd) {
-				iterator itNext = it;
-				++itNext;
-				
-				if ((*it)->getdest() == pslot) {
-					delete *it;
-					m_connected_slots.erase(it);
-				}
-				
-				it = itNext;
-			}
+		bool operator==(const TimerHandle &other) const {
+			return m_timer == other.m_timer && m_generation == other.m_generation;
 		}
 		
-	protected:
-		connections_list m_connected_slots;
+		bool operator!=(const TimerHandle &other) const {
+			return !(*this == other);
+		}
+		
+	private:
+		TimerHandle(_timer *timer): m_timer(timer), m_generation(timer->m_generation) {
+		}
+		
+		friend class Scheduler;
+		
+		_timer *m_timer;
+		unsigned long m_generation;
 	};
 	
-	template < class arg1_type, class arg2_type, class arg3_type, class arg4_type,
-	class arg5_type, class mt_policy >
-	class _signal_base5 : public _signal_base<mt_policy> {
+	// Emits signals after a delay or periodically. Time is counted in ticks:
+	// advance() moves it forward by hand, update() by the real time elapsed
+	// since the scheduler was created, and exec() runs update() on the calling
+	// thread until quit() is called. Timers are kept in a hierarchical timing
+	// wheel, so starting and cancelling one take constant time however many
+	// are pending, and moving time forward skips runs of ticks without a
+	// timer at once. exec() sleeps until the earliest timer is due rather than
+	// waking every tick. Emissions run on the thread that moves time forward,
+	// one thread at a time, with copies of the arguments given when the timer
+	// was started. Cancel the timers of a signal before destroying it.
+	class Scheduler {
 	public:
-		typedef std::list < _connection_base5 < arg1_type, arg2_type, arg3_type,
-		arg4_type, arg5_type, mt_policy > * >  connections_list;
-		typedef typename connections_list::const_iterator const_iterator;
-		typedef typename connections_list::iterator iterator;
-		
-		_signal_base5() {
-			;
+		// resolution is the length of a tick in microseconds, for update()
+		// and exec().
+		Scheduler(double resolution = 1000.0): m_tick(0), m_count(0), m_due(NULL), m_firing(NULL), m_idle(NULL), m_resolution(resolution), m_origin(_now()), m_quit(false), m_sleeping(false), m_wake(0) {
+			for (std::size_t i = 0; i < SLOTS; ++i) {
+				m_wheel[i] = NULL;
+			}
 		}
 		
-		_signal_base5(const _signal_base5 < arg1_type, arg2_type, arg3_type, arg4_type,
-		              arg5_type, mt_policy > & s)
-		: _signal_base<mt_policy>(s) {
-			lock_block<mt_policy> lock(this);
-			const_iterator it = s.m_connected_slots.begin();
-			const_iterator itEnd = s.m_connected_slots.end();
-			
-			while (it != itEnd) {
-				(*it)->getdest()->signalConnect(this);
-				m_connected_slots.push_back((*it)->clone());
-				
-				++it;
+		~Scheduler() {
+			for (std::size_t i = 0; i < SLOTS; ++i) {
+				destroy(m_wheel[i]);
 			}
+			
+			destroy(m_due);
+			destroy(m_idle);
 		}
 		
-		void slot_duplicate(const HasSlots<mt_policy>* oldtarget, HasSlots<mt_policy>* newtarget) {
-			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
-			
-			while (it != itEnd) {
-				if ((*it)->getdest() == oldtarget) {
-					m_connected_slots.push_back((*it)->duplicate(newtarget));
-				}
-				
-				++it;
-			}
+		// Emits the signal once, delay ticks from now. A delay of 0 fires
+		// on the next tick.
+		template<class mt_policy>
+		TimerHandle after(unsigned long delay, Signal0<mt_policy> &signal) {
+			_timer *timer = acquire();
+			timer->m_emission = new (timer->storage(sizeof(_timed_emission0<mt_policy>))) _timed_emission0<mt_policy>(&signal);
+			return start(timer, delay, 0);
 		}
 		
-		~_signal_base5() {
-			disconnectAll();
+		template<class arg1_type, class mt_policy>
+		TimerHandle after(unsigned long delay, Signal1<arg1_type, mt_policy> &signal, arg1_type a1) {
+			_timer *timer = acquire();
+			timer->m_emission = new (timer->storage(sizeof(_timed_emission1<arg1_type, mt_policy>))) _timed_emission1<arg1_type, mt_policy>(&signal, a1);
+			return start(timer, delay, 0);
 		}
 		
-		void disconnectAll() {
-			lock_block<mt_policy> lock(this);
-			const_iterator it = m_connected_slots.begin();
-			const_iterator itEnd = m_connected_slots.end();
+		template<class arg1_type, class arg2_type, class mt_policy>
+		TimerHandle after(unsigned long delay, Signal2<arg1_type, arg2_type, mt_policy> &signal, arg1_type a1, arg2_type a2) {
+			_timer *timer = acquire();
+			timer->m_emission = new (timer->storage(sizeof(_timed_emission2<arg1_type, arg2_type, mt_policy>))) _timed_emission2<arg1_type, arg2_type, mt_policy>(&signal, a1, a2);
+			return start(timer, delay, 0);
+		}
+		
+		template<class arg1_type, class arg2_type, class arg3_type, class mt_policy>
+		TimerHandle after(unsigned long delay, Signal3<arg1_type, arg2_type, arg3_type, mt_policy> &signal, arg1_type a1, arg2_type a2, arg3_type a3) {
+			_timer *timer = acquire();
+			timer->m_emission = new (timer->storage(sizeof(_timed_emission3<arg1_type, arg2_type, arg3_type, mt_policy>))) _timed_emission3<arg1_type, arg2_type, arg3_type, mt_policy>(&signal, a1, a2, a3);
+			return start(timer, delay, 0);
+		}
+		
+		template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class mt_policy>
+		TimerHandle after(unsigned long delay, Signal4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy> &signal, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4) {
+			_timer *timer = acquire();
+			timer->m_emission = new (timer->storage(sizeof(_timed_emission4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>))) _timed_emission4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>(&signal, a1, a2, a3, a4);
+			return start(timer, delay, 0);
+		}
+		
+		template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class mt_policy>
+		TimerHandle after(unsigned long delay, Signal5<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy> &signal, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5) {
+			_timer *timer = acquire();
+			timer->m_emission = new (timer->storage(sizeof(_timed_emission5<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy>))) _timed_emission5<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy>(&signal, a1, a2, a3, a4, a5);
+			return start(timer, delay, 0);
+		}
+		
+		template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class mt_policy>
+		TimerHandle after(unsigned long delay, Signal6<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy> &signal, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6) {
+			_timer *timer = acquire();
+			timer->m_emission = new (timer->storage(sizeof(_timed_emission6<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy>))) _timed_emission6<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy>(&signal, a1, a2, a3, a4, a5, a6);
+			return start(timer, delay, 0);
+		}
+		
+		template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class arg7_type, class mt_policy>
+		TimerHandle after(unsigned long delay, Signal7<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy> &signal, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6, arg7_type a7) {
+			_timer *timer = acquire();
+			timer->m_emission = new (timer->storage(sizeof(_timed_emission7<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy>))) _timed_emission7<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy>(&signal, a1, a2, a3, a4, a5, a6, a7);
+			return start(timer, delay, 0);
+		}
+		
+		template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class arg7_type, class arg8_type, class mt_policy>
+		TimerHandle after(unsigned long delay, Signal8<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy> &signal, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6, arg7_type a7, arg8_type a8) {
+			_timer *timer = acquire();
+			timer->m_emission = new (timer->storage(sizeof(_timed_emission8<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy>))) _timed_emission8<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy>(&signal, a1, a2, a3, a4, a5, a6, a7, a8);
+			return start(timer, delay, 0);
+		}
+		
+		// Emits the signal every period ticks, starting period ticks from
+		// now, until the timer is cancelled. A period of 0 counts as 1.
+		template<class mt_policy>
+		TimerHandle every(unsigned long period, Signal0<mt_policy> &signal) {
+			_timer *timer = acquire();
+			timer->m_emission = new (timer->storage(sizeof(_timed_emission0<mt_policy>))) _timed_emission0<mt_policy>(&signal);
+			return start(timer, period, period != 0 ? period : 1);
+		}
+		
+		template<class arg1_type, class mt_policy>
+		TimerHandle every(unsigned long period, Signal1<arg1_type, mt_policy> &signal, arg1_type a1) {
+			_timer *timer = acquire();
+			timer->m_emission = new (timer->storage(sizeof(_timed_emission1<arg1_type, mt_policy>))) _timed_emission1<arg1_type, mt_policy>(&signal, a1);
+			return start(timer, period, period != 0 ? period : 1);
+		}
+		
+		template<class arg1_type, class arg2_type, class mt_policy>
+		TimerHandle every(unsigned long period, Signal2<arg1_type, arg2_type, mt_policy> &signal, arg1_type a1, arg2_type a2) {
+			_timer *timer = acquire();
+			timer->m_emission = new (timer->storage(sizeof(_timed_emission2<arg1_type, arg2_type, mt_policy>))) _timed_emission2<arg1_type, arg2_type, mt_policy>(&signal, a1, a2);
+			return start(timer, period, period != 0 ? period : 1);
+		}
+		
+		template<class arg1_type, class arg2_type, class arg3_type, class mt_policy>
+		TimerHandle every(unsigned long period, Signal3<arg1_type, arg2_type, arg3_type, mt_policy> &signal, arg1_type a1, arg2_type a2, arg3_type a3) {
+			_timer *timer = acquire();
+			timer->m_emission = new (timer->storage(sizeof(_timed_emission3<arg1_type, arg2_type, arg3_type, mt_policy>))) _timed_emission3<arg1_type, arg2_type, arg3_type, mt_policy>(&signal, a1, a2, a3);
+			return start(timer, period, period != 0 ? period : 1);
+		}
+		
+		template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class mt_policy>
+		TimerHandle every(unsigned long period, Signal4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy> &signal, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4) {
+			_timer *timer = acquire();
+			timer->m_emission = new (timer->storage(sizeof(_timed_emission4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>))) _timed_emission4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>(&signal, a1, a2, a3, a4);
+			return start(timer, period, period != 0 ? period : 1);
+		}
+		
+		template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class mt_policy>
+		TimerHandle every(unsigned long period, Signal5<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy> &signal, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5) {
+			_timer *timer = acquire();
+			timer->m_emission = new (timer->storage(sizeof(_timed_emission5<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy>))) _timed_emission5<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy>(&signal, a1, a2, a3, a4, a5);
+			return start(timer, period, period != 0 ? period : 1);
+		}
+		
+		template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class mt_policy>
+		TimerHandle every(unsigned long period, Signal6<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy> &signal, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6) {
+			_timer *timer = acquire();
+			timer->m_emission = new (timer->storage(sizeof(_timed_emission6<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy>))) _timed_emission6<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy>(&signal, a1, a2, a3, a4, a5, a6);
+			return start(timer, period, period != 0 ? period : 1);
+		}
+		
+		template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class arg7_type, class mt_policy>
+		TimerHandle every(unsigned long period, Signal7<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy> &signal, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6, arg7_type a7) {
+			_timer *timer = acquire();
+			timer->m_emission = new (timer->storage(sizeof(_timed_emission7<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy>))) _timed_emission7<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy>(&signal, a1, a2, a3, a4, a5, a6, a7);
+			return start(timer, period, period != 0 ? period : 1);
+		}
+		
+		template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class arg7_type, class arg8_type, class mt_policy>
+		TimerHandle every(unsigned long period, Signal8<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy> &signal, arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6, arg7_type a7, arg8_type a8) {
+			_timer *timer = acquire();
+			timer->m_emission = new (timer->storage(sizeof(_timed_emission8<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy>))) _timed_emission8<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy>(&signal, a1, a2, a3, a4, a5, a6, a7, a8);
+			return start(timer, period, period != 0 ? period : 1);
+		}
+		
+		// Stops the timer. Returns false if it had already fired for the last
+		// time or was cancelled. An emission already running is not waited
+		// for.
+		bool cancel(TimerHandle handle) {
+			lock_block<_monitor> lock(&m_monitor);
+			_timer *timer = handle.m_timer;
 			
-			while (it != itEnd) {
-				(*it)->getdest()->signalDisconnect(this);
-				delete *it;
-				
-				++it;
+			if (timer == NULL || timer->m_generation != handle.m_generation) {
+				return false;
 			}
 			
-			m_connected_slots.erase(m_connected_slots.begin(), m_connected_slots.end());
+			if (timer == m_firing) {
+				bool repeating = timer->m_period != 0;
+				timer->m_period = 0;
+				++timer->m_generation;
+				return repeating;
+			}
+			
+			timer->unlink();
+			release(timer);
+			--m_count;
+			return true;
 		}
 		
-		void disconnect(HasSlots<mt_policy>* pclass) {
-			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
-			
-			while (it != itEnd) {
-				if ((*it)->getdest() == pclass) {
-					delete *it;
-					m_connected_slots.erase(iterator(it++));
-					pclass->signalDisconnect(this);
-					continue;
-				}
-				
-				++it;
-			}
+		// Whether the timer will fire again.
+		bool isActive(TimerHandle handle) const {
+			lock_block<_monitor> lock(&m_monitor);
+			return handle.m_timer != NULL && handle.m_timer->m_generation == handle.m_generation && (handle.m_timer != m_firing || handle.m_timer->m_period != 0);
 		}
 		
-		void slot_disconnect(HasSlots<mt_policy>* pslot) {
-			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
-			
-			while (it != itEnd) {
-				iterator itNext = it;
-				++itNext;
-				
-				if ((*it)->getdest() == pslot) {
-					delete *it;
-					m_connected_slots.erase(it);
-				}
-				
-				it = itNext;
-			}
+		// Number of timers started and not done yet.
+		std::size_t pending() const {
+			lock_block<_monitor> lock(&m_monitor);
+			return m_count;
 		}
 		
-	protected:
-		connections_list m_connected_slots;
-	};
-	
-	template < class arg1_type, class arg2_type, class arg3_type, class arg4_type,
-	class arg5_type, class arg6_type, class mt_policy >
-	class _signal_base6 : public _signal_base<mt_policy> {
-	public:
-		typedef std::list < _connection_base6 < arg1_type, arg2_type, arg3_type,
-		arg4_type, arg5_type, arg6_type, mt_policy > * >  connections_list;
-		typedef typename connections_list::const_iterator const_iterator;
-		typedef typename connections_list::iterator iterator;
+		// Ticks elapsed so far.
+		unsigned long now() const {
+			lock_block<_monitor> lock(&m_monitor);
+			return m_tick;
+		}
 		
-		_signal_base6() {
-			;
+		// Moves time forward by the given number of ticks and fires the
+		// timers that expire meanwhile. Returns the number of emissions.
+		std::size_t advance(unsigned long ticks) {
+			lock_block<_monitor> lock(&m_monitor);
+			return step(ticks);
 		}
 		
-		_signal_base6(const _signal_base6 < arg1_type, arg2_type, arg3_type, arg4_type,
-		              arg5_type, arg6_type, mt_policy > & s)
-		: _signal_base<mt_policy>(s) {
-			lock_block<mt_policy> lock(this);
-			const_iterator it = s.m_connected_slots.begin();
-			const_iterator itEnd = s.m_connected_slots.end();
-			
-			while (it != itEnd) {
-				(*it)->getdest()->signalConnect(this);
-				m_connected_slots.push_back((*it)->clone());
-				
-				++it;
-			}
+		// Advances by the ticks of real time elapsed since the last call.
+		std::size_t update() {
+			lock_block<_monitor> lock(&m_monitor);
+			return step(target() - m_tick);
 		}
 		
-		void slot_duplicate(const HasSlots<mt_policy>* oldtarget, HasSlots<mt_policy>* newtarget) {
-			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
+#ifndef _SIGLY_SINGLE_THREADED
+		// Fires timers as their time comes until quit() is called. Sleeps
+		// until the earliest timer is due, or while none is pending.
+		void exec() {
+			lock_block<_monitor> lock(&m_monitor);
 			
-			while (it != itEnd) {
-				if ((*it)->getdest() == oldtarget) {
-					m_connected_slots.push_back((*it)->duplicate(newtarget));
+			for (;;) {
+				step(target() - m_tick);
+				
+				if (m_quit) {
+					break;
 				}
 				
-				++it;
+				if (m_count == 0) {
+					m_monitor.wait();
+				} else {
+					m_wake = m_tick + untilNext();
+					double left = (double)m_wake * m_resolution + m_origin - _now();
+					
+					if (left > 0) {
+						m_sleeping = true;
+						m_monitor.wait(left);
+						m_sleeping = false;
+					}
+				}
+				
+				if (m_quit) {
+					break;
+				}
 			}
+			
+			m_quit = false;
 		}
 		
-		~_signal_base6() {
-			disconnectAll();
+		// Makes exec() return.
+		void quit() {
+			m_monitor.lock();
+			m_quit = true;
+			m_monitor.notifyAll();
+			m_monitor.unlock();
 		}
+#endif // _SIGLY_SINGLE_THREADED
 		
-		void disconnectAll() {
-			lock_block<mt_policy> lock(this);
-			const_iterator it = m_connected_slots.begin();
-			const_iterator itEnd = m_connected_slots.end();
+	private:
+		// The first level has one slot per tick, and every other level one
+		// slot per turn of the level below it, for 2^32 ticks in all.
+		enum {
+			WHEEL_BITS = 8,
+			LEVEL_BITS = 6,
+			LEVELS = 4,
+			WHEEL = 1 << WHEEL_BITS,
+			LEVEL = 1 << LEVEL_BITS,
+			SLOTS = WHEEL + LEVELS * LEVEL
+		};
+		
+		// The tick that real time has reached, or the current one if
+		// advance() moved past it. Called with the scheduler locked, so
+		// that no other thread moves time between reading the clock and
+		// stepping to it.
+		unsigned long target() const {
+			unsigned long tick = (unsigned long)((_now() - m_origin) / m_resolution);
+			return (long)(tick - m_tick) > 0 ? tick : m_tick;
+		}
+		
+		// advance() with the scheduler locked.
+		std::size_t step(unsigned long ticks) {
+			std::size_t count = 0;
 			
-			while (it != itEnd) {
-				(*it)->getdest()->signalDisconnect(this);
-				delete *it;
+			// Timers left due by a slot that threw fire first.
+			for (;;) {
+				while (m_due != NULL) {
+					_timer *timer = m_due;
+					timer->unlink();
+					fire(timer);
+					++count;
+				}
 				
-				++it;
+				// The ticks before the next one that fires or cascades a
+				// timer only move time forward.
+				unsigned long idle = m_count != 0 ? untilNext() - 1 : ticks;
+				idle = idle < ticks ? idle : ticks;
+				m_tick += idle;
+				ticks -= idle;
+				
+				if (ticks-- == 0) {
+					break;
+				}
+				
+				_timer *&slot = m_wheel[m_tick & (WHEEL - 1)];
+				std::size_t index = m_tick & (WHEEL - 1);
+				
+				for (std::size_t level = 0; index == 0 && level < LEVELS; ++level) {
+					index = cascade(level);
+				}
+				
+				++m_tick;
+				
+				if (slot != NULL) {
+					m_due = slot;
+					m_due->m_link = &m_due;
+					slot = NULL;
+				}
 			}
 			
-			m_connected_slots.erase(m_connected_slots.begin(), m_connected_slots.end());
+			return count;
 		}
 		
-		void disconnect(HasSlots<mt_policy>* pclass) {
-			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
+		// Number of ticks to advance until the first one that fires a timer
+		// or cascades one from the levels above the first, at least 1. Only
+		// called with timers pending and none due.
+		unsigned long untilNext() const {
+			std::size_t index = m_tick & (WHEEL - 1);
+			// The most the wheel can tell apart, when it is empty.
+			unsigned long ticks = 0xffffffffUL;
 			
-			while (it != itEnd) {
-				if ((*it)->getdest() == pclass) {
-					delete *it;
-					m_connected_slots.erase(iterator(it++));
-					pclass->signalDisconnect(this);
-					continue;
+			for (std::size_t i = 0; i < WHEEL; ++i) {
+				if (m_wheel[(index + i) & (WHEEL - 1)] != NULL) {
+					ticks = i + 1;
+					break;
 				}
-				
-				++it;
 			}
-		}
-		
-		void slot_disconnect(HasSlots<mt_policy>* pslot) {
-			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
 			
-			while (it != itEnd) {
-				iterator itNext = it;
-				++itNext;
+			// A slot of a level cascades on the first tick whose bits below
+			// the level are all 0 and whose bits of the level are the slot
+			// index.
+			for (std::size_t level = 0; level < LEVELS; ++level) {
+				std::size_t shift = WHEEL_BITS + level * LEVEL_BITS;
+				unsigned long unit = 1UL << shift;
+				unsigned long first = (m_tick + unit - 1) & ~(unit - 1);
 				
-				if ((*it)->getdest() == pslot) {
-					delete *it;
-					m_connected_slots.erase(it);
+				for (std::size_t i = 0; i < LEVEL; ++i) {
+					if (m_wheel[WHEEL + level * LEVEL + i] != NULL) {
+						unsigned long cascade = first + ((i - (first >> shift)) & (LEVEL - 1)) * unit - m_tick + 1;
+						ticks = cascade < ticks ? cascade : ticks;
+					}
 				}
-				
-				it = itNext;
 			}
+			
+			return ticks;
 		}
 		
-	protected:
-		connections_list m_connected_slots;
-	};
-	
-	template < class arg1_type, class arg2_type, class arg3_type, class arg4_type,
-	class arg5_type, class arg6_type, class arg7_type, class mt_policy >
-	class _signal_base7 : public _signal_base<mt_policy> {
-	public:
-		typedef std::list < _connection_base7 < arg1_type, arg2_type, arg3_type,
-		arg4_type, arg5_type, arg6_type, arg7_type, mt_policy > * >  connections_list;
-		typedef typename connections_list::const_iterator const_iterator;
-		typedef typename connections_list::iterator iterator;
+		_timer *acquire() {
+			lock_block<_monitor> lock(&m_monitor);
+			_timer *timer = m_idle;
+			
+			if (timer != NULL) {
+				timer->unlink();
+			} else {
+				timer = new _timer();
+			}
+			
+			return timer;
+		}
 		
-		_signal_base7() {
-			;
+		void release(_timer *timer) {
+			timer->clear();
+			++timer->m_generation;
+			timer->link(m_idle);
 		}
 		
-		_signal_base7(const _signal_base7 < arg1_type, arg2_type, arg3_type, arg4_type,
-		              arg5_type, arg6_type, arg7_type, mt_policy > & s)
-		: _signal_base<mt_policy>(s) {
-			lock_block<mt_policy> lock(this);
-			const_iterator it = s.m_connected_slots.begin();
-			const_iterator itEnd = s.m_connected_slots.end();
+		TimerHandle start(_timer *timer, unsigned long delay, unsigned long period) {
+			lock_block<_monitor> lock(&m_monitor);
+			// While exec() sleeps, the current tick lags behind real time.
+			timer->m_expires = (m_sleeping ? target() : m_tick) + (delay != 0 ? delay - 1 : 0);
+			timer->m_period = period;
+			insert(timer);
 			
-			while (it != itEnd) {
-				(*it)->getdest()->signalConnect(this);
-				m_connected_slots.push_back((*it)->clone());
-				
-				++it;
+			// Wakes exec() if it sleeps past the new timer.
+			if (m_count++ == 0 || (m_sleeping && (long)(timer->m_expires + 1 - m_wake) < 0)) {
+				m_monitor.notifyAll();
 			}
+			
+			return TimerHandle(timer);
 		}
 		
-		void slot_duplicate(const HasSlots<mt_policy>* oldtarget, HasSlots<mt_policy>* newtarget) {
-			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
+		// Puts the timer in the slot of the coarsest level that still tells
+		// its expiry apart from the current tick.
+		void insert(_timer *timer) {
+			unsigned long delta = timer->m_expires - m_tick;
 			
-			while (it != itEnd) {
-				if ((*it)->getdest() == oldtarget) {
-					m_connected_slots.push_back((*it)->duplicate(newtarget));
-				}
-				
-				++it;
+			if ((long)delta < 0) {
+				timer->link(m_wheel[m_tick & (WHEEL - 1)]);
+				return;
 			}
+			
+			if (delta < WHEEL) {
+				timer->link(m_wheel[timer->m_expires & (WHEEL - 1)]);
+				return;
+			}
+			
+			if (delta > 0xffffffffUL) {
+				timer->m_expires = m_tick + 0xffffffffUL;
+			}
+			
+			std::size_t level = 0;
+			
+			while (level + 1 < LEVELS && delta >= 1UL << (WHEEL_BITS + (level + 1) * LEVEL_BITS)) {
+				++level;
+			}
+			
+			std::size_t index = (timer->m_expires >> (WHEEL_BITS + level * LEVEL_BITS)) & (LEVEL - 1);
+			timer->link(m_wheel[WHEEL + level * LEVEL + index]);
 		}
 		
-		~_signal_base7() {
-			disconnectAll();
-		}
-		
-		void disconnectAll() {
-			lock_block<mt_policy> lock(this);
-			const_iterator it = m_connected_slots.begin();
-			const_iterator itEnd = m_connected_slots.end();
+		// Spreads the timers of the level's current slot over the levels
+		// below it. Returns the slot index, which is 0 when the level has
+		// turned and the next one has to cascade too.
+		std::size_t cascade(std::size_t level) {
+			std::size_t index = (m_tick >> (WHEEL_BITS + level * LEVEL_BITS)) & (LEVEL - 1);
+			_timer *&slot = m_wheel[WHEEL + level * LEVEL + index];
 			
-			while (it != itEnd) {
-				(*it)->getdest()->signalDisconnect(this);
-				delete *it;
-				
-				++it;
+			while (slot != NULL) {
+				_timer *timer = slot;
+				timer->unlink();
+				insert(timer);
 			}
 			
-			m_connected_slots.erase(m_connected_slots.begin(), m_connected_slots.end());
+			return index;
 		}
 		
-		void disconnect(HasSlots<mt_policy>* pclass) {
-			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
+		// Emits with the scheduler unlocked, then puts a periodic timer
+		// back in the wheel unless it was cancelled meanwhile.
+		void fire(_timer *timer) {
+			m_firing = timer;
+			m_monitor.unlock();
 			
-			while (it != itEnd) {
-				if ((*it)->getdest() == pclass) {
-					delete *it;
-					m_connected_slots.erase(iterator(it++));
-					pclass->signalDisconnect(this);
-					continue;
-				}
-				
-				++it;
+			try {
+				timer->m_emission->fire();
+			} catch (...) {
+				m_monitor.lock();
+				done(timer);
+				throw;
 			}
+			
+			m_monitor.lock();
+			done(timer);
 		}
 		
-		void slot_disconnect(HasSlots<mt_policy>* pslot) {
-			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
+		void done(_timer *timer) {
+			m_firing = NULL;
 			
-			while (it != itEnd) {
-				iterator itNext = it;
-				++itNext;
-				
-				if ((*it)->getdest() == pslot) {
-					delete *it;
-					m_connected_slots.erase(it);
-				}
-				
-				it = itNext;
+			if (timer->m_period != 0) {
+				timer->m_expires += timer->m_period;
+				insert(timer);
+			} else {
+				release(timer);
+				--m_count;
 			}
 		}
 		
-	protected:
-		connections_list m_connected_slots;
+		static void destroy(_timer *list) {
+			while (list != NULL) {
+				_timer *timer = list;
+				list = timer->m_next;
+				timer->clear();
+				delete timer;
+			}
+		}
+		
+		Scheduler(const Scheduler &);
+		Scheduler &operator=(const Scheduler &);
+		
+		mutable _monitor m_monitor;
+		_timer *m_wheel[SLOTS];
+		unsigned long m_tick;
+		std::size_t m_count;
+		// Expired timers that have yet to fire.
+		_timer *m_due;
+		_timer *m_firing;
+		_timer *m_idle;
+		double m_resolution;
+		double m_origin;
+		bool m_quit;
+		// Whether exec() sleeps until the tick m_wake.
+		bool m_sleeping;
+		unsigned long m_wake;
 	};
 	
-	template < class arg1_type, class arg2_type, class arg3_type, class arg4_type,
-	class arg5_type, class arg6_type, class arg7_type, class arg8_type, class mt_policy >
-	class _signal_base8 : public _signal_base<mt_policy> {
+#if defined(SIGLY_ENABLE_RECORDING) || defined(SIGLY_ENABLE_SHARED_MEMORY)
+	// A file mapped into memory, or on platforms without mappings a buffer
+	// that is read from or written to the file as a whole.
+	class _mapped_file {
 	public:
-		typedef std::list < _connection_base8 < arg1_type, arg2_type, arg3_type,
-		arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy > * >
-		connections_list;
-		typedef typename connections_list::const_iterator const_iterator;
-		typedef typename connections_list::iterator iterator;
+		_mapped_file(): m_base(NULL), m_size(0), m_writable(false) {
+#if defined(_SIGLY_HAS_WIN32_THREADS)
+			m_file = INVALID_HANDLE_VALUE;
+			m_mapping = NULL;
+#elif defined(_SIGLY_HAS_POSIX_THREADS)
+			m_fd = -1;
+#endif
+		}
 		
-		_signal_base8() {
-			;
+		~_mapped_file() {
+			close(m_size);
 		}
 		
-		_signal_base8(const _signal_base8 < arg1_type, arg2_type, arg3_type, arg4_type,
-		              arg5_type, arg6_type, arg7_type, arg8_type, mt_policy > & s)
-		: _signal_base<mt_policy>(s) {
-			lock_block<mt_policy> lock(this);
-			const_iterator it = s.m_connected_slots.begin();
-			const_iterator itEnd = s.m_connected_slots.end();
+		// Maps the file, which is created or truncated to size bytes when
+		// writable, and mapped whole otherwise.
+		bool open(const char *path, std::size_t size, bool writable) {
+			m_writable = writable;
+#if defined(_SIGLY_HAS_WIN32_THREADS)
+			m_file = CreateFileA(path, writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ, FILE_SHARE_READ, NULL, writable ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
 			
-			while (it != itEnd) {
-				(*it)->getdest()->signalConnect(this);
-				m_connected_slots.push_back((*it)->clone());
-				
-				++it;
+			if (m_file == INVALID_HANDLE_VALUE) {
+				return false;
 			}
-		}
-		
-		void slot_duplicate(const HasSlots<mt_policy>* oldtarget, HasSlots<mt_policy>* newtarget) {
-			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
 			
-			while (it != itEnd) {
-				if ((*it)->getdest() == oldtarget) {
-					m_connected_slots.push_back((*it)->duplicate(newtarget));
+			if (!writable) {
+				LARGE_INTEGER length;
+				GetFileSizeEx(m_file, &length);
+				size = (std::size_t)length.QuadPart;
+			}
+			
+			ULARGE_INTEGER length;
+			length.QuadPart = size;
+			m_mapping = size != 0 ? CreateFileMappingA(m_file, NULL, writable ? PAGE_READWRITE : PAGE_READONLY, length.HighPart, length.LowPart, NULL) : NULL;
+			m_base = m_mapping != NULL ? static_cast<char *>(MapViewOfFile(m_mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, size)) : NULL;
+#elif defined(_SIGLY_HAS_POSIX_THREADS)
+			m_fd = ::open(path, writable ? O_RDWR | O_CREAT | O_TRUNC : O_RDONLY, 0644);
+			
+			if (m_fd < 0) {
+				return false;
+			}
+			
+			struct stat status;
+			
+			if (writable ? ftruncate(m_fd, (off_t)size) != 0 : fstat(m_fd, &status) != 0) {
+				size = 0;
+			} else if (!writable) {
+				size = (std::size_t)status.st_size;
+			}
+			
+			void *base = size != 0 ? mmap(NULL, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, m_fd, 0) : MAP_FAILED;
+			m_base = base != MAP_FAILED ? static_cast<char *>(base) : NULL;
+#else
+			m_path = path;
+			
+			if (writable) {
+				std::FILE *file = std::fopen(path, "wb");
+				
+				if (file != NULL) {
+					std::fclose(file);
+					m_base = new char[size]();
 				}
+			} else if (std::FILE *file = std::fopen(path, "rb")) {
+				std::fseek(file, 0, SEEK_END);
+				long length = std::ftell(file);
+				std::fseek(file, 0, SEEK_SET);
 				
-				++it;
+				if (length > 0) {
+					size = (std::size_t)length;
+					m_base = new char[size];
+					
+					if (std::fread(m_base, 1, size, file) != size) {
+						delete [] m_base;
+						m_base = NULL;
+					}
+				}
+				
+				std::fclose(file);
 			}
-		}
-		
-		~_signal_base8() {
-			disconnectAll();
-		}
-		
-		void disconnectAll() {
-			lock_block<mt_policy> lock(this);
-			const_iterator it = m_connected_slots.begin();
-			const_iterator itEnd = m_connected_slots.end();
+#endif
 			
-			while (it != itEnd) {
-				(*it)->getdest()->signalDisconnect(this);
-				delete *it;
-				
-				++it;
+			if (m_base == NULL) {
+				close(0);
+				return false;
 			}
 			
-			m_connected_slots.erase(m_connected_slots.begin(), m_connected_slots.end());
+			m_size = size;
+			return true;
+		}
+		
+#ifdef SIGLY_ENABLE_SHARED_MEMORY
+		// Maps the POSIX shared memory object of that name, creating it with
+		// size bytes if it does not exist. Fails if it exists with another
+		// size.
+		bool openShared(const char *name, std::size_t size) {
+			m_writable = false;
+			m_fd = shm_open(name, O_RDWR | O_CREAT, 0600);
+			struct stat status;
+			
+			if (m_fd >= 0 && fstat(m_fd, &status) == 0 && (status.st_size == (off_t)size || (status.st_size == 0 && ftruncate(m_fd, (off_t)size) == 0))) {
+				void *base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+				m_base = base != MAP_FAILED ? static_cast<char *>(base) : NULL;
+			}
+			
+			if (m_base == NULL) {
+				close(0);
+				return false;
+			}
+			
+			m_size = size;
+			return true;
 		}
 		
-		void disconnect(HasSlots<mt_policy>* pclass) {
-			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
+#endif
+		// Writes the changes to the file, keeping its first length bytes.
+		void close(std::size_t length) {
+#if defined(_SIGLY_HAS_WIN32_THREADS)
+			if (m_base != NULL) {
+				UnmapViewOfFile(m_base);
+			}
 			
-			while (it != itEnd) {
-				if ((*it)->getdest() == pclass) {
-					delete *it;
-					m_connected_slots.erase(iterator(it++));
-					pclass->signalDisconnect(this);
-					continue;
+			if (m_mapping != NULL) {
+				CloseHandle(m_mapping);
+			}
+			
+			if (m_file != INVALID_HANDLE_VALUE) {
+				if (m_writable) {
+					LARGE_INTEGER end;
+					end.QuadPart = length;
+					SetFilePointerEx(m_file, end, NULL, FILE_BEGIN);
+					SetEndOfFile(m_file);
 				}
 				
-				++it;
+				CloseHandle(m_file);
 			}
-		}
-		
-		void slot_disconnect(HasSlots<mt_policy>* pslot) {
-			lock_block<mt_policy> lock(this);
-			iterator it = m_connected_slots.begin();
-			iterator itEnd = m_connected_slots.end();
 			
-			while (it != itEnd) {
-				iterator itNext = it;
-				++itNext;
-				
-				if ((*it)->getdest() == pslot) {
-					delete *it;
-					m_connected_slots.erase(it);
+			m_file = INVALID_HANDLE_VALUE;
+			m_mapping = NULL;
+#elif defined(_SIGLY_HAS_POSIX_THREADS)
+			if (m_base != NULL) {
+				munmap(m_base, m_size);
+			}
+			
+			if (m_fd >= 0) {
+				if (m_writable && ftruncate(m_fd, (off_t)length) != 0) {
+					// The file keeps its mapped size; readers stop at the end
+					// recorded in its header.
 				}
 				
-				it = itNext;
+				::close(m_fd);
 			}
+			
+			m_fd = -1;
+#else
+			if (m_base != NULL && m_writable) {
+				if (std::FILE *file = std::fopen(m_path.c_str(), "wb")) {
+					std::fwrite(m_base, 1, length, file);
+					std::fclose(file);
+				}
+			}
+			
+			delete [] m_base;
+#endif
+			m_base = NULL;
+			m_size = 0;
 		}
 		
-	protected:
-		connections_list m_connected_slots;
+		char *base() const {
+			return m_base;
+		}
+		
+		std::size_t size() const {
+			return m_size;
+		}
+		
+	private:
+		_mapped_file(const _mapped_file &);
+		_mapped_file &operator=(const _mapped_file &);
+		
+		char *m_base;
+		std::size_t m_size;
+		bool m_writable;
+#if defined(_SIGLY_HAS_WIN32_THREADS)
+		HANDLE m_file;
+		HANDLE m_mapping;
+#elif defined(_SIGLY_HAS_POSIX_THREADS)
+		int m_fd;
+#else
+		std::string m_path;
+#endif
+	};
+	
+	// Each record is followed by the bytes of the emission's arguments, and
+	// padded to a multiple of sizeof(_record). A record's size, which counts
+	// the record and the arguments but not the padding, is written last, so a
+	// reader that finds 0 has reached the end of what was written.
+	struct _record {
+		volatile long size;
+		unsigned long signal;
+		// Microseconds since the recorder was opened.
+		double time;
 	};
 	
+	inline long _record_size(std::size_t payload) {
+		return (long)((sizeof(_record) + payload + sizeof(_record) - 1) / sizeof(_record) * sizeof(_record));
+	}
 	
-	template<class dest_type, class mt_policy>
-	class _connection0 : public _connection_base0<mt_policy> {
+	template<class value_type>
+	void _record_put(char *&payload, const value_type &value) {
+		std::memcpy(payload, &value, sizeof(value));
+		payload += sizeof(value);
+	}
+	
+	template<class value_type>
+	void _record_get(const char *&payload, value_type &value) {
+		std::memcpy(&value, payload, sizeof(value));
+		payload += sizeof(value);
+	}
+	
+	// Where the taps write the emissions they serialize.
+	class _record_sink {
 	public:
-		_connection0() {
-			this->pobject = NULL;
-			this->pmemfun = NULL;
+		virtual ~_record_sink() {
 		}
 		
-		_connection0(dest_type *pobject, void (dest_type::*pmemfun)()) {
-			m_pobject = pobject;
-			m_pmemfun = pmemfun;
-		}
+		// Space for the arguments of one emission, or NULL to drop it.
+		virtual char *reserve(unsigned long signal, std::size_t payload) = 0;
 		
-		virtual _connection_base0<mt_policy>* clone() {
-			return new _connection0<dest_type, mt_policy>(*this);
+		// Publishes the record once its arguments are written.
+		virtual void commit(char *payload, std::size_t size) = 0;
+	};
+	
+	// Receiver connected to a signal whose emissions are serialized.
+	class _record_tap {
+	public:
+		_record_tap(_record_sink *sink, unsigned long signal): m_sink(sink), m_signal(signal) {
 		}
 		
-		virtual _connection_base0<mt_policy>* duplicate(HasSlots<mt_policy>* pnewdest) {
-			return new _connection0<dest_type, mt_policy>((dest_type *)pnewdest, m_pmemfun);
+		virtual ~_record_tap() {
 		}
 		
-		virtual void shoot() {
-			(m_pobject->*m_pmemfun)();
+	protected:
+		_record_sink *m_sink;
+		unsigned long m_signal;
+	};
+	
+	template<class mt_policy>
+	class _record_tap0 : public HasSlots<mt_policy>, public _record_tap {
+	public:
+		_record_tap0(_record_sink *sink, unsigned long signal): _record_tap(sink, signal) {
 		}
 		
-		virtual HasSlots<mt_policy>* getdest() const {
-			return m_pobject;
+		void shoot() {
+			std::size_t size = 0;
+			char *payload = m_sink->reserve(m_signal, size);
+			
+			if (payload != NULL) {
+				m_sink->commit(payload, size);
+			}
 		}
-		
-	private:
-		dest_type *m_pobject;
-		void (dest_type::* m_pmemfun)();
 	};
 	
-	template<class dest_type, class arg1_type, class mt_policy>
-	class _connection1 : public _connection_base1<arg1_type, mt_policy> {
+	template<class arg1_type, class mt_policy>
+	class _record_tap1 : public HasSlots<mt_policy>, public _record_tap {
 	public:
-		_connection1() {
-			this->pobject = NULL;
-			this->pmemfun = NULL;
+		_record_tap1(_record_sink *sink, unsigned long signal): _record_tap(sink, signal) {
 		}
 		
-		_connection1(dest_type *pobject, void (dest_type::*pmemfun)(arg1_type)) {
-			m_pobject = pobject;
-			m_pmemfun = pmemfun;
+		void shoot(arg1_type a1) {
+			std::size_t size = sizeof(typename _value_type<arg1_type>::type);
+			char *payload = m_sink->reserve(m_signal, size);
+			
+			if (payload != NULL) {
+				char *at = payload;
+				_record_put(at, a1);
+				m_sink->commit(payload, size);
+			}
 		}
-		
-		virtual _connection_base1<arg1_type, mt_policy>* clone() {
-			return new _connection1<dest_type, arg1_type, mt_policy>(*this);
+	};
+	
+	template<class arg1_type, class arg2_type, class mt_policy>
+	class _record_tap2 : public HasSlots<mt_policy>, public _record_tap {
+	public:
+		_record_tap2(_record_sink *sink, unsigned long signal): _record_tap(sink, signal) {
 		}
 		
-		virtual _connection_base1<arg1_type, mt_policy>* duplicate(HasSlots<mt_policy>* pnewdest) {
-			return new _connection1<dest_type, arg1_type, mt_policy>((dest_type *)pnewdest, m_pmemfun);
+		void shoot(arg1_type a1, arg2_type a2) {
+			std::size_t size = sizeof(typename _value_type<arg1_type>::type) + sizeof(typename _value_type<arg2_type>::type);
+			char *payload = m_sink->reserve(m_signal, size);
+			
+			if (payload != NULL) {
+				char *at = payload;
+				_record_put(at, a1);
+				_record_put(at, a2);
+				m_sink->commit(payload, size);
+			}
 		}
-		
-		virtual void shoot(arg1_type a1) {
-			(m_pobject->*m_pmemfun)(a1);
+	};
+	
+	template<class arg1_type, class arg2_type, class arg3_type, class mt_policy>
+	class _record_tap3 : public HasSlots<mt_policy>, public _record_tap {
+	public:
+		_record_tap3(_record_sink *sink, unsigned long signal): _record_tap(sink, signal) {
 		}
 		
-		virtual HasSlots<mt_policy>* getdest() const {
-			return m_pobject;
+		void shoot(arg1_type a1, arg2_type a2, arg3_type a3) {
+			std::size_t size = sizeof(typename _value_type<arg1_type>::type) + sizeof(typename _value_type<arg2_type>::type) + sizeof(typename _value_type<arg3_type>::type);
+			char *payload = m_sink->reserve(m_signal, size);
+			
+			if (payload != NULL) {
+				char *at = payload;
+				_record_put(at, a1);
+				_record_put(at, a2);
+				_record_put(at, a3);
+				m_sink->commit(payload, size);
+			}
 		}
-		
-	private:
-		dest_type *m_pobject;
-		void (dest_type::* m_pmemfun)(arg1_type);
 	};
 	
-	template<class dest_type, class arg1_type, class arg2_type, class mt_policy>
-	class _connection2 : public _connection_base2<arg1_type, arg2_type, mt_policy> {
+	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class mt_policy>
+	class _record_tap4 : public HasSlots<mt_policy>, public _record_tap {
 	public:
-		_connection2() {
-			this->pobject = NULL;
-			this->pmemfun = NULL;
+		_record_tap4(_record_sink *sink, unsigned long signal): _record_tap(sink, signal) {
 		}
 		
-		_connection2(dest_type *pobject, void (dest_type::*pmemfun)(arg1_type,
-		                                                            arg2_type)) {
-			m_pobject = pobject;
-			m_pmemfun = pmemfun;
+		void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4) {
+			std::size_t size = sizeof(typename _value_type<arg1_type>::type) + sizeof(typename _value_type<arg2_type>::type) + sizeof(typename _value_type<arg3_type>::type) + sizeof(typename _value_type<arg4_type>::type);
+			char *payload = m_sink->reserve(m_signal, size);
+			
+			if (payload != NULL) {
+				char *at = payload;
+				_record_put(at, a1);
+				_record_put(at, a2);
+				_record_put(at, a3);
+				_record_put(at, a4);
+				m_sink->commit(payload, size);
+			}
 		}
-		
-		virtual _connection_base2<arg1_type, arg2_type, mt_policy>* clone() {
-			return new _connection2<dest_type, arg1_type, arg2_type, mt_policy>(*this);
+	};
+	
+	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class mt_policy>
+	class _record_tap5 : public HasSlots<mt_policy>, public _record_tap {
+	public:
+		_record_tap5(_record_sink *sink, unsigned long signal): _record_tap(sink, signal) {
 		}
 		
-		virtual _connection_base2<arg1_type, arg2_type, mt_policy>* duplicate(HasSlots<mt_policy>* pnewdest) {
-			return new _connection2<dest_type, arg1_type, arg2_type, mt_policy>((dest_type *)pnewdest, m_pmemfun);
+		void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5) {
+			std::size_t size = sizeof(typename _value_type<arg1_type>::type) + sizeof(typename _value_type<arg2_type>::type) + sizeof(typename _value_type<arg3_type>::type) + sizeof(typename _value_type<arg4_type>::type) + sizeof(typename _value_type<arg5_type>::type);
+			char *payload = m_sink->reserve(m_signal, size);
+			
+			if (payload != NULL) {
+				char *at = payload;
+				_record_put(at, a1);
+				_record_put(at, a2);
+				_record_put(at, a3);
+				_record_put(at, a4);
+				_record_put(at, a5);
+				m_sink->commit(payload, size);
+			}
 		}
-		
-		virtual void shoot(arg1_type a1, arg2_type a2) {
-			(m_pobject->*m_pmemfun)(a1, a2);
+	};
+	
+	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class mt_policy>
+	class _record_tap6 : public HasSlots<mt_policy>, public _record_tap {
+	public:
+		_record_tap6(_record_sink *sink, unsigned long signal): _record_tap(sink, signal) {
 		}
 		
-		virtual HasSlots<mt_policy>* getdest() const {
-			return m_pobject;
+		void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6) {
+			std::size_t size = sizeof(typename _value_type<arg1_type>::type) + sizeof(typename _value_type<arg2_type>::type) + sizeof(typename _value_type<arg3_type>::type) + sizeof(typename _value_type<arg4_type>::type) + sizeof(typename _value_type<arg5_type>::type) + sizeof(typename _value_type<arg6_type>::type);
+			char *payload = m_sink->reserve(m_signal, size);
+			
+			if (payload != NULL) {
+				char *at = payload;
+				_record_put(at, a1);
+				_record_put(at, a2);
+				_record_put(at, a3);
+				_record_put(at, a4);
+				_record_put(at, a5);
+				_record_put(at, a6);
+				m_sink->commit(payload, size);
+			}
+		}
+	};
+	
+	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class arg7_type, class mt_policy>
+	class _record_tap7 : public HasSlots<mt_policy>, public _record_tap {
+	public:
+		_record_tap7(_record_sink *sink, unsigned long signal): _record_tap(sink, signal) {
 		}
 		
-	private:
-		dest_type *m_pobject;
-		void (dest_type::* m_pmemfun)(arg1_type, arg2_type);
+		void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6, arg7_type a7) {
+			std::size_t size = sizeof(typename _value_type<arg1_type>::type) + sizeof(typename _value_type<arg2_type>::type) + sizeof(typename _value_type<arg3_type>::type) + sizeof(typename _value_type<arg4_type>::type) + sizeof(typename _value_type<arg5_type>::type) + sizeof(typename _value_type<arg6_type>::type) + sizeof(typename _value_type<arg7_type>::type);
+			char *payload = m_sink->reserve(m_signal, size);
+			
+			if (payload != NULL) {
+				char *at = payload;
+				_record_put(at, a1);
+				_record_put(at, a2);
+				_record_put(at, a3);
+				_record_put(at, a4);
+				_record_put(at, a5);
+				_record_put(at, a6);
+				_record_put(at, a7);
+				m_sink->commit(payload, size);
+			}
+		}
 	};
 	
-	template<class dest_type, class arg1_type, class arg2_type, class arg3_type, class mt_policy>
-	class _connection3 : public _connection_base3<arg1_type, arg2_type, arg3_type, mt_policy> {
+	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class arg7_type, class arg8_type, class mt_policy>
+	class _record_tap8 : public HasSlots<mt_policy>, public _record_tap {
 	public:
-		_connection3() {
-			this->pobject = NULL;
-			this->pmemfun = NULL;
+		_record_tap8(_record_sink *sink, unsigned long signal): _record_tap(sink, signal) {
 		}
 		
-		_connection3(dest_type *pobject, void (dest_type::*pmemfun)(arg1_type,
-		                                                            arg2_type, arg3_type)) {
-			m_pobject = pobject;
-			m_pmemfun = pmemfun;
+		void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4, arg5_type a5, arg6_type a6, arg7_type a7, arg8_type a8) {
+			std::size_t size = sizeof(typename _value_type<arg1_type>::type) + sizeof(typename _value_type<arg2_type>::type) + sizeof(typename _value_type<arg3_type>::type) + sizeof(typename _value_type<arg4_type>::type) + sizeof(typename _value_type<arg5_type>::type) + sizeof(typename _value_type<arg6_type>::type) + sizeof(typename _value_type<arg7_type>::type) + sizeof(typename _value_type<arg8_type>::type);
+			char *payload = m_sink->reserve(m_signal, size);
+			
+			if (payload != NULL) {
+				char *at = payload;
+				_record_put(at, a1);
+				_record_put(at, a2);
+				_record_put(at, a3);
+				_record_put(at, a4);
+				_record_put(at, a5);
+				_record_put(at, a6);
+				_record_put(at, a7);
+				_record_put(at, a8);
+				m_sink->commit(payload, size);
+			}
+		}
+	};
+	
+	// Owner of the taps that serialize the emissions of signals into a sink.
+	class _record_source {
+	public:
+		_record_source(_record_sink *sink): m_sink(sink) {
 		}
 		
-		virtual _connection_base3<arg1_type, arg2_type, arg3_type, mt_policy>* clone() {
-			return new _connection3<dest_type, arg1_type, arg2_type, arg3_type, mt_policy>(*this);
+		template<class mt_policy>
+		void record(Signal0<mt_policy> &signal, unsigned long id) {
+			_record_tap0<mt_policy> *tap = new _record_tap0<mt_policy>(m_sink, id);
+			m_taps.push_back(tap);
+			signal.connect(tap, &_record_tap0<mt_policy>::shoot);
 		}
 		
-		virtual _connection_base3<arg1_type, arg2_type, arg3_type, mt_policy>* duplicate(HasSlots<mt_policy>* pnewdest) {
-			return new _connection3<dest_type, arg1_type, arg2_type, arg3_type, mt_policy>((dest_type *)pnewdest, m_pmemfun);
+		template<class arg1_type, class mt_policy>
+		void record(Signal1<arg1_type, mt_policy> &signal, unsigned long id) {
+			_record_tap1<arg1_type, mt_policy> *tap = new _record_tap1<arg1_type, mt_policy>(m_sink, id);
+			m_taps.push_back(tap);
+			signal.connect(tap, &_record_tap1<arg1_type, mt_policy>::shoot);
 		}
 		
-		virtual void shoot(arg1_type a1, arg2_type a2, arg3_type a3) {
-			(m_pobject->*m_pmemfun)(a1, a2, a3);
+		template<class arg1_type, class arg2_type, class mt_policy>
+		void record(Signal2<arg1_type, arg2_type, mt_policy> &signal, unsigned long id) {
+			_record_tap2<arg1_type, arg2_type, mt_policy> *tap = new _record_tap2<arg1_type, arg2_type, mt_policy>(m_sink, id);
+			m_taps.push_back(tap);
+			signal.connect(tap, &_record_tap2<arg1_type, arg2_type, mt_policy>::shoot);
 		}
 		
-		virtual HasSlots<mt_policy>* getdest() const {
-			return m_pobject;
+		template<class arg1_type, class arg2_type, class arg3_type, class mt_policy>
+		void record(Signal3<arg1_type, arg2_type, arg3_type, mt_policy> &signal, unsigned long id) {
+			_record_tap3<arg1_type, arg2_type, arg3_type, mt_policy> *tap = new _record_tap3<arg1_type, arg2_type, arg3_type, mt_policy>(m_sink, id);
+			m_taps.push_back(tap);
+			signal.connect(tap, &_record_tap3<arg1_type, arg2_type, arg3_type, mt_policy>::shoot);
 		}
 		
-	private:
-		dest_type *m_pobject;
-		void (dest_type::* m_pmemfun)(arg1_type, arg2_type, arg3_type);
-	};
-	
-	template < class dest_type, class arg1_type, class arg2_type, class arg3_type,
-	class arg4_type, class mt_policy >
-	class _connection4 : public _connection_base4 < arg1_type, arg2_type,
-	arg3_type, arg4_type, mt_policy > {
-	public:
-		_connection4() {
-			this->pobject = NULL;
-			this->pmemfun = NULL;
+		template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class mt_policy>
+		void record(Signal4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy> &signal, unsigned long id) {
+			_record_tap4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy> *tap = new _record_tap4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>(m_sink, id);
+			m_taps.push_back(tap);
+			signal.connect(tap, &_record_tap4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>::shoot);
 		}
 		
-		_connection4(dest_type *pobject, void (dest_type::*pmemfun)(arg1_type,
-		                                                            arg2_type, arg3_type, arg4_type)) {
-			m_pobject = pobject;
-			m_pmemfun = pmemfun;
+		template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class mt_policy>
+		void record(Signal5<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy> &signal, unsigned long id) {
+			_record_tap5<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy> *tap = new _record_tap5<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy>(m_sink, id);
+			m_taps.push_back(tap);
+			signal.connect(tap, &_record_tap5<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy>::shoot);
 		}
 		
-		virtual _connection_base4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>* clone() {
-			return new _connection4<dest_type, arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>(*this);
+		template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class mt_policy>
+		void record(Signal6<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy> &signal, unsigned long id) {
+			_record_tap6<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy> *tap = new _record_tap6<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy>(m_sink, id);
+			m_taps.push_back(tap);
+			signal.connect(tap, &_record_tap6<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy>::shoot);
 		}
 		
-		virtual _connection_base4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>* duplicate(HasSlots<mt_policy>* pnewdest) {
-			return new _connection4<dest_type, arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>((dest_type *)pnewdest, m_pmemfun);
+		template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class arg7_type, class mt_policy>
+		void record(Signal7<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy> &signal, unsigned long id) {
+			_record_tap7<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy> *tap = new _record_tap7<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy>(m_sink, id);
+			m_taps.push_back(tap);
+			signal.connect(tap, &_record_tap7<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy>::shoot);
 		}
 		
-		virtual void shoot(arg1_type a1, arg2_type a2, arg3_type a3,
-		                   arg4_type a4) {
-			(m_pobject->*m_pmemfun)(a1, a2, a3, a4);
+		template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class arg7_type, class arg8_type, class mt_policy>
+		void record(Signal8<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy> &signal, unsigned long id) {
+			_record_tap8<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy> *tap = new _record_tap8<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy>(m_sink, id);
+			m_taps.push_back(tap);
+			signal.connect(tap, &_record_tap8<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy>::shoot);
 		}
 		
-		virtual HasSlots<mt_policy>* getdest() const {
-			return m_pobject;
+	protected:
+		// Disconnects the taps, waiting for the emissions being serialized
+		// on other threads. Owners call it before closing their sink.
+		void detach() {
+			for (std::vector<_record_tap *>::const_iterator it = m_taps.begin(); it != m_taps.end(); ++it) {
+				delete *it;
+			}
+			
+			m_taps.clear();
 		}
 		
 	private:
-		dest_type *m_pobject;
-		void (dest_type::* m_pmemfun)(arg1_type, arg2_type, arg3_type,
-		                              arg4_type);
+		_record_source(const _record_source &);
+		_record_source &operator=(const _record_source &);
+		
+		_record_sink *m_sink;
+		std::vector<_record_tap *> m_taps;
 	};
 	
-	template < class dest_type, class arg1_type, class arg2_type, class arg3_type,
-	class arg4_type, class arg5_type, class mt_policy >
-	class _connection5 : public _connection_base5 < arg1_type, arg2_type,
-	arg3_type, arg4_type, arg5_type, mt_policy > {
+	// Re-emits the records of one signal.
+	class _replay_target {
 	public:
-		_connection5() {
-			this->pobject = NULL;
-			this->pmemfun = NULL;
+		_replay_target(std::size_t payload): m_size((long)(sizeof(_record) + payload)) {
 		}
 		
-		_connection5(dest_type *pobject, void (dest_type::*pmemfun)(arg1_type,
-		                                                            arg2_type, arg3_type, arg4_type, arg5_type)) {
-			m_pobject = pobject;
-			m_pmemfun = pmemfun;
+		virtual ~_replay_target() {
 		}
 		
-		virtual _connection_base5 < arg1_type, arg2_type, arg3_type, arg4_type,
-		arg5_type, mt_policy > * clone() {
-			return new _connection5 < dest_type, arg1_type, arg2_type, arg3_type, arg4_type,
-			arg5_type, mt_policy > (*this);
+		virtual void emit(const char *payload) = 0;
+		
+		// Size of the records this target can read.
+		long m_size;
+	};
+	
+	template<class mt_policy>
+	class _replay_target0 : public _replay_target {
+	public:
+		_replay_target0(Signal0<mt_policy> *signal): _replay_target(0), m_signal(signal) {
 		}
 		
-		virtual _connection_base5 < arg1_type, arg2_type, arg3_type, arg4_type,
-		arg5_type, mt_policy > * duplicate(HasSlots<mt_policy>* pnewdest) {
-			return new _connection5 < dest_type, arg1_type, arg2_type, arg3_type, arg4_type,
-			arg5_type, mt_policy > ((dest_type *)pnewdest, m_pmemfun);
+		virtual void emit(const char *) {
+			m_signal->shoot();
 		}
 		
-		virtual void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4,
-						   arg5_type a5) {
-			(m_pobject->*m_pmemfun)(a1, a2, a3, a4, a5);
+	private:
+		Signal0<mt_policy> *m_signal;
+	};
+	
+	template<class arg1_type, class mt_policy>
+	class _replay_target1 : public _replay_target {
+	public:
+		_replay_target1(Signal1<arg1_type, mt_policy> *signal): _replay_target(sizeof(typename _value_type<arg1_type>::type)), m_signal(signal) {
 		}
 		
-		virtual HasSlots<mt_policy>* getdest() const {
-			return m_pobject;
+		virtual void emit(const char *payload) {
+			typename _value_type<arg1_type>::type a1;
+			_record_get(payload, a1);
+			m_signal->shoot(a1);
 		}
 		
 	private:
-		dest_type *m_pobject;
-		void (dest_type::* m_pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type,
-		                              arg5_type);
+		Signal1<arg1_type, mt_policy> *m_signal;
 	};
 	
-	template < class dest_type, class arg1_type, class arg2_type, class arg3_type,
-	class arg4_type, class arg5_type, class arg6_type, class mt_policy >
-	class _connection6 : public _connection_base6 < arg1_type, arg2_type,
-	arg3_type, arg4_type, arg5_type, arg6_type, mt_policy > {
+	template<class arg1_type, class arg2_type, class mt_policy>
+	class _replay_target2 : public _replay_target {
 	public:
-		_connection6() {
-			this->pobject = NULL;
-			this->pmemfun = NULL;
+		_replay_target2(Signal2<arg1_type, arg2_type, mt_policy> *signal): _replay_target(sizeof(typename _value_type<arg1_type>::type) + sizeof(typename _value_type<arg2_type>::type)), m_signal(signal) {
 		}
 		
-		_connection6(dest_type *pobject, void (dest_type::*pmemfun)(arg1_type,
-		                                                            arg2_type, arg3_type, arg4_type, arg5_type, arg6_type)) {
-			m_pobject = pobject;
-			m_pmemfun = pmemfun;
+		virtual void emit(const char *payload) {
+			typename _value_type<arg1_type>::type a1;
+			_record_get(payload, a1);
+			typename _value_type<arg2_type>::type a2;
+			_record_get(payload, a2);
+			m_signal->shoot(a1, a2);
 		}
 		
-		virtual _connection_base6 < arg1_type, arg2_type, arg3_type, arg4_type,
-		arg5_type, arg6_type, mt_policy > * clone() {
-			return new _connection6 < dest_type, arg1_type, arg2_type, arg3_type, arg4_type,
-			arg5_type, arg6_type, mt_policy > (*this);
+	private:
+		Signal2<arg1_type, arg2_type, mt_policy> *m_signal;
+	};
+	
+	template<class arg1_type, class arg2_type, class arg3_type, class mt_policy>
+	class _replay_target3 : public _replay_target {
+	public:
+		_replay_target3(Signal3<arg1_type, arg2_type, arg3_type, mt_policy> *signal): _replay_target(sizeof(typename _value_type<arg1_type>::type) + sizeof(typename _value_type<arg2_type>::type) + sizeof(typename _value_type<arg3_type>::type)), m_signal(signal) {
 		}
 		
-		virtual _connection_base6 < arg1_type, arg2_type, arg3_type, arg4_type,
-		arg5_type, arg6_type, mt_policy > * duplicate(HasSlots<mt_policy>* pnewdest) {
-			return new _connection6 < dest_type, arg1_type, arg2_type, arg3_type, arg4_type,
-			arg5_type, arg6_type, mt_policy > ((dest_type *)pnewdest, m_pmemfun);
+		virtual void emit(const char *payload) {
+			typename _value_type<arg1_type>::type a1;
+			_record_get(payload, a1);
+			typename _value_type<arg2_type>::type a2;
+			_record_get(payload, a2);
+			typename _value_type<arg3_type>::type a3;
+			_record_get(payload, a3);
+			m_signal->shoot(a1, a2, a3);
 		}
 		
-		virtual void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4,
-						   arg5_type a5, arg6_type a6) {
-			(m_pobject->*m_pmemfun)(a1, a2, a3, a4, a5, a6);
+	private:
+		Signal3<arg1_type, arg2_type, arg3_type, mt_policy> *m_signal;
+	};
+	
+	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class mt_policy>
+	class _replay_target4 : public _replay_target {
+	public:
+		_replay_target4(Signal4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy> *signal): _replay_target(sizeof(typename _value_type<arg1_type>::type) + sizeof(typename _value_type<arg2_type>::type) + sizeof(typename _value_type<arg3_type>::type) + sizeof(typename _value_type<arg4_type>::type)), m_signal(signal) {
 		}
 		
-		virtual HasSlots<mt_policy>* getdest() const {
-			return m_pobject;
+		virtual void emit(const char *payload) {
+			typename _value_type<arg1_type>::type a1;
+			_record_get(payload, a1);
+			typename _value_type<arg2_type>::type a2;
+			_record_get(payload, a2);
+			typename _value_type<arg3_type>::type a3;
+			_record_get(payload, a3);
+			typename _value_type<arg4_type>::type a4;
+			_record_get(payload, a4);
+			m_signal->shoot(a1, a2, a3, a4);
 		}
 		
 	private:
-		dest_type *m_pobject;
-		void (dest_type::* m_pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type,
-		                              arg5_type, arg6_type);
+		Signal4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy> *m_signal;
 	};
 	
-	template < class dest_type, class arg1_type, class arg2_type, class arg3_type,
-	class arg4_type, class arg5_type, class arg6_type, class arg7_type, class mt_policy >
-	class _connection7 : public _connection_base7 < arg1_type, arg2_type,
-	arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy > {
+	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class mt_policy>
+	class _replay_target5 : public _replay_target {
 	public:
-		_connection7() {
-			this->pobject = NULL;
-			this->pmemfun = NULL;
+		_replay_target5(Signal5<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy> *signal): _replay_target(sizeof(typename _value_type<arg1_type>::type) + sizeof(typename _value_type<arg2_type>::type) + sizeof(typename _value_type<arg3_type>::type) + sizeof(typename _value_type<arg4_type>::type) + sizeof(typename _value_type<arg5_type>::type)), m_signal(signal) {
 		}
 		
-		_connection7(dest_type *pobject, void (dest_type::*pmemfun)(arg1_type,
-		                                                            arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type)) {
-			m_pobject = pobject;
-			m_pmemfun = pmemfun;
+		virtual void emit(const char *payload) {
+			typename _value_type<arg1_type>::type a1;
+			_record_get(payload, a1);
+			typename _value_type<arg2_type>::type a2;
+			_record_get(payload, a2);
+			typename _value_type<arg3_type>::type a3;
+			_record_get(payload, a3);
+			typename _value_type<arg4_type>::type a4;
+			_record_get(payload, a4);
+			typename _value_type<arg5_type>::type a5;
+			_record_get(payload, a5);
+			m_signal->shoot(a1, a2, a3, a4, a5);
 		}
 		
-		virtual _connection_base7 < arg1_type, arg2_type, arg3_type, arg4_type,
-		arg5_type, arg6_type, arg7_type, mt_policy > * clone() {
-			return new _connection7 < dest_type, arg1_type, arg2_type, arg3_type, arg4_type,
-			arg5_type, arg6_type, arg7_type, mt_policy > (*this);
+	private:
+		Signal5<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy> *m_signal;
+	};
+	
+	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class mt_policy>
+	class _replay_target6 : public _replay_target {
+	public:
+		_replay_target6(Signal6<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy> *signal): _replay_target(sizeof(typename _value_type<arg1_type>::type) + sizeof(typename _value_type<arg2_type>::type) + sizeof(typename _value_type<arg3_type>::type) + sizeof(typename _value_type<arg4_type>::type) + sizeof(typename _value_type<arg5_type>::type) + sizeof(typename _value_type<arg6_type>::type)), m_signal(signal) {
 		}
 		
-		virtual _connection_base7 < arg1_type, arg2_type, arg3_type, arg4_type,
-		arg5_type, arg6_type, arg7_type, mt_policy > * duplicate(HasSlots<mt_policy>* pnewdest) {
-			return new _connection7 < dest_type, arg1_type, arg2_type, arg3_type, arg4_type,
-			arg5_type, arg6_type, arg7_type, mt_policy > ((dest_type *)pnewdest, m_pmemfun);
+		virtual void emit(const char *payload) {
+			typename _value_type<arg1_type>::type a1;
+			_record_get(payload, a1);
+			typename _value_type<arg2_type>::type a2;
+			_record_get(payload, a2);
+			typename _value_type<arg3_type>::type a3;
+			_record_get(payload, a3);
+			typename _value_type<arg4_type>::type a4;
+			_record_get(payload, a4);
+			typename _value_type<arg5_type>::type a5;
+			_record_get(payload, a5);
+			typename _value_type<arg6_type>::type a6;
+			_record_get(payload, a6);
+			m_signal->shoot(a1, a2, a3, a4, a5, a6);
 		}
 		
-		virtual void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4,
-						   arg5_type a5, arg6_type a6, arg7_type a7) {
-			(m_pobject->*m_pmemfun)(a1, a2, a3, a4, a5, a6, a7);
+	private:
+		Signal6<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy> *m_signal;
+	};
+	
+	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class arg7_type, class mt_policy>
+	class _replay_target7 : public _replay_target {
+	public:
+		_replay_target7(Signal7<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy> *signal): _replay_target(sizeof(typename _value_type<arg1_type>::type) + sizeof(typename _value_type<arg2_type>::type) + sizeof(typename _value_type<arg3_type>::type) + sizeof(typename _value_type<arg4_type>::type) + sizeof(typename _value_type<arg5_type>::type) + sizeof(typename _value_type<arg6_type>::type) + sizeof(typename _value_type<arg7_type>::type)), m_signal(signal) {
+		}
+		
+		virtual void emit(const char *payload) {
+			typename _value_type<arg1_type>::type a1;
+			_record_get(payload, a1);
+			typename _value_type<arg2_type>::type a2;
+			_record_get(payload, a2);
+			typename _value_type<arg3_type>::type a3;
+			_record_get(payload, a3);
+			typename _value_type<arg4_type>::type a4;
+			_record_get(payload, a4);
+			typename _value_type<arg5_type>::type a5;
+			_record_get(payload, a5);
+			typename _value_type<arg6_type>::type a6;
+			_record_get(payload, a6);
+			typename _value_type<arg7_type>::type a7;
+			_record_get(payload, a7);
+			m_signal->shoot(a1, a2, a3, a4, a5, a6, a7);
 		}
 		
-		virtual HasSlots<mt_policy>* getdest() const {
-			return m_pobject;
+	private:
+		Signal7<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy> *m_signal;
+	};
+	
+	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class arg7_type, class arg8_type, class mt_policy>
+	class _replay_target8 : public _replay_target {
+	public:
+		_replay_target8(Signal8<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy> *signal): _replay_target(sizeof(typename _value_type<arg1_type>::type) + sizeof(typename _value_type<arg2_type>::type) + sizeof(typename _value_type<arg3_type>::type) + sizeof(typename _value_type<arg4_type>::type) + sizeof(typename _value_type<arg5_type>::type) + sizeof(typename _value_type<arg6_type>::type) + sizeof(typename _value_type<arg7_type>::type) + sizeof(typename _value_type<arg8_type>::type)), m_signal(signal) {
+		}
+		
+		virtual void emit(const char *payload) {
+			typename _value_type<arg1_type>::type a1;
+			_record_get(payload, a1);
+			typename _value_type<arg2_type>::type a2;
+			_record_get(payload, a2);
+			typename _value_type<arg3_type>::type a3;
+			_record_get(payload, a3);
+			typename _value_type<arg4_type>::type a4;
+			_record_get(payload, a4);
+			typename _value_type<arg5_type>::type a5;
+			_record_get(payload, a5);
+			typename _value_type<arg6_type>::type a6;
+			_record_get(payload, a6);
+			typename _value_type<arg7_type>::type a7;
+			_record_get(payload, a7);
+			typename _value_type<arg8_type>::type a8;
+			_record_get(payload, a8);
+			m_signal->shoot(a1, a2, a3, a4, a5, a6, a7, a8);
 		}
 		
 	private:
-		dest_type *m_pobject;
-		void (dest_type::* m_pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type,
-		                              arg5_type, arg6_type, arg7_type);
+		Signal8<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy> *m_signal;
 	};
 	
-	template < class dest_type, class arg1_type, class arg2_type, class arg3_type,
-	class arg4_type, class arg5_type, class arg6_type, class arg7_type,
-	class arg8_type, class mt_policy >
-	class _connection8 : public _connection_base8 < arg1_type, arg2_type,
-	arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy > {
+	// Signals bound to the ids of serialized emissions.
+	class _replay_dispatch {
 	public:
-		_connection8() {
-			this->pobject = NULL;
-			this->pmemfun = NULL;
+		_replay_dispatch() {
 		}
 		
-		_connection8(dest_type *pobject, void (dest_type::*pmemfun)(arg1_type,
-		                                                            arg2_type, arg3_type, arg4_type, arg5_type, arg6_type,
-		                                                            arg7_type, arg8_type)) {
-			m_pobject = pobject;
-			m_pmemfun = pmemfun;
+		~_replay_dispatch() {
+			for (target_map::const_iterator it = m_targets.begin(); it != m_targets.end(); ++it) {
+				delete it->second;
+			}
 		}
 		
-		virtual _connection_base8 < arg1_type, arg2_type, arg3_type, arg4_type,
-		arg5_type, arg6_type, arg7_type, arg8_type, mt_policy > * clone() {
-			return new _connection8 < dest_type, arg1_type, arg2_type, arg3_type, arg4_type,
-			arg5_type, arg6_type, arg7_type, arg8_type, mt_policy > (*this);
+		template<class mt_policy>
+		void bind(unsigned long id, Signal0<mt_policy> &signal) {
+			attach(id, new _replay_target0<mt_policy>(&signal));
 		}
 		
-		virtual _connection_base8 < arg1_type, arg2_type, arg3_type, arg4_type,
-		arg5_type, arg6_type, arg7_type, arg8_type, mt_policy > * duplicate(HasSlots<mt_policy>* pnewdest) {
-			return new _connection8 < dest_type, arg1_type, arg2_type, arg3_type, arg4_type,
-			arg5_type, arg6_type, arg7_type, arg8_type, mt_policy > ((dest_type *)pnewdest, m_pmemfun);
+		template<class arg1_type, class mt_policy>
+		void bind(unsigned long id, Signal1<arg1_type, mt_policy> &signal) {
+			attach(id, new _replay_target1<arg1_type, mt_policy>(&signal));
 		}
 		
-		virtual void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4,
-						   arg5_type a5, arg6_type a6, arg7_type a7, arg8_type a8) {
-			(m_pobject->*m_pmemfun)(a1, a2, a3, a4, a5, a6, a7, a8);
+		template<class arg1_type, class arg2_type, class mt_policy>
+		void bind(unsigned long id, Signal2<arg1_type, arg2_type, mt_policy> &signal) {
+			attach(id, new _replay_target2<arg1_type, arg2_type, mt_policy>(&signal));
 		}
 		
-		virtual HasSlots<mt_policy>* getdest() const {
-			return m_pobject;
+		template<class arg1_type, class arg2_type, class arg3_type, class mt_policy>
+		void bind(unsigned long id, Signal3<arg1_type, arg2_type, arg3_type, mt_policy> &signal) {
+			attach(id, new _replay_target3<arg1_type, arg2_type, arg3_type, mt_policy>(&signal));
 		}
 		
-	private:
-		dest_type *m_pobject;
-		void (dest_type::* m_pmemfun)(arg1_type, arg2_type, arg3_type, arg4_type,
-		                              arg5_type, arg6_type, arg7_type, arg8_type);
-	};
-	
-	template<class mt_policy = SIGLY_DEFAULT_MT_POLICY>
-	class Signal0 : public _signal_base0<mt_policy> {
-	public:
-		typedef typename _signal_base0<mt_policy>::connections_list::const_iterator const_iterator;
-		Signal0() {
-			;
+		template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class mt_policy>
+		void bind(unsigned long id, Signal4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy> &signal) {
+			attach(id, new _replay_target4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>(&signal));
 		}
 		
-		Signal0(const Signal0<mt_policy>& s)
-		: _signal_base0<mt_policy>(s) {
-			;
+		template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class mt_policy>
+		void bind(unsigned long id, Signal5<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy> &signal) {
+			attach(id, new _replay_target5<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy>(&signal));
 		}
 		
-		template<class desttype>
-		void connect(desttype *pclass, void (desttype::*pmemfun)()) {
-			lock_block<mt_policy> lock(this);
-			_connection0<desttype, mt_policy>* conn =
-			new _connection0<desttype, mt_policy>(pclass, pmemfun);
-			this->m_connected_slots.push_back(conn);
-			pclass->signalConnect(this);
+		template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class mt_policy>
+		void bind(unsigned long id, Signal6<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy> &signal) {
+			attach(id, new _replay_target6<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, mt_policy>(&signal));
 		}
 		
-		void shoot() {
-			lock_block<mt_policy> lock(this);
-			const_iterator it = this->m_connected_slots.begin();
-			const_iterator itEnd = this->m_connected_slots.end();
+		template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class arg7_type, class mt_policy>
+		void bind(unsigned long id, Signal7<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy> &signal) {
+			attach(id, new _replay_target7<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, mt_policy>(&signal));
+		}
+		
+		template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class arg5_type, class arg6_type, class arg7_type, class arg8_type, class mt_policy>
+		void bind(unsigned long id, Signal8<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy> &signal) {
+			attach(id, new _replay_target8<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy>(&signal));
+		}
+		
+	protected:
+		// Emits the record into the signal bound to its id, if any and if the
+		// record has the size of that signal's arguments.
+		bool dispatch(const _record *record) const {
+			target_map::const_iterator target = m_targets.find(record->signal);
 			
-			while (it != itEnd) {
-				if ((*it)->getdest()->areSlotsActive()) {
-					(*it)->shoot();
-				}
-				++it;
+			if (target == m_targets.end() || target->second->m_size != record->size) {
+				return false;
 			}
+			
+			target->second->emit(reinterpret_cast<const char *>(record + 1));
+			return true;
 		}
 		
-		void operator()() {
-			shoot();
+	private:
+		typedef std::map<unsigned long, _replay_target *> target_map;
+		
+		_replay_dispatch(const _replay_dispatch &);
+		_replay_dispatch &operator=(const _replay_dispatch &);
+		
+		void attach(unsigned long id, _replay_target *target) {
+			_replay_target *&bound = m_targets[id];
+			delete bound;
+			bound = target;
 		}
+		
+		target_map m_targets;
 	};
 	
-	template<class arg1_type, class mt_policy = SIGLY_DEFAULT_MT_POLICY>
-	class Signal1 : public _signal_base1<arg1_type, mt_policy> {
+#endif
+	
+#ifdef SIGLY_ENABLE_RECORDING
+	// Layout of a recording: this header, then the records back to back.
+	// Fields are in the byte order and sizes of the recording platform.
+	struct _record_file {
+		char magic[8];
+		// Bytes used, header included; 0 if the recorder did not close.
+		long used;
+	};
+	
+	// The file of a Recorder. Writing takes no lock: each emission reserves
+	// its record with a compare-and-swap.
+	class _record_log : public _record_sink {
 	public:
-		typedef typename _signal_base1<arg1_type, mt_policy>::connections_list::const_iterator const_iterator;
-		Signal1() {
-			;
-		}
-		
-		Signal1(const Signal1<arg1_type, mt_policy>& s)
-		: _signal_base1<arg1_type, mt_policy>(s) {
-			;
-		}
-		
-		template<class desttype>
-		void connect(desttype *pclass, void (desttype::*pmemfun)(arg1_type)) {
-			lock_block<mt_policy> lock(this);
-			_connection1<desttype, arg1_type, mt_policy>* conn =
-			new _connection1<desttype, arg1_type, mt_policy>(pclass, pmemfun);
-			this->m_connected_slots.push_back(conn);
-			pclass->signalConnect(this);
+		_record_log(): m_used((long)sizeof(_record_file)), m_dropped(0), m_start(_now()) {
 		}
 		
-		void shoot(arg1_type a1) {
-			lock_block<mt_policy> lock(this);
-			const_iterator  it = this->m_connected_slots.begin();
-			const_iterator itEnd = this->m_connected_slots.end();
-			
-			while (it != itEnd) {
-				if ((*it)->getdest()->areSlotsActive()) {
-					(*it)->shoot(a1);
-				}
-				++it;
+		bool open(const char *path, std::size_t capacity) {
+			if (!m_file.open(path, sizeof(_record_file) + capacity, true)) {
+				return false;
 			}
+			
+			_record_file *header = reinterpret_cast<_record_file *>(m_file.base());
+			std::memcpy(header->magic, "SIGLYREC", sizeof(header->magic));
+			header->used = 0;
+			return true;
 		}
 		
-		void operator()(arg1_type a1) {
-			shoot(a1);
+		void close() {
+			if (isOpen()) {
+				flush();
+				m_file.close(size());
+			}
 		}
-	};
-	
-	template<class arg1_type, typename arg2_type, typename mt_policy = SIGLY_DEFAULT_MT_POLICY>
-	class Signal2 : public _signal_base2<arg1_type, arg2_type, mt_policy> {
-	public:
-		typedef typename _signal_base2<arg1_type, arg2_type, mt_policy>::connections_list::const_iterator const_iterator;
-		Signal2() {
-			;
+		
+		bool isOpen() const {
+			return m_file.base() != NULL;
 		}
 		
-		Signal2(const Signal2<arg1_type, arg2_type, mt_policy>& s)
-		: _signal_base2<arg1_type, arg2_type, mt_policy>(s) {
-			;
+		void flush() {
+			reinterpret_cast<_record_file *>(m_file.base())->used = _atomic_load(&m_used);
 		}
 		
-		template<class desttype>
-		void connect(desttype *pclass, void (desttype::*pmemfun)(arg1_type,
-		                                                         arg2_type)) {
-			lock_block<mt_policy> lock(this);
-			_connection2<desttype, arg1_type, arg2_type, mt_policy>* conn = new
-			_connection2<desttype, arg1_type, arg2_type, mt_policy>(pclass, pmemfun);
-			this->m_connected_slots.push_back(conn);
-			pclass->signalConnect(this);
+		std::size_t size() const {
+			return (std::size_t)_atomic_load(&m_used);
 		}
 		
-		void shoot(arg1_type a1, arg2_type a2) {
-			lock_block<mt_policy> lock(this);
-			const_iterator it = this->m_connected_slots.begin();
-			const_iterator itEnd = this->m_connected_slots.end();
+		std::size_t dropped() const {
+			return (std::size_t)_atomic_load(&m_dropped);
+		}
+		
+		char *reserve(unsigned long signal, std::size_t payload) {
+			long size = _record_size(payload);
+			long offset = _atomic_load(&m_used);
 			
-			while (it != itEnd) {
-				if ((*it)->getdest()->areSlotsActive()) {
-					(*it)->shoot(a1, a2);
+			for (;;) {
+				if (!isOpen() || offset + size > (long)m_file.size()) {
+					_atomic_increment(&m_dropped);
+					return NULL;
 				}
-				++it;
+				
+				long previous = _atomic_compare_exchange(&m_used, offset, offset + size);
+				
+				if (previous == offset) {
+					break;
+				}
+				
+				offset = previous;
 			}
+			
+			_record *record = reinterpret_cast<_record *>(m_file.base() + offset);
+			record->signal = signal;
+			record->time = _now() - m_start;
+			return reinterpret_cast<char *>(record + 1);
 		}
 		
-		void operator()(arg1_type a1, arg2_type a2) {
-			shoot(a1,a2);
+		void commit(char *payload, std::size_t size) {
+			_atomic_exchange(&(reinterpret_cast<_record *>(payload) - 1)->size, (long)(sizeof(_record) + size));
 		}
+		
+	private:
+		_mapped_file m_file;
+		volatile long m_used;
+		volatile long m_dropped;
+		double m_start;
 	};
 	
-	template<class arg1_type, typename arg2_type, typename arg3_type, typename mt_policy = SIGLY_DEFAULT_MT_POLICY>
-	class Signal3 : public _signal_base3<arg1_type, arg2_type, arg3_type, mt_policy> {
+	// Writes every emission of the signals given to record() to a file, for
+	// Replayer. Arguments are stored as their bytes, so they must be
+	// trivially copyable, and pointers among them are only meaningful in the
+	// recording process. Recording takes no lock and the file is mapped into
+	// memory, so an emission costs a compare-and-swap and a copy of its
+	// arguments. Emissions that do not fit in the capacity given to the
+	// constructor are dropped and counted.
+	class Recorder : public _record_source {
 	public:
-		typedef typename _signal_base3<arg1_type, arg2_type, arg3_type, mt_policy>::connections_list::const_iterator const_iterator;
-		Signal3() {
-			;
+		Recorder(const char *path, std::size_t capacity): _record_source(&m_log) {
+			m_log.open(path, capacity);
 		}
 		
-		Signal3(const Signal3<arg1_type, arg2_type, arg3_type, mt_policy>& s)
-		: _signal_base3<arg1_type, arg2_type, arg3_type, mt_policy>(s) {
-			;
+		// Disconnects from the recorded signals, waiting for the emissions
+		// being recorded on other threads, and closes the file.
+		~Recorder() {
+			detach();
+			m_log.close();
 		}
 		
-		template<class desttype>
-		void connect(desttype *pclass, void (desttype::*pmemfun)(arg1_type,
-		                                                         arg2_type, arg3_type)) {
-			lock_block<mt_policy> lock(this);
-			_connection3<desttype, arg1_type, arg2_type, arg3_type, mt_policy>* conn =
-			new _connection3<desttype, arg1_type, arg2_type, arg3_type, mt_policy>(pclass,
-																				   pmemfun);
-			this->m_connected_slots.push_back(conn);
-			pclass->signalConnect(this);
+		bool isOpen() const {
+			return m_log.isOpen();
 		}
 		
-		void shoot(arg1_type a1, arg2_type a2, arg3_type a3) {
-			lock_block<mt_policy> lock(this);
-			const_iterator it = this->m_connected_slots.begin();
-			const_iterator itEnd = this->m_connected_slots.end();
-			
-			while (it != itEnd) {
-				if ((*it)->getdest()->areSlotsActive()) {
-					(*it)->shoot(a1, a2, a3);
-				}
-				++it;
+		// Records the end of what has been written in the file header, so
+		// that the file can be replayed while recording goes on.
+		void flush() {
+			if (isOpen()) {
+				m_log.flush();
 			}
 		}
 		
-		void operator()(arg1_type a1, arg2_type a2, arg3_type a3) {
-			shoot(a1,a2,a3);
+		// Bytes written, header included.
+		std::size_t size() const {
+			return m_log.size();
 		}
+		
+		// Number of emissions that did not fit.
+		std::size_t dropped() const {
+			return m_log.dropped();
+		}
+		
+	private:
+		Recorder(const Recorder &);
+		Recorder &operator=(const Recorder &);
+		
+		_record_log m_log;
 	};
 	
-	template<class arg1_type, class arg2_type, class arg3_type, class arg4_type, class mt_policy = SIGLY_DEFAULT_MT_POLICY>
-	class Signal4 : public _signal_base4 < arg1_type, arg2_type, arg3_type,
-	arg4_type, mt_policy > {
+	enum ReplaySpeed {
+		// Emissions are spaced as they were recorded.
+		RECORDED_SPEED,
+		// Emissions follow each other without waiting.
+		MAXIMUM_SPEED
+	};
+	
+	// Reads a file written by Recorder and emits its records again, on the
+	// calling thread, into the signals bound to their ids. Records of ids
+	// without a signal, or whose size does not match the bound signal's
+	// arguments, are skipped.
+	class Replayer : public _replay_dispatch {
 	public:
-		typedef typename _signal_base4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>::connections_list::const_iterator const_iterator;
-		Signal4() {
-			;
-		}
-		
-		Signal4(const Signal4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>& s)
-		: _signal_base4<arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>(s) {
-			;
+		Replayer(const char *path) {
+			m_file.open(path, 0, false);
 		}
 		
-		template<class desttype>
-		void connect(desttype *pclass, void (desttype::*pmemfun)(arg1_type,
-		                                                         arg2_type, arg3_type, arg4_type)) {
-			lock_block<mt_policy> lock(this);
-			_connection4<desttype, arg1_type, arg2_type, arg3_type, arg4_type, mt_policy>*
-			conn = new _connection4 < desttype, arg1_type, arg2_type, arg3_type,
-			arg4_type, mt_policy > (pclass, pmemfun);
-			this->m_connected_slots.push_back(conn);
-			pclass->signalConnect(this);
+		bool isOpen() const {
+			return m_file.base() != NULL && m_file.size() >= sizeof(_record_file) && std::memcmp(m_file.base(), "SIGLYREC", 8) == 0;
 		}
 		
-		void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4) {
-			lock_block<mt_policy> lock(this);
-			const_iterator it = this->m_connected_slots.begin();
-			const_iterator itEnd = this->m_connected_slots.end();
+		// Emits every record and returns how many were emitted.
+		std::size_t replay(ReplaySpeed speed = RECORDED_SPEED) {
+			if (!isOpen()) {
+				return 0;
+			}
 			
-			while (it != itEnd) {
-				if ((*it)->getdest()->areSlotsActive()) {
-					(*it)->shoot(a1, a2, a3, a4);
+			long used = reinterpret_cast<const _record_file *>(m_file.base())->used;
+			std::size_t end = used > 0 && (std::size_t)used <= m_file.size() ? (std::size_t)used : m_file.size();
+			std::size_t emitted = 0;
+			double start = _now();
+			
+			for (std::size_t offset = sizeof(_record_file); offset + sizeof(_record) <= end;) {
+				const _record *record = reinterpret_cast<const _record *>(m_file.base() + offset);
+				
+				long size = record->size >= (long)sizeof(_record) ? _record_size(record->size - sizeof(_record)) : 0;
+				
+				if (size == 0 || offset + size > end) {
+					break;
 				}
-				++it;
+				
+				if (speed == RECORDED_SPEED) {
+					waitUntil(start + record->time);
+				}
+				
+				if (dispatch(record)) {
+					++emitted;
+				}
+				
+				offset += size;
 			}
+			
+			return emitted;
 		}
 		
-		void operator()(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4) {
-			shoot(a1,a2,a3,a4);
+	private:
+		Replayer(const Replayer &);
+		Replayer &operator=(const Replayer &);
+		
+		static void waitUntil(double time) {
+			for (double left = time - _now(); left > 0; left = time - _now()) {
+#if defined(_SIGLY_HAS_WIN32_THREADS)
+				Sleep((DWORD)(left / 1000.0));
+#elif defined(_SIGLY_HAS_POSIX_THREADS)
+				timespec pause;
+				pause.tv_sec = (time_t)(left / 1000000.0);
+				pause.tv_nsec = (long)((left - (double)pause.tv_sec * 1000000.0) * 1000.0);
+				nanosleep(&pause, NULL);
+#else
+				_thread_yield();
+#endif
+			}
 		}
+		
+		_mapped_file m_file;
 	};
+#endif // SIGLY_ENABLE_RECORDING
 	
-	template < class arg1_type, class arg2_type, class arg3_type, class arg4_type,
-	class arg5_type, class mt_policy = SIGLY_DEFAULT_MT_POLICY >
-	class Signal5 : public _signal_base5 < arg1_type, arg2_type, arg3_type,
-	arg4_type, arg5_type, mt_policy > {
+#ifdef SIGLY_ENABLE_SHARED_MEMORY
+	// Control block at the start of a shared ring. head and tail count the
+	// bytes reserved by emitters and consumed by the pump since the ring was
+	// created, and sit on their own cache lines.
+	struct _ring_header {
+		char magic[8];
+		// 0 until a process starts initializing the ring, 2 once it is done.
+		volatile long state;
+		char pad0[SIGLY_CACHE_LINE_SIZE];
+		volatile long head;
+		char pad1[SIGLY_CACHE_LINE_SIZE];
+		volatile long tail;
+		// Set while the pump sleeps, so that emitters know to wake it.
+		volatile long waiting;
+		// Futex word the pump sleeps on.
+		volatile int wakeups;
+	};
+	
+	enum {
+		// Signal id of the record that pads the end of the ring when the next
+		// record does not fit there.
+		_RING_SKIP = -1
+	};
+	
+	inline unsigned long _ring_size(std::size_t payload) {
+		return (unsigned long)((sizeof(_record) + payload + sizeof(double) - 1) / sizeof(double) * sizeof(double));
+	}
+	
+	// Ring of records in a POSIX shared memory object, written by any number
+	// of emitting threads and processes and read by a single pump. Emitters
+	// reserve their record with a compare-and-swap on head and publish it by
+	// writing its size last; the pump zeroes what it has read before moving
+	// tail past it. Neither side makes a system call unless the pump sleeps.
+	class _ring : public _record_sink {
 	public:
-		typedef typename _signal_base5<arg1_type, arg2_type, arg3_type, arg4_type, arg5_type, mt_policy>::connections_list::const_iterator const_iterator;
-		Signal5() {
-			;
+		_ring(): m_header(NULL), m_data(NULL), m_mask(0), m_dropped(0) {
 		}
 		
-		Signal5(const Signal5 < arg1_type, arg2_type, arg3_type, arg4_type,
-		        arg5_type, mt_policy > & s)
-		: _signal_base5 < arg1_type, arg2_type, arg3_type, arg4_type,
-		arg5_type, mt_policy > (s) {
-			;
+		// The capacity is rounded up to a power of two; every process using
+		// the ring must give the same one.
+		bool open(const char *name, std::size_t capacity) {
+			std::size_t size = 4096;
+			
+			while (size < capacity) {
+				size *= 2;
+			}
+			
+			if (!m_file.openShared(name, sizeof(_ring_header) + size)) {
+				return false;
+			}
+			
+			m_header = reinterpret_cast<_ring_header *>(m_file.base());
+			
+			if (_atomic_compare_exchange(&m_header->state, 0, 1) == 0) {
+				std::memcpy(m_header->magic, "SIGLYRNG", sizeof(m_header->magic));
+				_atomic_exchange(&m_header->state, 2);
+			}
+			
+			while (_atomic_load(&m_header->state) != 2) {
+				_thread_yield();
+			}
+			
+			m_data = m_file.base() + sizeof(_ring_header);
+			m_mask = size - 1;
+			return true;
 		}
 		
-		template<class desttype>
-		void connect(desttype *pclass, void (desttype::*pmemfun)(arg1_type,
-		                                                         arg2_type, arg3_type, arg4_type, arg5_type)) {
-			lock_block<mt_policy> lock(this);
-			_connection5 < desttype, arg1_type, arg2_type, arg3_type, arg4_type,
-			arg5_type, mt_policy > * conn = new _connection5 < desttype, arg1_type, arg2_type,
-			arg3_type, arg4_type, arg5_type, mt_policy > (pclass, pmemfun);
-			this->m_connected_slots.push_back(conn);
-			pclass->signalConnect(this);
+		bool isOpen() const {
+			return m_header != NULL;
 		}
 		
-		void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4,
-		           arg5_type a5) {
-			lock_block<mt_policy> lock(this);
-			const_iterator it = this->m_connected_slots.begin();
-			const_iterator itEnd = this->m_connected_slots.end();
+		std::size_t dropped() const {
+			return (std::size_t)_atomic_load(&m_dropped);
+		}
+		
+		// Drops the emission when the ring is full.
+		virtual char *reserve(unsigned long signal, std::size_t payload) {
+			unsigned long size = _ring_size(payload);
+			unsigned long capacity = m_mask + 1;
 			
-			while (it != itEnd) {
-				if ((*it)->getdest()->areSlotsActive()) {
-					(*it)->shoot(a1, a2, a3, a4, a5);
+			if (!isOpen() || size > capacity) {
+				_atomic_increment(&m_dropped);
+				return NULL;
+			}
+			
+			unsigned long head = (unsigned long)_atomic_load(&m_header->head);
+			
+			for (;;) {
+				unsigned long at = head & m_mask;
+				unsigned long left = capacity - at;
+				unsigned long needed = left < size ? left + size : size;
+				
+				if (head + needed - (unsigned long)_atomic_load(&m_header->tail) > capacity) {
+					_atomic_increment(&m_dropped);
+					return NULL;
 				}
-				++it;
+				
+				unsigned long previous = (unsigned long)_atomic_compare_exchange(&m_header->head, (long)head, (long)(head + needed));
+				
+				if (previous == head) {
+					if (needed != size) {
+						// Too small a remainder for a record is skipped by the
+						// pump without one.
+						if (left >= sizeof(_record)) {
+							_record *skip = reinterpret_cast<_record *>(m_data + at);
+							skip->signal = (unsigned long)_RING_SKIP;
+							_atomic_exchange(&skip->size, (long)left);
+						}
+						
+						at = 0;
+					}
+					
+					_record *record = reinterpret_cast<_record *>(m_data + at);
+					record->signal = signal;
+					record->time = 0;
+					return reinterpret_cast<char *>(record + 1);
+				}
+				
+				head = previous;
 			}
 		}
 		
-		void operator()(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4,
-		                arg5_type a5) {
-			shoot(a1,a2,a3,a4,a5);
+		virtual void commit(char *payload, std::size_t size) {
+			_atomic_exchange(&(reinterpret_cast<_record *>(payload) - 1)->size, (long)(sizeof(_record) + size));
+			
+			if (_atomic_load(&m_header->waiting) != 0) {
+				wake();
+			}
 		}
-	};
-	
-	
-	template < class arg1_type, class arg2_type, class arg3_type, class arg4_type,
-	class arg5_type, class arg6_type, class mt_policy = SIGLY_DEFAULT_MT_POLICY >
-	class Signal6 : public _signal_base6 < arg1_type, arg2_type, arg3_type,
-	arg4_type, arg5_type, arg6_type, mt_policy > {
-	public:
-		typedef typename _signal_base6 < arg1_type, arg2_type, arg3_type,
-		arg4_type, arg5_type, arg6_type, mt_policy >::connections_list::const_iterator const_iterator;
-		Signal6() {
-			;
+		
+		// The next record to read, or NULL if none has been published yet.
+		// Skips the padding at the end of the ring.
+		_record *front() {
+			for (;;) {
+				unsigned long tail = (unsigned long)m_header->tail;
+				
+				if ((unsigned long)_atomic_load(&m_header->head) == tail) {
+					return NULL;
+				}
+				
+				unsigned long at = tail & m_mask;
+				unsigned long left = m_mask + 1 - at;
+				_record *record = reinterpret_cast<_record *>(m_data + at);
+				
+				if (left < sizeof(_record)) {
+					consume(at, left);
+					continue;
+				}
+				
+				if (_atomic_load(&record->size) == 0) {
+					return NULL;
+				}
+				
+				if (record->signal != (unsigned long)_RING_SKIP) {
+					return record;
+				}
+				
+				consume(at, left);
+			}
 		}
 		
-		Signal6(const Signal6 < arg1_type, arg2_type, arg3_type, arg4_type,
-		        arg5_type, arg6_type, mt_policy > & s)
-		: _signal_base6 < arg1_type, arg2_type, arg3_type, arg4_type,
-		arg5_type, arg6_type, mt_policy > (s) {
-			;
+		// Frees the record returned by front().
+		void pop(_record *record) {
+			consume((unsigned long)(reinterpret_cast<char *>(record) - m_data), _ring_size(record->size - sizeof(_record)));
 		}
 		
-		template<class desttype>
-		void connect(desttype *pclass, void (desttype::*pmemfun)(arg1_type,
-		                                                         arg2_type, arg3_type, arg4_type, arg5_type, arg6_type)) {
-			lock_block<mt_policy> lock(this);
-			_connection6 < desttype, arg1_type, arg2_type, arg3_type, arg4_type,
-			arg5_type, arg6_type, mt_policy > * conn =
-			new _connection6 < desttype, arg1_type, arg2_type, arg3_type,
-			arg4_type, arg5_type, arg6_type, mt_policy > (pclass, pmemfun);
-			this->m_connected_slots.push_back(conn);
-			pclass->signalConnect(this);
+		// Read with a barrier, so that it is taken before the pump looks at
+		// the ring and a wake() in between is not slept through.
+		int wakeups() const {
+			return __sync_fetch_and_add(&m_header->wakeups, 0);
 		}
 		
-		void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4,
-		           arg5_type a5, arg6_type a6) {
-			lock_block<mt_policy> lock(this);
-			const_iterator it = this->m_connected_slots.begin();
-			const_iterator itEnd = this->m_connected_slots.end();
+		// Sleeps until an emitter publishes a record or wake() is called,
+		// unless that already happened since wakeups() returned value.
+		void sleep(int value) {
+			_atomic_exchange(&m_header->waiting, 1);
 			
-			while (it != itEnd) {
-				if ((*it)->getdest()->areSlotsActive()) {
-					(*it)->shoot(a1, a2, a3, a4, a5, a6);
-				}
-				++it;
+			if ((unsigned long)_atomic_load(&m_header->head) == (unsigned long)m_header->tail) {
+#ifdef __linux__
+				// The timeout only guards against a crashed emitter.
+				timespec timeout;
+				timeout.tv_sec = 0;
+				timeout.tv_nsec = 100000000;
+				syscall(SYS_futex, const_cast<int *>(&m_header->wakeups), FUTEX_WAIT, value, &timeout, NULL, 0);
+#else
+				// Without futexes across processes, the pump polls.
+				timespec pause;
+				pause.tv_sec = 0;
+				pause.tv_nsec = 200000;
+				nanosleep(&pause, NULL);
+#endif
+			} else {
+				// Published but not committed yet.
+				_thread_yield();
 			}
+			
+			_atomic_exchange(&m_header->waiting, 0);
 		}
 		
-		void operator()(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4,
-		                arg5_type a5, arg6_type a6) {
-				shoot(a1,a2,a3,a4,a5,a6);
-
+		void wake() {
+#ifdef __linux__
+			__sync_add_and_fetch(&m_header->wakeups, 1);
+			syscall(SYS_futex, const_cast<int *>(&m_header->wakeups), FUTEX_WAKE, 1, NULL, NULL, 0);
+#endif
+		}
+		
+	private:
+		_ring(const _ring &);
+		_ring &operator=(const _ring &);
+		
+		void consume(unsigned long at, unsigned long size) {
+			std::memset(m_data + at, 0, size);
+			_atomic_exchange(&m_header->tail, (long)((unsigned long)m_header->tail + size));
 		}
+		
+		_mapped_file m_file;
+		_ring_header *m_header;
+		char *m_data;
+		unsigned long m_mask;
+		volatile long m_dropped;
 	};
 	
-	template < class arg1_type, class arg2_type, class arg3_type, class arg4_type,
-	class arg5_type, class arg6_type, class arg7_type, class mt_policy = SIGLY_DEFAULT_MT_POLICY >
-	class Signal7 : public _signal_base7 < arg1_type, arg2_type, arg3_type,
-	arg4_type, arg5_type, arg6_type, arg7_type, mt_policy > {
+	// Forwards the emissions of the signals given to record() to the
+	// SharedMemoryPump of the same name, usually in another process. The
+	// arguments are copied into the shared ring as their bytes, so they must
+	// be trivially copyable and must not point into the emitting process.
+	// Emissions that do not fit in the ring are dropped and counted.
+	class SharedMemoryEmitter : public _record_source {
 	public:
-		typedef typename _signal_base7 < arg1_type, arg2_type, arg3_type,
-		arg4_type, arg5_type, arg6_type, arg7_type, mt_policy >::connections_list::const_iterator const_iterator;
-		Signal7() {
-			;
+		SharedMemoryEmitter(const char *name, std::size_t capacity): _record_source(&m_ring) {
+			m_ring.open(name, capacity);
 		}
 		
-		Signal7(const Signal7 < arg1_type, arg2_type, arg3_type, arg4_type,
-		        arg5_type, arg6_type, arg7_type, mt_policy > & s)
-		: _signal_base7 < arg1_type, arg2_type, arg3_type, arg4_type,
-		arg5_type, arg6_type, arg7_type, mt_policy > (s) {
-			;
+		~SharedMemoryEmitter() {
+			detach();
 		}
 		
-		template<class desttype>
-		void connect(desttype *pclass, void (desttype::*pmemfun)(arg1_type,
-		                                                         arg2_type, arg3_type, arg4_type, arg5_type, arg6_type,
-		                                                         arg7_type)) {
-			lock_block<mt_policy> lock(this);
-			_connection7 < desttype, arg1_type, arg2_type, arg3_type, arg4_type,
-			arg5_type, arg6_type, arg7_type, mt_policy > * conn =
-			new _connection7 < desttype, arg1_type, arg2_type, arg3_type,
-			arg4_type, arg5_type, arg6_type, arg7_type, mt_policy > (pclass, pmemfun);
-			this->m_connected_slots.push_back(conn);
-			pclass->signalConnect(this);
+		bool isOpen() const {
+			return m_ring.isOpen();
 		}
 		
-		void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4,
-		           arg5_type a5, arg6_type a6, arg7_type a7) {
-			lock_block<mt_policy> lock(this);
-			const_iterator it = this->m_connected_slots.begin();
-			const_iterator itEnd = this->m_connected_slots.end();
-			
-			while (it != itEnd) {
-				if ((*it)->getdest()->areSlotsActive()) {
-					(*it)->shoot(a1, a2, a3, a4, a5, a6, a7);
-				}
-				++it;
-			}
+		// Number of emissions that did not fit.
+		std::size_t dropped() const {
+			return m_ring.dropped();
 		}
 		
-		void operator()(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4,
-		                arg5_type a5, arg6_type a6, arg7_type a7) {
-				shoot(a1,a2,a3,a4,a5,a6,a7);
-
-		}
+	private:
+		_ring m_ring;
 	};
 	
-	template < class arg1_type, class arg2_type, class arg3_type, class arg4_type,
-	class arg5_type, class arg6_type, class arg7_type, class arg8_type, class mt_policy = SIGLY_DEFAULT_MT_POLICY >
-	class Signal8 : public _signal_base8 < arg1_type, arg2_type, arg3_type,
-	arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy > {
+	// Receives the emissions forwarded by SharedMemoryEmitters of the same
+	// name and emits them again into the signals bound to their ids. Only one
+	// pump may read a ring. Whichever of the emitters and the pump comes
+	// first creates the shared memory object; remove() deletes its name.
+	class SharedMemoryPump : public _replay_dispatch {
 	public:
-		typedef typename _signal_base8 < arg1_type, arg2_type, arg3_type,
-		arg4_type, arg5_type, arg6_type, arg7_type, arg8_type, mt_policy >::connections_list::const_iterator const_iterator;
-		Signal8() {
-			;
+		SharedMemoryPump(const char *name, std::size_t capacity): m_woken(0) {
+			m_ring.open(name, capacity);
 		}
 		
-		Signal8(const Signal8 < arg1_type, arg2_type, arg3_type, arg4_type,
-		        arg5_type, arg6_type, arg7_type, arg8_type, mt_policy > & s)
-		: _signal_base8 < arg1_type, arg2_type, arg3_type, arg4_type,
-		arg5_type, arg6_type, arg7_type, arg8_type, mt_policy > (s) {
-			;
+		bool isOpen() const {
+			return m_ring.isOpen();
 		}
 		
-		template<class desttype>
-		void connect(desttype *pclass, void (desttype::*pmemfun)(arg1_type,
-		                                                         arg2_type, arg3_type, arg4_type, arg5_type, arg6_type,
-		                                                         arg7_type, arg8_type)) {
-			lock_block<mt_policy> lock(this);
-			_connection8 < desttype, arg1_type, arg2_type, arg3_type, arg4_type,
-			arg5_type, arg6_type, arg7_type, arg8_type, mt_policy > * conn =
-			new _connection8 < desttype, arg1_type, arg2_type, arg3_type,
-			arg4_type, arg5_type, arg6_type, arg7_type,
-			arg8_type, mt_policy > (pclass, pmemfun);
-			this->m_connected_slots.push_back(conn);
-			pclass->signalConnect(this);
+		// Emits the records available now, on the calling thread, and returns
+		// how many were read.
+		std::size_t pump() {
+			std::size_t count = 0;
+			
+			if (isOpen()) {
+				while (_record *record = m_ring.front()) {
+					dispatch(record);
+					m_ring.pop(record);
+					++count;
+				}
+			}
+			
+			return count;
 		}
 		
-		void shoot(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4,
-		           arg5_type a5, arg6_type a6, arg7_type a7, arg8_type a8) {
-			lock_block<mt_policy> lock(this);
-			const_iterator it = this->m_connected_slots.begin();
-			const_iterator itEnd = this->m_connected_slots.end();
-			
-			while (it != itEnd) {
-				if ((*it)->getdest()->areSlotsActive()) {
-					(*it)->shoot(a1, a2, a3, a4, a5, a6, a7, a8);
+		// Like pump(), but sleeps until there is at least one record or
+		// wake() is called. Emitters only make a system call to wake a
+		// sleeping pump.
+		std::size_t wait() {
+			for (;;) {
+				int wakeups = m_ring.wakeups();
+				std::size_t count = pump();
+				
+				if (count != 0 || _atomic_exchange(&m_woken, 0) != 0 || !isOpen()) {
+					return count;
 				}
-				++it;
+				
+				m_ring.sleep(wakeups);
 			}
 		}
 		
-		void operator()(arg1_type a1, arg2_type a2, arg3_type a3, arg4_type a4,
-		                arg5_type a5, arg6_type a6, arg7_type a7, arg8_type a8) {
-				shoot(a1,a2,a3,a4,a5,a6,a7,a8);
-
+		// Makes wait() return, from any thread of the pump's process.
+		void wake() {
+			_atomic_exchange(&m_woken, 1);
+			m_ring.wake();
+		}
+		
+		static void remove(const char *name) {
+			shm_unlink(name);
 		}
+		
+	private:
+		_ring m_ring;
+		volatile long m_woken;
 	};
 	
+#endif // SIGLY_ENABLE_SHARED_MEMORY
+	
+#ifdef SIGLY_EXTERN_TEMPLATES
+	SIGLY_INSTANCE class _signal_base<SIGLY_DEFAULT_MT_POLICY>;
+	SIGLY_INSTANCE class _emission<SIGLY_DEFAULT_MT_POLICY, _signal_base<SIGLY_DEFAULT_MT_POLICY>::connections_list>;
+	SIGLY_INSTANCE class HasSlots<SIGLY_DEFAULT_MT_POLICY>;
+	SIGLY_INSTANCE class Signal0<SIGLY_DEFAULT_MT_POLICY>;
+	SIGLY_INSTANCE class Signal1<int>;
+	SIGLY_INSTANCE class Signal1<bool>;
+	SIGLY_INSTANCE class Signal1<float>;
+	SIGLY_INSTANCE class Signal1<double>;
+#endif
+	
 } // namespace sigly
 
 #endif // SIGLY_H__
@@ -0,0 +1,74 @@
+// Timing and thread helpers shared by the benchmarks under tests/.
+
+#ifndef SIGLY_BENCHMARK_H__
+#define SIGLY_BENCHMARK_H__
+
+#include <cstdlib>
+#include <vector>
+#include <pthread.h>
+#include <time.h>
+
+namespace benchmark {
+	inline double seconds() {
+		timespec now;
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		return now.tv_sec + now.tv_nsec / 1e9;
+	}
+	
+	inline void sleepFor(double duration) {
+		timespec pause;
+		pause.tv_sec = time_t(duration);
+		pause.tv_nsec = long((duration - pause.tv_sec) * 1e9);
+		nanosleep(&pause, NULL);
+	}
+	
+	// Parses a comma-separated list of positive counts, such as "1,2,4,8".
+	inline std::vector<int> parseCounts(const char *list) {
+		std::vector<int> counts;
+		
+		while (*list != '\0') {
+			char *end;
+			long count = std::strtol(list, &end, 10);
+			
+			if (end == list || count <= 0) {
+				break;
+			}
+			
+			counts.push_back(int(count));
+			list = *end == ',' ? end + 1 : end;
+		}
+		
+		return counts;
+	}
+	
+	template<class task_type>
+	void *runTask(void *task) {
+		(*static_cast<task_type *>(task))();
+		return NULL;
+	}
+	
+	// Calls every task on a thread of its own, lets them run for the given
+	// number of seconds, calls stop() and joins them. Returns the seconds
+	// that actually elapsed between starting the first thread and joining
+	// the last one.
+	template<class task_type, class stop_type>
+	double runFor(std::vector<task_type> &tasks, double duration, stop_type &stop) {
+		std::vector<pthread_t> threads(tasks.size());
+		double start = seconds();
+		
+		for (std::size_t i = 0; i < tasks.size(); ++i) {
+			pthread_create(&threads[i], NULL, &runTask<task_type>, &tasks[i]);
+		}
+		
+		sleepFor(duration);
+		stop();
+		
+		for (std::size_t i = 0; i < tasks.size(); ++i) {
+			pthread_join(threads[i], NULL);
+		}
+		
+		return seconds() - start;
+	}
+}
+
+#endif // SIGLY_BENCHMARK_H__
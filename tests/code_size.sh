@@ -0,0 +1,39 @@
+#!/bin/sh
+# Builds signatures.cpp against the sigly.h of the working tree and against
+# the one of an earlier git revision, and prints the .text size of both.
+#
+# Usage: tests/code_size.sh <git revision> [compiler flags]
+# The flags default to -O2; the compiler is $CXX, or c++.
+
+set -e
+
+if [ $# -lt 1 ]; then
+	echo "usage: $0 <git revision> [compiler flags]" >&2
+	exit 2
+fi
+
+revision=$1
+shift
+flags=${*:--O2}
+cxx=${CXX:-c++}
+root=$(cd "$(dirname "$0")/.." && pwd)
+work=$(mktemp -d)
+trap 'rm -rf "$work"' EXIT
+
+mkdir "$work/before"
+git -C "$root" show "$revision:sigly.h" > "$work/before/sigly.h"
+
+text() {
+	size -A "$1" | awk '$1 == ".text" { print $2 }'
+}
+
+$cxx -std=c++98 $flags -I"$work/before" "$root/tests/signatures.cpp" -o "$work/before/signatures" -lpthread
+$cxx -std=c++98 $flags -I"$root" "$root/tests/signatures.cpp" -o "$work/signatures" -lpthread
+"$work/before/signatures" > /dev/null
+"$work/signatures" > /dev/null
+
+before=$(text "$work/before/signatures")
+after=$(text "$work/signatures")
+echo "$revision: $before bytes of .text"
+echo "working tree: $after bytes of .text"
+awk -v before="$before" -v after="$after" 'BEGIN { printf "change: %+d bytes (%+.1f%%)\n", after - before, (after - before) * 100 / before }'
@@ -0,0 +1,202 @@
+// Cost of emitting a signal whose 1000 slots belong to 16 receiver classes,
+// in CONNECTION_ORDER and in GROUPED_ORDER.
+//
+// The receivers are connected round-robin, one of each class in turn, so in
+// the order of connection every call goes to different code than the one
+// before. GROUPED_ORDER calls the slots of each class one after the other.
+// The program prints the nanoseconds per slot call and, on Linux when the
+// kernel lets the process count its own events (perf_event_paranoid at 2 or
+// less), the branch mispredictions and cache misses per slot call.
+//
+// Usage: sigly_dispatch [emissions per order]
+// The default is 20000.
+
+#include "sigly.h"
+#include "benchmark.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#ifdef __linux__
+#	include <linux/perf_event.h>
+#	include <sys/ioctl.h>
+#	include <sys/syscall.h>
+#	include <unistd.h>
+#else
+enum {
+	PERF_COUNT_HW_CACHE_MISSES,
+	PERF_COUNT_HW_BRANCH_MISSES
+};
+#endif
+
+namespace {
+	enum {
+		CLASSES = 16,
+		SLOTS = 1000
+	};
+	
+	// Counts one hardware event of the calling thread, if the system allows.
+	class Counter {
+	public:
+		Counter(unsigned long long event): m_descriptor(-1) {
+#ifdef __linux__
+			perf_event_attr attributes;
+			std::memset(&attributes, 0, sizeof(attributes));
+			attributes.size = sizeof(attributes);
+			attributes.type = PERF_TYPE_HARDWARE;
+			attributes.config = event;
+			attributes.disabled = 1;
+			attributes.exclude_kernel = 1;
+			attributes.exclude_hv = 1;
+			m_descriptor = int(syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0));
+#else
+			(void)event;
+#endif
+		}
+		
+		~Counter() {
+#ifdef __linux__
+			if (m_descriptor >= 0) {
+				close(m_descriptor);
+			}
+#endif
+		}
+		
+		bool available() const {
+			return m_descriptor >= 0;
+		}
+		
+		void start() {
+#ifdef __linux__
+			if (m_descriptor >= 0) {
+				ioctl(m_descriptor, PERF_EVENT_IOC_RESET, 0);
+				ioctl(m_descriptor, PERF_EVENT_IOC_ENABLE, 0);
+			}
+#endif
+		}
+		
+		// Stops counting and returns the count since start().
+		unsigned long long stop() {
+			unsigned long long count = 0;
+#ifdef __linux__
+			if (m_descriptor >= 0) {
+				ioctl(m_descriptor, PERF_EVENT_IOC_DISABLE, 0);
+				
+				if (read(m_descriptor, &count, sizeof(count)) != ssize_t(sizeof(count))) {
+					count = 0;
+				}
+			}
+#endif
+			return count;
+		}
+	
+	private:
+		Counter(const Counter &);
+		Counter &operator=(const Counter &);
+		
+		int m_descriptor;
+	};
+	
+	// Each class runs code of its own in its slot.
+	template<int K>
+	class Receiver : public sigly::HasSlots<> {
+	public:
+		Receiver(): m_sum(K) {
+		}
+		
+		void slot(int value) {
+			m_sum = (m_sum >> (K % 7 + 1)) + value * (K + 1);
+		}
+	
+	private:
+		long m_sum;
+	};
+	
+	// Allocates and connects one receiver of each class in turn.
+	template<int K>
+	struct Classes {
+		static void connect(sigly::Signal1<int> &signal, std::vector<sigly::HasSlots<> *> &receivers) {
+			Receiver<K> *receiver = new Receiver<K>();
+			signal.connect(receiver, &Receiver<K>::slot);
+			receivers.push_back(receiver);
+			Classes<K + 1>::connect(signal, receivers);
+		}
+	};
+	
+	template<>
+	struct Classes<CLASSES> {
+		static void connect(sigly::Signal1<int> &, std::vector<sigly::HasSlots<> *> &) {
+		}
+	};
+	
+	void measure(const char *name, sigly::Signal1<int> &signal, int emissions) {
+		Counter branches(PERF_COUNT_HW_BRANCH_MISSES);
+		Counter caches(PERF_COUNT_HW_CACHE_MISSES);
+		
+		for (int i = 0; i < emissions / 10; ++i) {
+			signal(i);
+		}
+		
+		double start = benchmark::seconds();
+		branches.start();
+		caches.start();
+		
+		for (int i = 0; i < emissions; ++i) {
+			signal(i);
+		}
+		
+		double calls = double(emissions) * SLOTS;
+		double branchMisses = branches.stop() / calls;
+		double cacheMisses = caches.stop() / calls;
+		double elapsed = benchmark::seconds() - start;
+		
+		std::printf("%-18s %8.2f ns per slot", name, elapsed * 1e9 / calls);
+		
+		if (branches.available()) {
+			std::printf("  %6.3f branch misses per slot", branchMisses);
+		} else {
+			std::printf("  branch misses n/a");
+		}
+		
+		if (caches.available()) {
+			std::printf("  %6.3f cache misses per slot", cacheMisses);
+		} else {
+			std::printf("  cache misses n/a");
+		}
+		
+		std::printf("\n");
+	}
+}
+
+int main(int argc, char **argv) {
+	int emissions = argc > 1 ? std::atoi(argv[1]) : 20000;
+	
+	if (emissions <= 0) {
+		std::fprintf(stderr, "usage: %s [emissions per order]\n", argv[0]);
+		return 2;
+	}
+	
+	sigly::Signal1<int> signal;
+	std::vector<sigly::HasSlots<> *> receivers;
+	
+	while (receivers.size() + CLASSES <= SLOTS) {
+		Classes<0>::connect(signal, receivers);
+	}
+	
+	while (receivers.size() < SLOTS) {
+		Receiver<0> *receiver = new Receiver<0>();
+		signal.connect(receiver, &Receiver<0>::slot);
+		receivers.push_back(receiver);
+	}
+	
+	measure("CONNECTION_ORDER", signal, emissions);
+	signal.setDispatchOrder(sigly::GROUPED_ORDER);
+	measure("GROUPED_ORDER", signal, emissions);
+	
+	for (std::size_t i = 0; i < receivers.size(); ++i) {
+		delete receivers[i];
+	}
+	
+	return 0;
+}
@@ -0,0 +1,124 @@
+// Checks that the slots of a KeyedSignal may connect and disconnect, on the
+// keyed signal they are called from, while it is shooting.
+//
+// Exits with a non-zero status and prints the failed checks on failure.
+
+#include "sigly.h"
+
+#include <cstdio>
+
+namespace {
+	typedef sigly::MultiThreadedLocal policy;
+	typedef sigly::KeyedSignal1<int, policy> Keyed;
+	
+	int g_failures = 0;
+	
+	void check(bool condition, const char *what) {
+		if (!condition) {
+			std::printf("FAILED: %s\n", what);
+			++g_failures;
+		}
+	}
+	
+	class Counter : public sigly::HasSlots<policy> {
+	public:
+		Counter(): calls(0) {
+		}
+		
+		void count(int) {
+			++calls;
+		}
+		
+		int calls;
+	};
+	
+	// Connects the other counter to the key and to a range holding it, the
+	// first time it is called.
+	class Connector : public sigly::HasSlots<policy> {
+	public:
+		Connector(Keyed &keyed, Counter &other): m_keyed(keyed), m_other(other), m_done(false) {
+		}
+		
+		void connect(int key) {
+			if (!m_done) {
+				m_done = true;
+				m_keyed.connect(key, &m_other, &Counter::count);
+				m_keyed.connect(key - 1, key + 1, &m_other, &Counter::count);
+			}
+		}
+		
+	private:
+		Keyed &m_keyed;
+		Counter &m_other;
+		bool m_done;
+	};
+	
+	// Disconnects itself, which prunes the signals it was called from.
+	class Leaver : public sigly::HasSlots<policy> {
+	public:
+		Leaver(Keyed &keyed): calls(0), m_keyed(keyed) {
+		}
+		
+		void leave(int) {
+			++calls;
+			m_keyed.disconnect(this);
+		}
+		
+		void clear(int) {
+			++calls;
+			m_keyed.disconnectAll();
+		}
+		
+		int calls;
+		
+	private:
+		Keyed &m_keyed;
+	};
+	
+	void connectFromSlot() {
+		Keyed keyed;
+		Counter counter;
+		Connector connector(keyed, counter);
+		keyed.connect(5, &connector, &Connector::connect);
+		keyed(5);
+		check(counter.calls <= 2, "a slot connected from a slot is called at most once per subscription");
+		counter.calls = 0;
+		keyed(5);
+		check(counter.calls == 2, "the exact and range subscriptions made from a slot are called");
+	}
+	
+	void disconnectFromSlot() {
+		Keyed keyed;
+		Leaver exact(keyed);
+		Leaver range(keyed);
+		Counter counter;
+		keyed.connect(3, &exact, &Leaver::leave);
+		keyed.connect(0, 9, &range, &Leaver::leave);
+		keyed.connect(3, &counter, &Counter::count);
+		keyed(3);
+		check(exact.calls == 1 && range.calls == 1 && counter.calls == 1, "slots that disconnect themselves are called once");
+		keyed(3);
+		check(exact.calls == 1 && range.calls == 1 && counter.calls == 2, "slots that disconnected themselves are not called again");
+	}
+	
+	void clearFromSlot() {
+		Keyed keyed;
+		Leaver leaver(keyed);
+		Counter counter;
+		keyed.connect(0, 9, &leaver, &Leaver::clear);
+		keyed.connect(3, &counter, &Counter::count);
+		keyed.connectAll(&counter, &Counter::count);
+		keyed(3);
+		check(leaver.calls == 1, "a slot clearing the keyed signal is called");
+		counter.calls = 0;
+		keyed(3);
+		check(leaver.calls == 1 && counter.calls == 0, "nothing is called once a slot cleared the keyed signal");
+	}
+}
+
+int main() {
+	connectFromSlot();
+	disconnectFromSlot();
+	clearFromSlot();
+	return g_failures != 0 ? 1 : 0;
+}
@@ -0,0 +1,147 @@
+// Checks that a LatencyBudget demotes a slot that keeps overrunning it to
+// the worker pool, emits demoted for it, and that the calls posted by the
+// demoted connection still run, with their arguments, once the signal that
+// posted them is gone.
+//
+// Exits with a non-zero status and prints the failed checks on failure.
+
+#include "sigly.h"
+#include "benchmark.h"
+
+#include <cstdio>
+#include <vector>
+#include <pthread.h>
+
+namespace {
+	typedef sigly::MultiThreadedLocal policy;
+	typedef sigly::Signal1<int, policy> Signal;
+	
+	int g_failures = 0;
+	
+	void check(bool condition, const char *what) {
+		if (!condition) {
+			std::printf("FAILED: %s\n", what);
+			++g_failures;
+		}
+	}
+	
+	// Sleeps for delay seconds, and then waits while it is held. Records the
+	// values it is called with and whether a call ran off the main thread.
+	class Slow : public sigly::HasSlots<policy> {
+	public:
+		Slow(): delay(0.002), held(0), calls(0), elsewhere(0), m_main(pthread_self()) {
+			pthread_mutex_init(&m_mutex, NULL);
+		}
+		
+		~Slow() {
+			disconnectAll();
+			pthread_mutex_destroy(&m_mutex);
+		}
+		
+		void call(int value) {
+			benchmark::sleepFor(delay);
+			
+			while (sigly::_atomic_load(&held) != 0) {
+				sigly::_thread_yield();
+			}
+			
+			if (!pthread_equal(pthread_self(), m_main)) {
+				sigly::_atomic_exchange(&elsewhere, 1);
+			}
+			
+			pthread_mutex_lock(&m_mutex);
+			values.push_back(value);
+			pthread_mutex_unlock(&m_mutex);
+			sigly::_atomic_increment(&calls);
+		}
+		
+		void waitFor(long count) {
+			while (sigly::_atomic_load(&calls) < count) {
+				benchmark::sleepFor(0.001);
+			}
+		}
+		
+		double delay;
+		volatile long held;
+		volatile long calls;
+		volatile long elsewhere;
+		std::vector<int> values;
+		
+	private:
+		pthread_t m_main;
+		pthread_mutex_t m_mutex;
+	};
+	
+	class Watcher : public sigly::HasSlots<policy> {
+	public:
+		Watcher(): demotions(0), signal(NULL), receiver(NULL) {
+		}
+		
+		void demoted(sigly::_signal_base<policy> *from, sigly::HasSlots<policy> *to) {
+			++demotions;
+			signal = from;
+			receiver = to;
+		}
+		
+		int demotions;
+		sigly::_signal_base<policy> *signal;
+		sigly::HasSlots<policy> *receiver;
+	};
+	
+	void demotesSlowSlot(sigly::ThreadPool &pool) {
+		sigly::LatencyBudget<policy> budget(500.0, 2, &pool);
+		Watcher watcher;
+		budget.demoted.connect(&watcher, &Watcher::demoted);
+		Signal signal;
+		signal.setLatencyBudget(&budget);
+		Slow slow;
+		signal.connect(&slow, &Slow::call);
+		signal(0);
+		check(watcher.demotions == 0, "one overrun is not enough to demote a slot");
+		signal(1);
+		check(watcher.demotions == 1, "demoted is emitted once the slot overran the budget strikes times in a row");
+		check(watcher.signal == &signal && watcher.receiver == &slow, "demoted names the signal and the receiver");
+		check(sigly::_atomic_load(&slow.elsewhere) == 0, "the calls before the demotion run on the emitting thread");
+		signal(2);
+		slow.waitFor(3);
+		check(sigly::_atomic_load(&slow.elsewhere) == 1, "the calls after the demotion run on the worker");
+		check(signal.connectionCount() == 1, "the demoted connection replaces the original");
+		check(signal.disconnect(&slow, &Slow::call), "the demoted connection is found by its slot");
+	}
+	
+	// The worker is held while the demoted connection posts calls, and the
+	// signal is destroyed before it is let go.
+	void keepsTarget(sigly::ThreadPool &pool) {
+		sigly::LatencyBudget<policy> budget(500.0, 1, &pool);
+		Slow slow;
+		{
+			Signal signal;
+			signal.setLatencyBudget(&budget);
+			signal.connect(&slow, &Slow::call);
+			signal(0);
+			slow.delay = 0;
+			sigly::_atomic_exchange(&slow.held, 1);
+			
+			for (int i = 1; i <= 5; ++i) {
+				signal(i);
+			}
+		}
+		sigly::_atomic_exchange(&slow.held, 0);
+		slow.waitFor(6);
+		bool complete = slow.values.size() == 6;
+		int sum = 0;
+		
+		for (std::size_t i = 0; i < slow.values.size(); ++i) {
+			sum += slow.values[i];
+		}
+		
+		check(complete && sum == 15, "the calls posted before the signal was destroyed run with their arguments");
+	}
+}
+
+int main() {
+	sigly::ThreadPool pool(2);
+	demotesSlowSlot(pool);
+	keepsTarget(pool);
+	return g_failures != 0 ? 1 : 0;
+}
@@ -0,0 +1,148 @@
+// Checks that a Payload emitted through queued connections reaches every
+// receiver, on the threads of a ThreadPool, with the bytes it was filled
+// with and without being copied, and that a PayloadPool reuses the buffer
+// once the last receiver is done with it.
+//
+// Exits with a non-zero status and prints the failed checks on failure.
+
+#include "sigly.h"
+#include "benchmark.h"
+
+#include <cstdio>
+
+namespace {
+	typedef sigly::MultiThreadedLocal policy;
+	
+	int g_failures = 0;
+	
+	void check(bool condition, const char *what) {
+		if (!condition) {
+			std::printf("FAILED: %s\n", what);
+			++g_failures;
+		}
+	}
+	
+	enum {
+		SIZE = 4096,
+		RECEIVERS = 8,
+		EMISSIONS = 100
+	};
+	
+	unsigned char pattern(int emission, std::size_t i) {
+		return (unsigned char)(emission * 31 + i * 7);
+	}
+	
+	// Compares each payload with the pattern of the emission it carries in
+	// its first byte. The pool may run several calls of a receiver at once.
+	class Reader : public sigly::HasSlots<policy> {
+	public:
+		Reader(): calls(0), mismatches(0), last(NULL) {
+		}
+		
+		void read(sigly::Payload payload) {
+			int emission = payload.data()[0];
+			
+			if (payload.size() != SIZE || payload.buffer() != NULL) {
+				sigly::_atomic_increment(&mismatches);
+			}
+			
+			for (std::size_t i = 1; i < payload.size(); ++i) {
+				if (payload.data()[i] != pattern(emission, i)) {
+					sigly::_atomic_increment(&mismatches);
+					break;
+				}
+			}
+			
+			sigly::_atomic_exchange(&last, const_cast<unsigned char *>(payload.data()));
+			sigly::_atomic_increment(&calls);
+		}
+		
+		volatile long calls;
+		volatile long mismatches;
+		void *volatile last;
+	};
+	
+	sigly::Payload fill(sigly::Payload payload, int emission) {
+		unsigned char *bytes = payload.buffer();
+		bytes[0] = (unsigned char)emission;
+		
+		for (std::size_t i = 1; i < payload.size(); ++i) {
+			bytes[i] = pattern(emission, i);
+		}
+		
+		return payload;
+	}
+	
+	void roundTrip() {
+		sigly::ThreadPool pool(3);
+		sigly::PayloadPool<policy> payloads(SIZE, 2);
+		sigly::Signal1<sigly::Payload, policy> signal;
+		Reader readers[RECEIVERS];
+		
+		for (int i = 0; i < RECEIVERS; ++i) {
+			readers[i].moveToExecutor(&pool);
+			signal.connect(&readers[i], &Reader::read, sigly::QUEUED_CONNECTION);
+		}
+		
+		for (int emission = 0; emission < EMISSIONS; ++emission) {
+			signal(fill(payloads.allocate(), emission));
+		}
+		
+		long calls = 0;
+		
+		while (calls != RECEIVERS * EMISSIONS) {
+			benchmark::sleepFor(0.001);
+			calls = 0;
+			
+			for (int i = 0; i < RECEIVERS; ++i) {
+				calls += sigly::_atomic_load(&readers[i].calls);
+			}
+		}
+		
+		long mismatches = 0;
+		
+		for (int i = 0; i < RECEIVERS; ++i) {
+			mismatches += sigly::_atomic_load(&readers[i].mismatches);
+			readers[i].moveToExecutor(NULL);
+		}
+		
+		check(mismatches == 0, "every receiver reads the bytes the payload was filled with");
+	}
+	
+	// On one thread, so that the buffer each receiver saw can be compared.
+	void sharesBuffer() {
+		sigly::EventLoop loop;
+		sigly::PayloadPool<policy> payloads(SIZE);
+		sigly::Signal1<sigly::Payload, policy> signal;
+		Reader readers[RECEIVERS];
+		
+		for (int i = 0; i < RECEIVERS; ++i) {
+			readers[i].moveToEventLoop(&loop);
+			signal.connect(&readers[i], &Reader::read, sigly::QUEUED_CONNECTION);
+		}
+		
+		const unsigned char *buffer;
+		{
+			sigly::Payload payload = fill(payloads.allocate(), 1);
+			buffer = payload.data();
+			signal(payload);
+			check(payload.useCount() == RECEIVERS + 1, "each queued call holds the payload");
+		}
+		loop.processEvents();
+		bool shared = true;
+		
+		for (int i = 0; i < RECEIVERS; ++i) {
+			shared = shared && readers[i].last == buffer && readers[i].mismatches == 0;
+			readers[i].moveToEventLoop(NULL);
+		}
+		
+		check(shared, "every receiver reads the one buffer that was emitted");
+		check(payloads.allocate().data() == buffer, "the pool reuses the buffer once the receivers are done");
+	}
+}
+
+int main() {
+	roundTrip();
+	sharesBuffer();
+	return g_failures != 0 ? 1 : 0;
+}
@@ -0,0 +1,244 @@
+// Checks what a bounded executor queue does with the calls posted while it
+// is full, under each OverflowPolicy, and what queueStats() counts.
+//
+// Exits with a non-zero status and prints the failed checks on failure.
+
+#include "sigly.h"
+#include "benchmark.h"
+
+#include <cstdio>
+#include <vector>
+#include <pthread.h>
+
+namespace {
+	typedef sigly::MultiThreadedLocal policy;
+	
+	int g_failures = 0;
+	
+	void check(bool condition, const char *what) {
+		if (!condition) {
+			std::printf("FAILED: %s\n", what);
+			++g_failures;
+		}
+	}
+	
+	class Receiver : public sigly::HasSlots<policy> {
+	public:
+		void first(int value) {
+			values.push_back(value);
+		}
+		
+		void second(int value) {
+			values.push_back(1000 + value);
+		}
+		
+		std::vector<int> values;
+	};
+	
+	bool equals(const std::vector<int> &values, int a, int b) {
+		return values.size() == 2 && values[0] == a && values[1] == b;
+	}
+	
+	// Shoots the signal once from a thread of its own.
+	class Emitter {
+	public:
+		Emitter(sigly::Signal1<int, policy> &signal): done(0), m_signal(signal) {
+			pthread_create(&m_thread, NULL, &Emitter::run, this);
+		}
+		
+		~Emitter() {
+			pthread_join(m_thread, NULL);
+		}
+		
+		volatile long done;
+		
+	private:
+		static void *run(void *emitter) {
+			Emitter *self = static_cast<Emitter *>(emitter);
+			self->m_signal(1);
+			sigly::_atomic_exchange(&self->done, 1);
+			return NULL;
+		}
+		
+		sigly::Signal1<int, policy> &m_signal;
+		pthread_t m_thread;
+	};
+	
+	void waitForBlocked(sigly::EventLoop &loop, unsigned long blocked) {
+		while (loop.queueStats().blocked < blocked) {
+			benchmark::sleepFor(0.0001);
+		}
+	}
+	
+	void dropNewest() {
+		sigly::EventLoop loop;
+		Receiver receiver;
+		receiver.moveToEventLoop(&loop);
+		sigly::Signal1<int, policy> signal;
+		signal.connect(&receiver, &Receiver::first, sigly::QUEUED_CONNECTION);
+		loop.setQueueBound(2, sigly::DROP_NEWEST);
+		
+		for (int i = 0; i < 5; ++i) {
+			signal(i);
+		}
+		
+		sigly::QueueStats stats = loop.queueStats();
+		check(stats.size == 2 && stats.capacity == 2, "DROP_NEWEST keeps the queue at its bound");
+		check(stats.dropped == 3 && stats.highWater == 2, "DROP_NEWEST counts the dropped calls");
+		loop.processEvents();
+		check(equals(receiver.values, 0, 1), "DROP_NEWEST keeps the first calls");
+		receiver.moveToEventLoop(NULL);
+	}
+	
+	void dropOldest() {
+		sigly::EventLoop loop;
+		Receiver receiver;
+		receiver.moveToEventLoop(&loop);
+		sigly::Signal1<int, policy> signal;
+		signal.connect(&receiver, &Receiver::first, sigly::QUEUED_CONNECTION);
+		loop.setQueueBound(2, sigly::DROP_OLDEST);
+		
+		for (int i = 0; i < 5; ++i) {
+			signal(i);
+		}
+		
+		check(loop.queueStats().dropped == 3, "DROP_OLDEST counts the dropped calls");
+		loop.processEvents();
+		check(equals(receiver.values, 3, 4), "DROP_OLDEST keeps the last calls");
+		receiver.moveToEventLoop(NULL);
+	}
+	
+	// Each connection keeps one call queued, the latest, in the place of
+	// the first one.
+	void coalesce() {
+		sigly::EventLoop loop;
+		Receiver receiver;
+		receiver.moveToEventLoop(&loop);
+		sigly::Signal1<int, policy> a;
+		sigly::Signal1<int, policy> b;
+		a.connect(&receiver, &Receiver::first, sigly::QUEUED_CONNECTION);
+		b.connect(&receiver, &Receiver::second, sigly::QUEUED_CONNECTION);
+		loop.setQueueBound(0, sigly::COALESCE);
+		
+		for (int i = 0; i < 10; ++i) {
+			a(i);
+			b(i);
+		}
+		
+		sigly::QueueStats stats = loop.queueStats();
+		check(stats.size == 2 && stats.coalesced == 18, "COALESCE counts the replaced calls");
+		loop.processEvents();
+		check(equals(receiver.values, 9, 1009), "COALESCE keeps the latest call of each connection in the place of the first");
+		receiver.moveToEventLoop(NULL);
+	}
+	
+	// Connections given the same key replace each other's calls.
+	void coalesceByKey() {
+		static const char key = 0;
+		sigly::EventLoop loop;
+		Receiver receiver;
+		receiver.moveToEventLoop(&loop);
+		sigly::Signal1<int, policy> a;
+		sigly::Signal1<int, policy> b;
+		a.connect(&receiver, &Receiver::first, sigly::QUEUED_CONNECTION, &key);
+		b.connect(&receiver, &Receiver::second, sigly::QUEUED_CONNECTION, &key);
+		loop.setQueueBound(0, sigly::COALESCE);
+		a(1);
+		b(2);
+		a(3);
+		check(loop.queueStats().size == 1, "calls with the same key share one place");
+		loop.processEvents();
+		check(receiver.values.size() == 1 && receiver.values[0] == 3, "the latest call with a key replaces the others");
+		receiver.moveToEventLoop(NULL);
+	}
+	
+	// The calls queued before the switch to COALESCE are replaced too.
+	void coalesceQueued() {
+		sigly::EventLoop loop;
+		Receiver receiver;
+		receiver.moveToEventLoop(&loop);
+		sigly::Signal1<int, policy> a;
+		sigly::Signal1<int, policy> b;
+		a.connect(&receiver, &Receiver::first, sigly::QUEUED_CONNECTION);
+		b.connect(&receiver, &Receiver::second, sigly::QUEUED_CONNECTION);
+		a(1);
+		b(2);
+		loop.setQueueBound(0, sigly::COALESCE);
+		b(3);
+		a(4);
+		check(loop.queueStats().coalesced == 2, "calls queued before the switch to COALESCE are replaced");
+		loop.processEvents();
+		check(equals(receiver.values, 4, 1003), "calls queued before the switch to COALESCE keep their place");
+		receiver.moveToEventLoop(NULL);
+	}
+	
+	// A thread posting to the full queue of a loop run by another waits
+	// until the loop makes room.
+	void blockEmitter() {
+		sigly::EventLoop loop;
+		Receiver receiver;
+		receiver.moveToEventLoop(&loop);
+		sigly::Signal1<int, policy> signal;
+		signal.connect(&receiver, &Receiver::first, sigly::QUEUED_CONNECTION);
+		loop.setQueueBound(1, sigly::BLOCK_EMITTER);
+		signal(0);
+		{
+			Emitter emitter(signal);
+			waitForBlocked(loop, 1);
+			check(sigly::_atomic_load(&emitter.done) == 0, "BLOCK_EMITTER makes the emitter wait for room");
+			loop.processEvents();
+		}
+		loop.processEvents();
+		check(equals(receiver.values, 0, 1), "BLOCK_EMITTER posts the call once there is room");
+		sigly::QueueStats stats = loop.queueStats();
+		check(stats.blocked == 1 && stats.dropped == 0 && stats.highWater == 1, "BLOCK_EMITTER counts the posts that waited");
+		
+		// The loop's own thread goes over the bound rather than waiting.
+		for (int i = 0; i < 3; ++i) {
+			signal(i);
+		}
+		
+		check(loop.queueStats().size == 3, "the loop's own thread does not wait for room");
+		loop.processEvents();
+		receiver.moveToEventLoop(NULL);
+	}
+	
+	// Destroying the loop releases the emitters waiting for room.
+	void releaseOnClose() {
+		Receiver receiver;
+		sigly::Signal1<int, policy> signal;
+		Emitter *emitters[3];
+		{
+			sigly::EventLoop loop;
+			receiver.moveToEventLoop(&loop);
+			signal.connect(&receiver, &Receiver::first, sigly::QUEUED_CONNECTION);
+			loop.setQueueBound(1, sigly::BLOCK_EMITTER);
+			signal(0);
+			
+			for (int i = 0; i < 3; ++i) {
+				emitters[i] = new Emitter(signal);
+			}
+			
+			waitForBlocked(loop, 3);
+			signal.disconnectAll();
+			receiver.moveToEventLoop(NULL);
+		}
+		
+		for (int i = 0; i < 3; ++i) {
+			delete emitters[i];
+		}
+		
+		check(receiver.values.empty(), "the calls of a destroyed loop are dropped");
+	}
+}
+
+int main() {
+	dropNewest();
+	dropOldest();
+	coalesce();
+	coalesceByKey();
+	coalesceQueued();
+	blockEmitter();
+	releaseOnClose();
+	return g_failures != 0 ? 1 : 0;
+}
@@ -0,0 +1,105 @@
+// Checks that Computed values emit changed for every change of their
+// inputs, including values that were never read with get().
+//
+// Exits with a non-zero status and prints the failed checks on failure.
+
+#include "sigly.h"
+
+#include <cstdio>
+#include <vector>
+
+namespace {
+	int g_failures = 0;
+	
+	void check(bool condition, const char *what) {
+		if (!condition) {
+			std::printf("FAILED: %s\n", what);
+			++g_failures;
+		}
+	}
+	
+	bool equals(const std::vector<int> &values, int a, int b, int c) {
+		return values.size() == 3 && values[0] == a && values[1] == b && values[2] == c;
+	}
+	
+	class Model : public sigly::HasSlots<> {
+	public:
+		Model(): doubled(this, &Model::computeDoubled), shifted(this, &Model::computeShifted) {
+		}
+		
+		int computeDoubled() {
+			return input.get() * 2;
+		}
+		
+		int computeShifted() {
+			return doubled.get() + 1;
+		}
+		
+		void record(const int &value) {
+			values.push_back(value);
+		}
+		
+		sigly::Property<int> input;
+		sigly::Computed<int> doubled;
+		sigly::Computed<int> shifted;
+		std::vector<int> values;
+	};
+	
+	// The value is observed before it was ever computed.
+	void observedBeforeRead() {
+		Model model;
+		model.doubled.dependsOn(model.input);
+		model.doubled.changed.connect(&model, &Model::record);
+		model.input = 1;
+		model.input = 2;
+		model.input = 3;
+		check(equals(model.values, 2, 4, 6), "an observed value that was never read emits every change");
+	}
+	
+	// Only the end of a chain is observed, and the chain is built from its
+	// end, so the value in the middle is invalidated after its dependent.
+	void observedChain() {
+		Model model;
+		model.shifted.dependsOn(model.doubled);
+		model.doubled.dependsOn(model.input);
+		model.shifted.changed.connect(&model, &Model::record);
+		model.input = 1;
+		model.input = 2;
+		model.input = 3;
+		check(equals(model.values, 3, 5, 7), "the observed end of a chain emits every change");
+	}
+	
+	// The value went dirty before it was observed.
+	void observedWhileDirty() {
+		Model model;
+		model.doubled.dependsOn(model.input);
+		model.input = 5;
+		model.doubled.changed.connect(&model, &Model::record);
+		model.input = 1;
+		model.input = 2;
+		model.input = 3;
+		check(equals(model.values, 2, 4, 6), "a value observed while dirty emits every change");
+	}
+	
+	void batched() {
+		Model model;
+		model.doubled.dependsOn(model.input);
+		model.doubled.changed.connect(&model, &Model::record);
+		
+		for (int i = 1; i <= 3; ++i) {
+			sigly::ReactiveBatch batch;
+			model.input = i * 10;
+			model.input = i;
+		}
+		
+		check(equals(model.values, 2, 4, 6), "a batch emits the last value once");
+	}
+}
+
+int main() {
+	observedBeforeRead();
+	observedChain();
+	observedWhileDirty();
+	batched();
+	return g_failures != 0 ? 1 : 0;
+}
@@ -0,0 +1,185 @@
+// Emission throughput of MultiThreadedReadMostly against MultiThreadedLocal
+// on a signal whose connections rarely change.
+//
+// Emitting threads call one shared Signal1<int> with eight receivers, while
+// one more thread connects and disconnects a ninth receiver at a fixed
+// interval, so the published connection list of MultiThreadedReadMostly is
+// replaced during the run. For each policy and thread count, the program
+// prints the emissions per second and the number of changes made.
+//
+// Usage: sigly_read_mostly [seconds per run] [comma-separated thread counts]
+//        [milliseconds between changes]
+// The defaults are 0.5, 1,2,4,8 and 10.
+//
+// Before measuring, the program checks that a slot may destroy a receiver
+// connected after it to the same signal, and exits with a non-zero status
+// if the destroyed receiver is still called.
+
+#include "sigly.h"
+#include "benchmark.h"
+
+#include <cstdio>
+
+namespace {
+	enum {
+		RECEIVERS = 8
+	};
+	
+	template<class mt_policy>
+	class Receiver : public sigly::HasSlots<mt_policy> {
+	public:
+		Receiver(): m_limit(-1), m_hits(0) {
+		}
+		
+		void slot(int value) {
+			if (value == m_limit) {
+				++m_hits;
+			}
+		}
+	
+	private:
+		int m_limit;
+		long m_hits;
+	};
+	
+	class Victim : public sigly::HasSlots<sigly::MultiThreadedReadMostly> {
+	public:
+		explicit Victim(int *calls): m_calls(calls) {
+		}
+		
+		void slot(int) {
+			++*m_calls;
+		}
+		
+	private:
+		int *m_calls;
+	};
+	
+	class Killer : public sigly::HasSlots<sigly::MultiThreadedReadMostly> {
+	public:
+		explicit Killer(Victim *victim): m_victim(victim) {
+		}
+		
+		void slot(int) {
+			delete m_victim;
+			m_victim = NULL;
+		}
+		
+	private:
+		Victim *m_victim;
+	};
+	
+	// The published array of the emission still holds the connection of
+	// the victim when the killer destroys it.
+	bool destroyedFromSlot() {
+		sigly::Signal1<int, sigly::MultiThreadedReadMostly> signal;
+		int calls = 0;
+		Victim *victim = new Victim(&calls);
+		Killer killer(victim);
+		signal.connect(&killer, &Killer::slot);
+		signal.connect(victim, &Victim::slot);
+		signal(1);
+		signal(2);
+		return calls == 0 && signal.connectionCount() == 1;
+	}
+	
+	struct Stop {
+		Stop(): stopped(0) {
+		}
+		
+		void operator()() {
+			sigly::_atomic_exchange(&stopped, 1);
+		}
+		
+		volatile long stopped;
+	};
+	
+	// Emits the signal, or, for the writer, changes its connections every
+	// interval seconds.
+	template<class mt_policy>
+	struct Task {
+		void operator()() {
+			if (writer) {
+				change();
+				return;
+			}
+			
+			while (!sigly::_atomic_load(&stop->stopped)) {
+				for (int i = 0; i < 64; ++i) {
+					(*signal)(i);
+				}
+				
+				count += 64;
+			}
+		}
+		
+		void change() {
+			Receiver<mt_policy> extra;
+			
+			while (!sigly::_atomic_load(&stop->stopped)) {
+				benchmark::sleepFor(interval);
+				signal->connect(&extra, &Receiver<mt_policy>::slot);
+				signal->disconnect(&extra);
+				count += 2;
+			}
+		}
+		
+		sigly::Signal1<int, mt_policy> *signal;
+		Stop *stop;
+		bool writer;
+		double interval;
+		unsigned long count;
+	};
+	
+	template<class mt_policy>
+	void measure(const char *name, double duration, const std::vector<int> &threads, double interval) {
+		for (std::size_t t = 0; t < threads.size(); ++t) {
+			sigly::Signal1<int, mt_policy> signal;
+			Receiver<mt_policy> receivers[RECEIVERS];
+			Stop stop;
+			std::vector<Task<mt_policy> > tasks(threads[t] + 1);
+			
+			for (int i = 0; i < RECEIVERS; ++i) {
+				signal.connect(&receivers[i], &Receiver<mt_policy>::slot);
+			}
+			
+			for (std::size_t i = 0; i < tasks.size(); ++i) {
+				tasks[i].signal = &signal;
+				tasks[i].stop = &stop;
+				tasks[i].writer = i == 0;
+				tasks[i].interval = interval;
+				tasks[i].count = 0;
+			}
+			
+			double elapsed = benchmark::runFor(tasks, duration, stop);
+			unsigned long emissions = 0;
+			
+			for (std::size_t i = 1; i < tasks.size(); ++i) {
+				emissions += tasks[i].count;
+			}
+			
+			std::printf("%-24s %3d threads %12.0f emissions/s %12.0f per thread %6lu changes\n", name, threads[t], emissions / elapsed, emissions / elapsed / threads[t], tasks[0].count);
+			std::fflush(stdout);
+		}
+	}
+}
+
+int main(int argc, char **argv) {
+	double duration = argc > 1 ? std::atof(argv[1]) : 0.5;
+	std::vector<int> threads = benchmark::parseCounts(argc > 2 ? argv[2] : "1,2,4,8");
+	double interval = (argc > 3 ? std::atof(argv[3]) : 10) / 1000;
+	
+	if (duration <= 0 || threads.empty() || interval <= 0) {
+		std::fprintf(stderr, "usage: %s [seconds per run] [thread counts, e.g. 1,2,4,8] [milliseconds between changes]\n", argv[0]);
+		return 2;
+	}
+	
+	if (!destroyedFromSlot()) {
+		std::printf("FAILED: a receiver destroyed by an earlier slot was called\n");
+		return 1;
+	}
+	
+	measure<sigly::MultiThreadedLocal>("MultiThreadedLocal", duration, threads, interval);
+	measure<sigly::MultiThreadedReadMostly>("MultiThreadedReadMostly", duration, threads, interval);
+	return 0;
+}
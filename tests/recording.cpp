@@ -0,0 +1,156 @@
+// Checks that what a Recorder writes replays into the bound signals with the
+// arguments that were emitted, in order, including the emissions of several
+// threads at once, and that records that do not match the bound signal are
+// skipped.
+//
+// Exits with a non-zero status and prints the failed checks on failure.
+
+#define SIGLY_ENABLE_RECORDING
+#include "sigly.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <pthread.h>
+
+namespace {
+	int g_failures = 0;
+	
+	void check(bool condition, const char *what) {
+		if (!condition) {
+			std::printf("FAILED: %s\n", what);
+			++g_failures;
+		}
+	}
+	
+	const char *const PATH = "sigly_recording.bin";
+	
+	enum {
+		THREADS = 4,
+		PER_THREAD = 5000
+	};
+	
+	struct Sample {
+		int id;
+		double value;
+		char name[12];
+	};
+	
+	class Sink : public sigly::HasSlots<> {
+	public:
+		Sink(): zeros(0), total(0) {
+		}
+		
+		void integer(int value) {
+			integers.push_back(value);
+		}
+		
+		void sample(const Sample &value, float scale) {
+			samples.push_back(value);
+			scales.push_back(scale);
+		}
+		
+		void zero() {
+			++zeros;
+		}
+		
+		void add(int) {
+			sigly::_atomic_increment(&total);
+		}
+		
+		std::vector<int> integers;
+		std::vector<Sample> samples;
+		std::vector<float> scales;
+		int zeros;
+		volatile long total;
+	};
+	
+	void *emit(void *signal) {
+		for (int i = 0; i < PER_THREAD; ++i) {
+			(*static_cast<sigly::Signal1<int> *>(signal))(i);
+		}
+		
+		return NULL;
+	}
+	
+	Sample makeSample(int id) {
+		Sample sample;
+		std::memset(&sample, 0, sizeof(sample));
+		sample.id = id;
+		sample.value = id * 0.25;
+		std::sprintf(sample.name, "sample %d", id);
+		return sample;
+	}
+	
+	bool same(const Sample &a, const Sample &b) {
+		return std::memcmp(&a, &b, sizeof(Sample)) == 0;
+	}
+	
+	void record() {
+		sigly::Signal1<int> integer;
+		sigly::Signal2<const Sample &, float> sample;
+		sigly::Signal0<> zero;
+		sigly::Signal1<int> concurrent;
+		sigly::Recorder recorder(PATH, 4 << 20);
+		check(recorder.isOpen(), "the recorder opens its file");
+		recorder.record(integer, 1);
+		recorder.record(sample, 2);
+		recorder.record(zero, 3);
+		recorder.record(concurrent, 4);
+		integer(5);
+		sample(makeSample(1), 0.5f);
+		zero();
+		sample(makeSample(2), 2.0f);
+		integer(-7);
+		pthread_t threads[THREADS];
+		
+		for (int i = 0; i < THREADS; ++i) {
+			pthread_create(&threads[i], NULL, &emit, &concurrent);
+		}
+		
+		for (int i = 0; i < THREADS; ++i) {
+			pthread_join(threads[i], NULL);
+		}
+		
+		check(recorder.dropped() == 0, "nothing is dropped while the file has room");
+	}
+	
+	void replay() {
+		sigly::Replayer replayer(PATH);
+		check(replayer.isOpen(), "the replayer opens the recorded file");
+		sigly::Signal1<int> integer;
+		sigly::Signal2<const Sample &, float> sample;
+		sigly::Signal0<> zero;
+		sigly::Signal1<int> concurrent;
+		Sink sink;
+		integer.connect(&sink, &Sink::integer);
+		sample.connect(&sink, &Sink::sample);
+		zero.connect(&sink, &Sink::zero);
+		concurrent.connect(&sink, &Sink::add);
+		replayer.bind(1, integer);
+		replayer.bind(2, sample);
+		replayer.bind(3, zero);
+		replayer.bind(4, concurrent);
+		check(replayer.replay(sigly::MAXIMUM_SPEED) == 5 + THREADS * PER_THREAD, "every record is emitted again");
+		check(sink.integers.size() == 2 && sink.integers[0] == 5 && sink.integers[1] == -7, "integers replay in order with their values");
+		check(sink.samples.size() == 2 && same(sink.samples[0], makeSample(1)) && same(sink.samples[1], makeSample(2)), "structures replay with their bytes");
+		check(sink.scales.size() == 2 && sink.scales[0] == 0.5f && sink.scales[1] == 2.0f, "the second argument replays with its value");
+		check(sink.zeros == 1, "emissions without arguments replay");
+		check(sink.total == THREADS * PER_THREAD, "the emissions of several threads all replay");
+	}
+	
+	void skipMismatch() {
+		sigly::Replayer replayer(PATH);
+		sigly::Signal2<int, int> wrong;
+		replayer.bind(1, wrong);
+		check(replayer.replay(sigly::MAXIMUM_SPEED) == 0, "records whose size does not match the bound signal are skipped");
+	}
+}
+
+int main() {
+	record();
+	replay();
+	skipMismatch();
+	std::remove(PATH);
+	return g_failures != 0 ? 1 : 0;
+}
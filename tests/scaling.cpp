@@ -0,0 +1,125 @@
+// Emission throughput of one signal shared by a growing number of threads.
+//
+// Every thread emits the same Signal1<int> as fast as it can. The slots only
+// read their receiver, so the writes that remain are those of the policy's
+// lock: the single global mutex of MultiThreadedGlobal, the signal's mutex
+// with MultiThreadedLocal, and one of SIGLY_SHARD_COUNT cache-line-aligned
+// mutexes with MultiThreadedSharded. For each policy and thread count, the
+// program prints the emissions per second of all the threads together, per
+// thread, and relative to one thread.
+//
+// The speed-up only shows on a machine with at least as many cores as
+// threads; run it with as many threads as there are cores, e.g.
+// sigly_scaling 1 1,2,4,8,16,32,64.
+//
+// Usage: sigly_scaling [seconds per run] [comma-separated thread counts]
+// The defaults are 0.5 and 1,2,4,8,16,32,64.
+
+#include "sigly.h"
+#include "benchmark.h"
+
+#include <cstdio>
+
+namespace {
+	enum {
+		RECEIVERS = 4
+	};
+	
+	template<class mt_policy>
+	class Receiver : public sigly::HasSlots<mt_policy> {
+	public:
+		Receiver(): m_limit(-1), m_hits(0) {
+		}
+		
+		void slot(int value) {
+			if (value == m_limit) {
+				++m_hits;
+			}
+		}
+	
+	private:
+		int m_limit;
+		long m_hits;
+	};
+	
+	struct Stop {
+		Stop(): stopped(0) {
+		}
+		
+		void operator()() {
+			sigly::_atomic_exchange(&stopped, 1);
+		}
+		
+		volatile long stopped;
+	};
+	
+	template<class mt_policy>
+	struct Emitter {
+		void operator()() {
+			while (!sigly::_atomic_load(&stop->stopped)) {
+				for (int i = 0; i < 64; ++i) {
+					(*signal)(i);
+				}
+				
+				emissions += 64;
+			}
+		}
+		
+		sigly::Signal1<int, mt_policy> *signal;
+		Stop *stop;
+		unsigned long emissions;
+	};
+	
+	template<class mt_policy>
+	void measure(const char *name, double duration, const std::vector<int> &threads) {
+		double single = 0;
+		
+		for (std::size_t t = 0; t < threads.size(); ++t) {
+			sigly::Signal1<int, mt_policy> signal;
+			Receiver<mt_policy> receivers[RECEIVERS];
+			Stop stop;
+			std::vector<Emitter<mt_policy> > emitters(threads[t]);
+			
+			for (int i = 0; i < RECEIVERS; ++i) {
+				signal.connect(&receivers[i], &Receiver<mt_policy>::slot);
+			}
+			
+			for (int i = 0; i < threads[t]; ++i) {
+				emitters[i].signal = &signal;
+				emitters[i].stop = &stop;
+				emitters[i].emissions = 0;
+			}
+			
+			double elapsed = benchmark::runFor(emitters, duration, stop);
+			unsigned long total = 0;
+			
+			for (int i = 0; i < threads[t]; ++i) {
+				total += emitters[i].emissions;
+			}
+			
+			double rate = total / elapsed;
+			
+			if (t == 0) {
+				single = rate / threads[t];
+			}
+			
+			std::printf("%-22s %3d threads %12.0f emissions/s %12.0f per thread %6.2fx\n", name, threads[t], rate, rate / threads[t], rate / single);
+			std::fflush(stdout);
+		}
+	}
+}
+
+int main(int argc, char **argv) {
+	double duration = argc > 1 ? std::atof(argv[1]) : 0.5;
+	std::vector<int> threads = benchmark::parseCounts(argc > 2 ? argv[2] : "1,2,4,8,16,32,64");
+	
+	if (duration <= 0 || threads.empty()) {
+		std::fprintf(stderr, "usage: %s [seconds per run] [thread counts, e.g. 1,2,4,8]\n", argv[0]);
+		return 2;
+	}
+	
+	measure<sigly::MultiThreadedGlobal>("MultiThreadedGlobal", duration, threads);
+	measure<sigly::MultiThreadedLocal>("MultiThreadedLocal", duration, threads);
+	measure<sigly::MultiThreadedSharded>("MultiThreadedSharded", duration, threads);
+	return 0;
+}
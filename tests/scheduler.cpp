@@ -0,0 +1,160 @@
+// Checks that a Scheduler fires its timers on the tick they are due, that
+// moving time forward skips the ticks without a timer at once, and that
+// exec() sleeps until the earliest timer rather than waking every tick.
+//
+// Exits with a non-zero status and prints the failed checks on failure.
+
+#include "sigly.h"
+#include "benchmark.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+
+namespace {
+	int g_failures = 0;
+	
+	void check(bool condition, const char *what) {
+		if (!condition) {
+			std::printf("FAILED: %s\n", what);
+			++g_failures;
+		}
+	}
+	
+	// Records the tick each emission came on, along with the tick it was
+	// expected on.
+	class Recorder : public sigly::HasSlots<> {
+	public:
+		Recorder(sigly::Scheduler &scheduler): m_scheduler(scheduler) {
+		}
+		
+		void fire(unsigned long expected) {
+			ticks.push_back(m_scheduler.now());
+			expectations.push_back(expected);
+		}
+		
+		bool onTime() const {
+			for (std::size_t i = 0; i < ticks.size(); ++i) {
+				if (ticks[i] != expectations[i]) {
+					return false;
+				}
+			}
+			
+			return true;
+		}
+		
+		std::vector<unsigned long> ticks;
+		std::vector<unsigned long> expectations;
+		
+	private:
+		sigly::Scheduler &m_scheduler;
+	};
+	
+	class Quitter : public sigly::HasSlots<> {
+	public:
+		Quitter(sigly::Scheduler &scheduler): fired(0), m_scheduler(scheduler) {
+		}
+		
+		void quit() {
+			fired = benchmark::seconds();
+			m_scheduler.quit();
+		}
+		
+		double fired;
+		
+	private:
+		sigly::Scheduler &m_scheduler;
+	};
+	
+	void *run(void *scheduler) {
+		static_cast<sigly::Scheduler *>(scheduler)->exec();
+		return NULL;
+	}
+	
+	// Timers spread over every level of the wheel, started while time moves.
+	void firesOnTime() {
+		sigly::Scheduler scheduler;
+		Recorder recorder(scheduler);
+		sigly::Signal1<unsigned long> signal;
+		signal.connect(&recorder, &Recorder::fire);
+		std::srand(1);
+		
+		for (int i = 0; i < 2000; ++i) {
+			unsigned long delay = (unsigned long)(i % 3 == 0 ? std::rand() % 300 : std::rand() % 2000000);
+			scheduler.after(delay, signal, scheduler.now() + (delay != 0 ? delay : 1));
+			
+			if (i % 7 == 0) {
+				scheduler.advance((unsigned long)(std::rand() % 5000));
+			}
+		}
+		
+		while (scheduler.pending() != 0) {
+			scheduler.advance(1ul << 20);
+		}
+		
+		check(recorder.ticks.size() == 2000, "every timer fires");
+		check(recorder.onTime(), "every timer fires on the tick it is due");
+	}
+	
+	// Stepping tick by tick through 3e9 ticks would take seconds.
+	void skipsIdleTicks() {
+		sigly::Scheduler scheduler;
+		Recorder recorder(scheduler);
+		sigly::Signal1<unsigned long> signal;
+		signal.connect(&recorder, &Recorder::fire);
+		double start = benchmark::seconds();
+		scheduler.advance(3000000000ul);
+		scheduler.after(3000000000ul, signal, scheduler.now() + 3000000000ul);
+		scheduler.advance(2999999999ul);
+		check(recorder.ticks.empty(), "a far timer does not fire early");
+		scheduler.advance(1);
+		check(recorder.ticks.size() == 1 && recorder.onTime(), "a far timer fires on the tick it is due");
+		check(benchmark::seconds() - start < 0.5, "idle ticks are skipped at once");
+	}
+	
+	// With ticks of a microsecond, waking every tick for 200 ms would take
+	// most of that time on the processor.
+	void sleepsUntilDue() {
+		sigly::Scheduler scheduler(1.0);
+		Quitter quitter(scheduler);
+		sigly::Signal0<> signal;
+		signal.connect(&quitter, &Quitter::quit);
+		scheduler.after(200000, signal);
+		std::clock_t used = std::clock();
+		double start = benchmark::seconds();
+		pthread_t thread;
+		pthread_create(&thread, NULL, &run, &scheduler);
+		pthread_join(thread, NULL);
+		double waited = quitter.fired - start;
+		used = std::clock() - used;
+		check(waited >= 0.19, "exec() does not fire a timer early");
+		check((double)used / CLOCKS_PER_SEC < 0.05, "exec() sleeps until the earliest timer");
+	}
+	
+	// exec() asleep until a far timer wakes for one started meanwhile.
+	void wakesForEarlierTimer() {
+		sigly::Scheduler scheduler;
+		Quitter quitter(scheduler);
+		sigly::Signal0<> far;
+		sigly::Signal0<> signal;
+		signal.connect(&quitter, &Quitter::quit);
+		scheduler.after(5000, far);
+		pthread_t thread;
+		pthread_create(&thread, NULL, &run, &scheduler);
+		benchmark::sleepFor(0.05);
+		double start = benchmark::seconds();
+		scheduler.after(20, signal);
+		pthread_join(thread, NULL);
+		double waited = quitter.fired - start;
+		check(waited >= 0.015 && waited < 1.0, "exec() wakes for a timer earlier than the one it sleeps until");
+	}
+}
+
+int main() {
+	firesOnTime();
+	skipsIdleTicks();
+	sleepsUntilDue();
+	wakesForEarlierTimer();
+	return g_failures != 0 ? 1 : 0;
+}
@@ -0,0 +1,251 @@
+// Checks that the emissions a SharedMemoryEmitter forwards from another
+// process reach the signals bound in the SharedMemoryPump in the order they
+// were emitted and with the bytes of their arguments, and that wake() makes
+// a waiting pump return.
+//
+// Exits with a non-zero status and prints the failed checks on failure.
+
+#define SIGLY_ENABLE_SHARED_MEMORY
+#include "sigly.h"
+#include "benchmark.h"
+
+#include <cstdio>
+#include <pthread.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+	int g_failures = 0;
+	
+	void check(bool condition, const char *what) {
+		if (!condition) {
+			std::printf("FAILED: %s\n", what);
+			++g_failures;
+		}
+	}
+	
+	enum {
+		CAPACITY = 1 << 14,
+		VALUES = 100000,
+		BLOCKS = 50,
+		BLOCK_SIZE = 3000
+	};
+	
+	enum {
+		VALUE_ID = 1,
+		PAIR_ID,
+		BLOCK_ID,
+		END_ID
+	};
+	
+	struct Block {
+		int index;
+		unsigned char bytes[BLOCK_SIZE];
+	};
+	
+	unsigned char pattern(int block, int i) {
+		return (unsigned char)(block * 13 + i * 5);
+	}
+	
+	class Sink : public sigly::HasSlots<> {
+	public:
+		Sink(): values(0), disorders(0), pairs(0), blocks(0), corruptions(0), done(false) {
+		}
+		
+		void value(int value) {
+			if (value != values) {
+				++disorders;
+			}
+			
+			++values;
+		}
+		
+		void pair(short x, double y) {
+			if (y != x * 0.5) {
+				++corruptions;
+			}
+			
+			++pairs;
+		}
+		
+		void block(const Block &block) {
+			if (block.index != blocks) {
+				++disorders;
+			}
+			
+			for (int i = 0; i < BLOCK_SIZE; ++i) {
+				if (block.bytes[i] != pattern(block.index, i)) {
+					++corruptions;
+					break;
+				}
+			}
+			
+			++blocks;
+		}
+		
+		void end() {
+			done = true;
+		}
+		
+		int values;
+		int disorders;
+		int pairs;
+		int blocks;
+		int corruptions;
+		bool done;
+	};
+	
+	// Shoots the signal until the emitter no longer drops it, so that every
+	// emission arrives and the pump can check the order.
+	template<class Emit>
+	void send(sigly::SharedMemoryEmitter &emitter, Emit emit) {
+		std::size_t dropped = emitter.dropped();
+		emit();
+		
+		while (emitter.dropped() != dropped) {
+			dropped = emitter.dropped();
+			benchmark::sleepFor(0.0001);
+			emit();
+		}
+	}
+	
+	struct EmitValue {
+		sigly::Signal1<int> *signal;
+		int value;
+		
+		void operator()() const {
+			(*signal)(value);
+		}
+	};
+	
+	struct EmitPair {
+		sigly::Signal2<short, double> *signal;
+		short x;
+		
+		void operator()() const {
+			(*signal)(x, x * 0.5);
+		}
+	};
+	
+	struct EmitBlock {
+		sigly::Signal1<const Block &> *signal;
+		const Block *block;
+		
+		void operator()() const {
+			(*signal)(*block);
+		}
+	};
+	
+	struct EmitEnd {
+		sigly::Signal0<> *signal;
+		
+		void operator()() const {
+			(*signal)();
+		}
+	};
+	
+	int emit(const char *name) {
+		sigly::SharedMemoryEmitter emitter(name, CAPACITY);
+		
+		if (!emitter.isOpen()) {
+			return 1;
+		}
+		
+		sigly::Signal1<int> value;
+		sigly::Signal2<short, double> pair;
+		sigly::Signal1<const Block &> block;
+		sigly::Signal0<> end;
+		emitter.record(value, VALUE_ID);
+		emitter.record(pair, PAIR_ID);
+		emitter.record(block, BLOCK_ID);
+		emitter.record(end, END_ID);
+		
+		for (int i = 0; i < VALUES; ++i) {
+			EmitValue emitValue = { &value, i };
+			send(emitter, emitValue);
+			
+			if (i % 10 == 0) {
+				EmitPair emitPair = { &pair, (short)(i % 1000) };
+				send(emitter, emitPair);
+			}
+		}
+		
+		static Block data;
+		
+		for (int i = 0; i < BLOCKS; ++i) {
+			data.index = i;
+			
+			for (int j = 0; j < BLOCK_SIZE; ++j) {
+				data.bytes[j] = pattern(i, j);
+			}
+			
+			EmitBlock emitBlock = { &block, &data };
+			send(emitter, emitBlock);
+		}
+		
+		EmitEnd emitEnd = { &end };
+		send(emitter, emitEnd);
+		return 0;
+	}
+	
+	void roundTrip(const char *name) {
+		sigly::SharedMemoryPump::remove(name);
+		sigly::SharedMemoryPump pump(name, CAPACITY);
+		check(pump.isOpen(), "the pump creates the ring");
+		sigly::Signal1<int> value;
+		sigly::Signal2<short, double> pair;
+		sigly::Signal1<const Block &> block;
+		sigly::Signal0<> end;
+		Sink sink;
+		value.connect(&sink, &Sink::value);
+		pair.connect(&sink, &Sink::pair);
+		block.connect(&sink, &Sink::block);
+		end.connect(&sink, &Sink::end);
+		pump.bind(VALUE_ID, value);
+		pump.bind(PAIR_ID, pair);
+		pump.bind(BLOCK_ID, block);
+		pump.bind(END_ID, end);
+		std::fflush(stdout);
+		pid_t child = fork();
+		
+		if (child == 0) {
+			_exit(emit(name));
+		}
+		
+		while (!sink.done) {
+			pump.wait();
+		}
+		
+		int status = 0;
+		waitpid(child, &status, 0);
+		check(WIFEXITED(status) && WEXITSTATUS(status) == 0, "the emitter opens the ring of the pump");
+		check(sink.values == VALUES && sink.pairs == VALUES / 10 && sink.blocks == BLOCKS, "every emission arrives");
+		check(sink.disorders == 0, "emissions arrive in the order they were emitted");
+		check(sink.corruptions == 0, "arguments arrive with their bytes");
+		sigly::SharedMemoryPump::remove(name);
+	}
+	
+	void *wakeLater(void *pump) {
+		benchmark::sleepFor(0.05);
+		static_cast<sigly::SharedMemoryPump *>(pump)->wake();
+		return NULL;
+	}
+	
+	void wakes(const char *name) {
+		sigly::SharedMemoryPump::remove(name);
+		sigly::SharedMemoryPump pump(name, CAPACITY);
+		pthread_t thread;
+		pthread_create(&thread, NULL, &wakeLater, &pump);
+		check(pump.wait() == 0, "wake() makes an idle pump return from wait()");
+		pthread_join(thread, NULL);
+		sigly::SharedMemoryPump::remove(name);
+	}
+}
+
+int main() {
+	char name[64];
+	std::sprintf(name, "/sigly_shared_memory_%ld", (long)getpid());
+	roundTrip(name);
+	wakes(name);
+	return g_failures != 0 ? 1 : 0;
+}
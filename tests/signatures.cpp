@@ -0,0 +1,116 @@
+// A program with 200 different signal signatures, for measuring how much
+// code each one adds.
+//
+// Signature N is Signal1, Signal2 or Signal3 over Value<N>, so every one is
+// a distinct instantiation. Each is connected, emitted, copied, disconnected
+// by receiver and cleared, which instantiates the bookkeeping that the
+// signatures would otherwise each compile again. code_size.sh builds this
+// file against two versions of sigly.h and compares the text sizes.
+
+#include "sigly.h"
+
+#include <cstdio>
+
+namespace {
+	enum {
+		SIGNATURES = 200
+	};
+	
+	template<int N>
+	struct Value {
+		Value(): value(N) {
+		}
+		
+		int value;
+	};
+	
+	class Receiver : public sigly::HasSlots<> {
+	public:
+		Receiver(): m_sum(0) {
+		}
+		
+		template<int N>
+		void slot1(Value<N> value) {
+			m_sum += value.value;
+		}
+		
+		template<int N>
+		void slot2(Value<N> value, int extra) {
+			m_sum += value.value + extra;
+		}
+		
+		template<int N>
+		void slot3(Value<N> value, int extra, double scale) {
+			m_sum += long((value.value + extra) * scale);
+		}
+		
+		long sum() const {
+			return m_sum;
+		}
+	
+	private:
+		long m_sum;
+	};
+	
+	template<class signal_type>
+	void cycle(signal_type &signal, Receiver &receiver) {
+		signal_type copy(signal);
+		copy.disconnect(&receiver);
+		signal.disconnectAll();
+	}
+	
+	template<int N, int arity = N % 3>
+	struct Signature;
+	
+	template<int N>
+	struct Signature<N, 0> {
+		static void exercise(Receiver &receiver) {
+			sigly::Signal1<Value<N> > signal;
+			signal.connect(&receiver, &Receiver::slot1<N>);
+			signal(Value<N>());
+			cycle(signal, receiver);
+		}
+	};
+	
+	template<int N>
+	struct Signature<N, 1> {
+		static void exercise(Receiver &receiver) {
+			sigly::Signal2<Value<N>, int> signal;
+			signal.connect(&receiver, &Receiver::slot2<N>);
+			signal(Value<N>(), 1);
+			cycle(signal, receiver);
+		}
+	};
+	
+	template<int N>
+	struct Signature<N, 2> {
+		static void exercise(Receiver &receiver) {
+			sigly::Signal3<Value<N>, int, double> signal;
+			signal.connect(&receiver, &Receiver::slot3<N>);
+			signal(Value<N>(), 1, 0.5);
+			cycle(signal, receiver);
+		}
+	};
+	
+	// Exercises signatures N - 1 down to 0.
+	template<int N>
+	struct Signatures {
+		static void exercise(Receiver &receiver) {
+			Signature<N - 1>::exercise(receiver);
+			Signatures<N - 1>::exercise(receiver);
+		}
+	};
+	
+	template<>
+	struct Signatures<0> {
+		static void exercise(Receiver &) {
+		}
+	};
+}
+
+int main() {
+	Receiver receiver;
+	Signatures<SIGNATURES>::exercise(receiver);
+	std::printf("%d signatures, sum %ld\n", int(SIGNATURES), receiver.sum());
+	return 0;
+}
@@ -0,0 +1,184 @@
+// Checks that a Strand runs the calls posted to it one at a time and in
+// order, on the threads of a ThreadPool, that AUTO_CONNECTION calls a slot
+// of the strand directly from within one of its turns, and that destroying
+// a strand takes its turn out of the executor.
+//
+// Exits with a non-zero status and prints the failed checks on failure.
+
+#include "sigly.h"
+#include "benchmark.h"
+
+#include <cstdio>
+#include <pthread.h>
+
+namespace {
+	typedef sigly::MultiThreadedLocal policy;
+	
+	int g_failures = 0;
+	
+	void check(bool condition, const char *what) {
+		if (!condition) {
+			std::printf("FAILED: %s\n", what);
+			++g_failures;
+		}
+	}
+	
+	enum {
+		EMITTERS = 3,
+		CALLS = 2000
+	};
+	
+	// The receivers of one strand share the count of the slots running, and
+	// each emitter's values must reach a receiver in the order they were
+	// posted.
+	class Receiver : public sigly::HasSlots<policy> {
+	public:
+		Receiver(volatile long &inside): overlaps(0), disorders(0), calls(0), m_inside(inside) {
+			for (int i = 0; i < EMITTERS; ++i) {
+				m_last[i] = -1;
+			}
+		}
+		
+		void call(int value) {
+			if (sigly::_atomic_increment(&m_inside) != 1) {
+				++overlaps;
+			}
+			
+			int emitter = value / CALLS;
+			
+			if (value % CALLS <= m_last[emitter]) {
+				++disorders;
+			}
+			
+			m_last[emitter] = value % CALLS;
+			sigly::_atomic_decrement(&m_inside);
+			sigly::_atomic_increment(&calls);
+		}
+		
+		int overlaps;
+		int disorders;
+		volatile long calls;
+		
+	private:
+		volatile long &m_inside;
+		int m_last[EMITTERS];
+	};
+	
+	struct Emitter {
+		sigly::Signal1<int, policy> *signal;
+		int index;
+		
+		static void *run(void *emitter) {
+			Emitter *self = static_cast<Emitter *>(emitter);
+			
+			for (int i = 0; i < CALLS; ++i) {
+				(*self->signal)(self->index * CALLS + i);
+			}
+			
+			return NULL;
+		}
+	};
+	
+	void runsInOrder() {
+		sigly::ThreadPool pool(4);
+		sigly::Strand strand(&pool);
+		volatile long inside = 0;
+		Receiver a(inside);
+		Receiver b(inside);
+		a.moveToExecutor(&strand);
+		b.moveToExecutor(&strand);
+		sigly::Signal1<int, policy> signal;
+		signal.connect(&a, &Receiver::call, sigly::QUEUED_CONNECTION);
+		signal.connect(&b, &Receiver::call, sigly::QUEUED_CONNECTION);
+		Emitter emitters[EMITTERS];
+		pthread_t threads[EMITTERS];
+		
+		for (int i = 0; i < EMITTERS; ++i) {
+			emitters[i].signal = &signal;
+			emitters[i].index = i;
+			pthread_create(&threads[i], NULL, &Emitter::run, &emitters[i]);
+		}
+		
+		for (int i = 0; i < EMITTERS; ++i) {
+			pthread_join(threads[i], NULL);
+		}
+		
+		while (sigly::_atomic_load(&a.calls) + sigly::_atomic_load(&b.calls) != 2 * EMITTERS * CALLS) {
+			benchmark::sleepFor(0.001);
+		}
+		
+		check(a.overlaps == 0 && b.overlaps == 0, "the slots of a strand never run at the same time");
+		check(a.disorders == 0 && b.disorders == 0, "a strand runs the calls of each emitter in order");
+		a.moveToExecutor(NULL);
+		b.moveToExecutor(NULL);
+	}
+	
+	// relay() shoots the next signal and records whether the slot of the
+	// target had already run when the shoot returned.
+	class Relay : public sigly::HasSlots<policy> {
+	public:
+		Relay(): next(NULL), target(NULL), calls(0), direct(false) {
+		}
+		
+		void relay(int value) {
+			(*next)(value);
+			direct = sigly::_atomic_load(&target->calls) == 1;
+		}
+		
+		void call(int) {
+			sigly::_atomic_increment(&calls);
+		}
+		
+		sigly::Signal1<int, policy> *next;
+		Relay *target;
+		volatile long calls;
+		bool direct;
+	};
+	
+	void callsAutoDirectly() {
+		sigly::EventLoop loop;
+		sigly::Strand strand(&loop);
+		Relay first;
+		Relay second;
+		first.moveToExecutor(&strand);
+		second.moveToExecutor(&strand);
+		sigly::Signal1<int, policy> signal;
+		sigly::Signal1<int, policy> next;
+		first.next = &next;
+		first.target = &second;
+		signal.connect(&first, &Relay::relay, sigly::AUTO_CONNECTION);
+		next.connect(&second, &Relay::call, sigly::AUTO_CONNECTION);
+		signal(1);
+		check(sigly::_atomic_load(&second.calls) == 0, "AUTO_CONNECTION posts from outside the strand");
+		loop.processEvents();
+		check(first.direct, "AUTO_CONNECTION calls a slot of the strand directly within a turn");
+		first.moveToExecutor(NULL);
+		second.moveToExecutor(NULL);
+	}
+	
+	// The strand is destroyed while its turn is still queued on the loop.
+	void cancelsTurns() {
+		sigly::EventLoop loop;
+		volatile long inside = 0;
+		Receiver receiver(inside);
+		{
+			sigly::Strand strand(&loop);
+			receiver.moveToExecutor(&strand);
+			sigly::Signal1<int, policy> signal;
+			signal.connect(&receiver, &Receiver::call, sigly::QUEUED_CONNECTION);
+			signal(0);
+			signal(1);
+			receiver.moveToExecutor(NULL);
+			check(loop.queueStats().size == 1, "a strand queues one turn on its executor");
+		}
+		check(loop.queueStats().size == 0, "destroying a strand takes its turn out of the executor");
+		check(loop.processEvents() == 0 && receiver.calls == 0, "nothing runs for a destroyed strand");
+	}
+}
+
+int main() {
+	runsInOrder();
+	callsAutoDirectly();
+	cancelsTurns();
+	return g_failures != 0 ? 1 : 0;
+}
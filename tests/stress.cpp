@@ -0,0 +1,297 @@
+// Randomized multi-threaded workload over the locking paths of sigly.h.
+//
+// For every multi-threaded policy and every thread count, the threads pick
+// operations at random on a shared set of signals and receivers: emit,
+// connect, disconnect, copy a receiver and destroy one. Each receiver checks
+// a canary in every slot call, so a call into an object that is not built
+// yet or already destroyed fails the run. The program prints the operations
+// per second of each kind and exits with a non-zero status on failure.
+//
+// Build it with -fsanitize=thread or -fsanitize=address (the SIGLY_SANITIZER
+// CMake option) to validate the same paths for data races and memory errors.
+//
+// Usage: sigly_stress [seconds per run] [comma-separated thread counts]
+// The defaults are 0.5 and 1,2,4,8.
+
+#include "sigly.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <pthread.h>
+#include <time.h>
+
+namespace {
+	enum Operation {
+		EMIT,
+		CONNECT,
+		DISCONNECT,
+		COPY,
+		DESTROY,
+		OPERATION_COUNT
+	};
+	
+	const char *const OPERATION_NAMES[OPERATION_COUNT] = {
+		"emit", "connect", "disconnect", "copy", "destroy"
+	};
+	
+	enum {
+		SIGNALS = 8,
+		RECEIVERS = 64,
+		LIVE = 0x5167
+	};
+	
+	volatile long g_failures = 0;
+	
+	double seconds() {
+		timespec now;
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		return now.tv_sec + now.tv_nsec / 1e9;
+	}
+	
+	// xorshift, one per thread.
+	unsigned long nextRandom(unsigned long &state) {
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		return state;
+	}
+	
+	template<class mt_policy>
+	class Receiver : public sigly::HasSlots<mt_policy> {
+	public:
+		Receiver(): m_calls(0), m_canary(LIVE) {
+		}
+		
+		Receiver(const Receiver &original): sigly::HasSlots<mt_policy>(original), m_calls(0), m_canary(LIVE) {
+		}
+		
+		~Receiver() {
+			this->disconnectAll();
+			m_canary = 0;
+		}
+		
+		void slot(int value) {
+			if (m_canary != LIVE) {
+				sigly::_atomic_increment(&g_failures);
+			}
+			
+			sigly::_atomic_increment(&m_calls);
+			(void)value;
+		}
+	
+	private:
+		volatile long m_calls;
+		volatile long m_canary;
+	};
+	
+	// Signals and receivers shared by the threads of one run. A thread takes
+	// a receiver out of its cell before using it, so that no other thread
+	// destroys it meanwhile; cells found empty are skipped.
+	template<class mt_policy>
+	class Workload {
+	public:
+		typedef sigly::Signal1<int, mt_policy> signal_type;
+		typedef Receiver<mt_policy> receiver_type;
+		
+		Workload(): m_stop(0) {
+			for (int i = 0; i < RECEIVERS; ++i) {
+				m_cells[i] = new receiver_type();
+			}
+		}
+		
+		~Workload() {
+			for (int i = 0; i < RECEIVERS; ++i) {
+				delete static_cast<receiver_type *>(m_cells[i]);
+			}
+		}
+		
+		void run(unsigned long seed, unsigned long counts[OPERATION_COUNT]) {
+			unsigned long random = seed * 2654435761ul + 1;
+			
+			while (!sigly::_atomic_load(&m_stop)) {
+				unsigned long pick = nextRandom(random);
+				signal_type &signal = m_signals[pick % SIGNALS];
+				Operation operation = choose(pick >> 8);
+				
+				if (operation == EMIT) {
+					signal(int(pick));
+					++counts[EMIT];
+					continue;
+				}
+				
+				int index = int((pick >> 16) % RECEIVERS);
+				receiver_type *receiver = take(index);
+				
+				if (receiver == NULL) {
+					continue;
+				}
+				
+				switch (operation) {
+				case CONNECT:
+					signal.connect(receiver, &receiver_type::slot);
+					break;
+				case DISCONNECT:
+					signal.disconnect(receiver);
+					break;
+				case COPY: {
+					int other = int((pick >> 24) % RECEIVERS);
+					receiver_type *replaced = other != index ? take(other) : NULL;
+					
+					if (replaced == NULL) {
+						put(index, receiver);
+						continue;
+					}
+					
+					receiver_type *copy = new receiver_type(*receiver);
+					copy->copyConnections(*receiver);
+					delete replaced;
+					put(other, copy);
+					break;
+				}
+				default:
+					delete receiver;
+					receiver = new receiver_type();
+					break;
+				}
+				
+				put(index, receiver);
+				++counts[operation];
+			}
+		}
+		
+		void stop() {
+			sigly::_atomic_exchange(&m_stop, 1);
+		}
+	
+	private:
+		// Emission dominates, as it does in programs using signals.
+		static Operation choose(unsigned long pick) {
+			unsigned long roll = pick % 100;
+			
+			if (roll < 60) {
+				return EMIT;
+			} else if (roll < 75) {
+				return CONNECT;
+			} else if (roll < 87) {
+				return DISCONNECT;
+			} else if (roll < 94) {
+				return COPY;
+			}
+			
+			return DESTROY;
+		}
+		
+		receiver_type *take(int index) {
+			return static_cast<receiver_type *>(sigly::_atomic_exchange(&m_cells[index], NULL));
+		}
+		
+		void put(int index, receiver_type *receiver) {
+			sigly::_atomic_exchange(&m_cells[index], receiver);
+		}
+		
+		signal_type m_signals[SIGNALS];
+		void *volatile m_cells[RECEIVERS];
+		volatile long m_stop;
+	};
+	
+	template<class mt_policy>
+	struct Worker {
+		Workload<mt_policy> *workload;
+		unsigned long seed;
+		unsigned long counts[OPERATION_COUNT];
+	};
+	
+	template<class mt_policy>
+	void *work(void *argument) {
+		Worker<mt_policy> *worker = static_cast<Worker<mt_policy> *>(argument);
+		worker->workload->run(worker->seed, worker->counts);
+		return NULL;
+	}
+	
+	template<class mt_policy>
+	void measure(const char *name, double duration, const std::vector<int> &threads) {
+		for (std::size_t t = 0; t < threads.size(); ++t) {
+			Workload<mt_policy> workload;
+			std::vector<Worker<mt_policy> > workers(threads[t]);
+			std::vector<pthread_t> handles(threads[t]);
+			double start = seconds();
+			
+			for (int i = 0; i < threads[t]; ++i) {
+				workers[i].workload = &workload;
+				workers[i].seed = i + 1;
+				std::memset(workers[i].counts, 0, sizeof(workers[i].counts));
+				pthread_create(&handles[i], NULL, &work<mt_policy>, &workers[i]);
+			}
+			
+			timespec pause;
+			pause.tv_sec = time_t(duration);
+			pause.tv_nsec = long((duration - pause.tv_sec) * 1e9);
+			nanosleep(&pause, NULL);
+			workload.stop();
+			
+			for (int i = 0; i < threads[t]; ++i) {
+				pthread_join(handles[i], NULL);
+			}
+			
+			double elapsed = seconds() - start;
+			std::printf("%-24s %3d threads", name, threads[t]);
+			
+			for (int op = 0; op < OPERATION_COUNT; ++op) {
+				unsigned long total = 0;
+				
+				for (int i = 0; i < threads[t]; ++i) {
+					total += workers[i].counts[op];
+				}
+				
+				std::printf("  %s %10.0f/s", OPERATION_NAMES[op], total / elapsed);
+			}
+			
+			std::printf("\n");
+			std::fflush(stdout);
+		}
+	}
+	
+	std::vector<int> parseThreads(const char *list) {
+		std::vector<int> threads;
+		
+		while (*list != '\0') {
+			char *end;
+			long count = std::strtol(list, &end, 10);
+			
+			if (end == list || count <= 0) {
+				break;
+			}
+			
+			threads.push_back(int(count));
+			list = *end == ',' ? end + 1 : end;
+		}
+		
+		return threads;
+	}
+}
+
+int main(int argc, char **argv) {
+	double duration = argc > 1 ? std::atof(argv[1]) : 0.5;
+	std::vector<int> threads = parseThreads(argc > 2 ? argv[2] : "1,2,4,8");
+	
+	if (duration <= 0 || threads.empty()) {
+		std::fprintf(stderr, "usage: %s [seconds per run] [thread counts, e.g. 1,2,4,8]\n", argv[0]);
+		return 2;
+	}
+	
+	measure<sigly::MultiThreadedGlobal>("MultiThreadedGlobal", duration, threads);
+	measure<sigly::MultiThreadedLocal>("MultiThreadedLocal", duration, threads);
+	measure<sigly::MultiThreadedSharded>("MultiThreadedSharded", duration, threads);
+	measure<sigly::MultiThreadedThin>("MultiThreadedThin", duration, threads);
+	measure<sigly::MultiThreadedReadMostly>("MultiThreadedReadMostly", duration, threads);
+	measure<sigly::Lean<sigly::MultiThreadedLocal> >("Lean<MultiThreadedLocal>", duration, threads);
+	
+	if (g_failures != 0) {
+		std::printf("FAILED: %ld slot calls reached a receiver that was not alive\n", g_failures);
+		return 1;
+	}
+	
+	return 0;
+}
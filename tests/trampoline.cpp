@@ -0,0 +1,238 @@
+// Checks that trampolined signals run a cascade of emissions one after the
+// other, in order and without growing the stack, and that destroying a
+// signal drops its deferred emissions, on the thread running the cascade or
+// on another one while the cascade is blocked.
+//
+// Exits with a non-zero status and prints the failed checks on failure.
+
+#include "sigly.h"
+
+#include <cstdio>
+#include <stdexcept>
+#include <vector>
+#include <pthread.h>
+
+namespace {
+	typedef sigly::MultiThreadedLocal policy;
+	
+	int g_failures = 0;
+	
+	void check(bool condition, const char *what) {
+		if (!condition) {
+			std::printf("FAILED: %s\n", what);
+			++g_failures;
+		}
+	}
+	
+	enum {
+		DEPTH = 200
+	};
+	
+	// Each signal of the chain shoots the next one from its slot, and the
+	// slot records how deep in the stack it runs.
+	class Chain : public sigly::HasSlots<policy> {
+	public:
+		Chain(bool trampolined): m_lowest(NULL), m_highest(NULL) {
+			for (int i = 0; i < DEPTH; ++i) {
+				m_signals[i] = new sigly::Signal1<int, policy>();
+				m_signals[i]->setTrampolined(trampolined);
+				m_signals[i]->connect(this, &Chain::link);
+			}
+		}
+		
+		~Chain() {
+			for (int i = 0; i < DEPTH; ++i) {
+				delete m_signals[i];
+			}
+		}
+		
+		void link(int i) {
+			char here;
+			
+			if (m_lowest == NULL || &here < m_lowest) {
+				m_lowest = &here;
+			}
+			
+			if (m_highest == NULL || &here > m_highest) {
+				m_highest = &here;
+			}
+			
+			order.push_back(i);
+			
+			if (i + 1 < DEPTH) {
+				m_signals[i + 1]->shoot(i + 1);
+			}
+		}
+		
+		// Bytes of stack between the deepest and the shallowest slot call.
+		long span() {
+			m_signals[0]->shoot(0);
+			return (long)(m_highest - m_lowest);
+		}
+		
+		std::vector<int> order;
+		
+	private:
+		sigly::Signal1<int, policy> *m_signals[DEPTH];
+		char *m_lowest;
+		char *m_highest;
+	};
+	
+	bool inOrder(const std::vector<int> &order) {
+		if (order.size() != DEPTH) {
+			return false;
+		}
+		
+		for (int i = 0; i < DEPTH; ++i) {
+			if (order[i] != i) {
+				return false;
+			}
+		}
+		
+		return true;
+	}
+	
+	void flattensCascade() {
+		Chain nested(false);
+		Chain flat(true);
+		long nestedSpan = nested.span();
+		long flatSpan = flat.span();
+		check(inOrder(flat.order), "a trampolined cascade runs in order");
+		check(flatSpan < 1024 && nestedSpan > 100 * flatSpan, "a trampolined cascade does not grow the stack");
+	}
+	
+	// Shoots the next signal twice, then throws.
+	class Thrower : public sigly::HasSlots<policy> {
+	public:
+		Thrower(sigly::Signal0<policy> &next): calls(0), m_next(next) {
+		}
+		
+		void shootAndThrow() {
+			++calls;
+			m_next.shoot();
+			m_next.shoot();
+			throw std::runtime_error("thrown from a slot");
+		}
+		
+		void count() {
+			++calls;
+		}
+		
+		int calls;
+		
+	private:
+		sigly::Signal0<policy> &m_next;
+	};
+	
+	void dropsAfterThrow() {
+		sigly::Signal0<policy> first;
+		sigly::Signal0<policy> next;
+		first.setTrampolined(true);
+		next.setTrampolined(true);
+		Thrower thrower(next);
+		first.connect(&thrower, &Thrower::shootAndThrow);
+		next.connect(&thrower, &Thrower::count);
+		
+		try {
+			first.shoot();
+			check(false, "the exception of a slot reaches the outermost emission");
+		} catch (const std::runtime_error &) {
+		}
+		
+		check(thrower.calls == 1, "the emissions deferred before a slot threw are dropped");
+		next.shoot();
+		check(thrower.calls == 2, "a signal whose emissions were dropped still emits");
+	}
+	
+	// Shoots the victim, then destroys it before the emission runs.
+	class Killer : public sigly::HasSlots<policy> {
+	public:
+		Killer(sigly::Signal0<policy> *victim): calls(0), m_victim(victim) {
+		}
+		
+		void kill() {
+			m_victim->shoot();
+			delete m_victim;
+		}
+		
+		void count() {
+			++calls;
+		}
+		
+		int calls;
+		
+	private:
+		sigly::Signal0<policy> *m_victim;
+	};
+	
+	void dropsOnDestruction() {
+		sigly::Signal0<policy> first;
+		sigly::Signal0<policy> *victim = new sigly::Signal0<policy>();
+		first.setTrampolined(true);
+		victim->setTrampolined(true);
+		Killer killer(victim);
+		first.connect(&killer, &Killer::kill);
+		victim->connect(&killer, &Killer::count);
+		first.shoot();
+		check(killer.calls == 0, "a signal destroyed from a slot drops its deferred emission");
+	}
+	
+	// The slot of the first signal defers an emission of the second, then
+	// blocks until the main thread has destroyed the second signal.
+	class Blocker : public sigly::HasSlots<policy> {
+	public:
+		Blocker(): calls(0), victim(NULL), stage(0) {
+		}
+		
+		void block() {
+			victim->shoot();
+			sigly::_atomic_exchange(&stage, 1);
+			
+			while (sigly::_atomic_load(&stage) != 2) {
+				sigly::_thread_yield();
+			}
+		}
+		
+		void count() {
+			++calls;
+		}
+		
+		static void *run(void *first) {
+			static_cast<sigly::Signal0<policy> *>(first)->shoot();
+			return NULL;
+		}
+		
+		int calls;
+		sigly::Signal0<policy> *victim;
+		volatile long stage;
+	};
+	
+	void dropsOnDestructionElsewhere() {
+		sigly::Signal0<policy> first;
+		Blocker blocker;
+		blocker.victim = new sigly::Signal0<policy>();
+		first.setTrampolined(true);
+		blocker.victim->setTrampolined(true);
+		first.connect(&blocker, &Blocker::block);
+		blocker.victim->connect(&blocker, &Blocker::count);
+		pthread_t thread;
+		pthread_create(&thread, NULL, &Blocker::run, &first);
+		
+		while (sigly::_atomic_load(&blocker.stage) != 1) {
+			sigly::_thread_yield();
+		}
+		
+		delete blocker.victim;
+		sigly::_atomic_exchange(&blocker.stage, 2);
+		pthread_join(thread, NULL);
+		check(blocker.calls == 0, "a signal destroyed on another thread drops the emission deferred to a blocked cascade");
+	}
+}
+
+int main() {
+	flattensCascade();
+	dropsAfterThrow();
+	dropsOnDestruction();
+	dropsOnDestructionElsewhere();
+	return g_failures != 0 ? 1 : 0;
+}
@@ -0,0 +1,122 @@
+// Checks connectUnique() and the single-slot disconnect(), and that the
+// index behind them follows every other way the connections of a signal
+// change: disconnectAll(), copying the signal, copying a receiver and
+// reordering the connections.
+//
+// Exits with a non-zero status and prints the failed checks on failure.
+
+#include "sigly.h"
+
+#include <cstdio>
+
+namespace {
+	typedef sigly::MultiThreadedLocal policy;
+	typedef sigly::Signal1<int, policy> Signal;
+	
+	int g_failures = 0;
+	
+	void check(bool condition, const char *what) {
+		if (!condition) {
+			std::printf("FAILED: %s\n", what);
+			++g_failures;
+		}
+	}
+	
+	class Receiver : public sigly::HasSlots<policy> {
+	public:
+		Receiver(): first(0), second(0) {
+		}
+		
+		void countFirst(int) {
+			++first;
+		}
+		
+		void countSecond(int) {
+			++second;
+		}
+		
+		int first;
+		int second;
+	};
+	
+	void rejectsDuplicates() {
+		Signal signal;
+		Receiver receiver;
+		check(signal.connectUnique(&receiver, &Receiver::countFirst), "connectUnique() connects a new slot");
+		check(!signal.connectUnique(&receiver, &Receiver::countFirst), "connectUnique() rejects a connected slot");
+		check(signal.connectUnique(&receiver, &Receiver::countSecond), "connectUnique() tells the slots of a receiver apart");
+		signal.connect(&receiver, &Receiver::countSecond);
+		check(!signal.connectUnique(&receiver, &Receiver::countSecond), "connectUnique() sees the slots connect() added");
+		signal(0);
+		check(receiver.first == 1 && receiver.second == 2, "a rejected slot is not connected");
+	}
+	
+	void disconnectsOneSlot() {
+		Signal signal;
+		Receiver receiver;
+		signal.connect(&receiver, &Receiver::countFirst);
+		signal.connect(&receiver, &Receiver::countSecond);
+		check(signal.disconnect(&receiver, &Receiver::countFirst), "disconnect() finds a connected slot");
+		check(!signal.disconnect(&receiver, &Receiver::countFirst), "disconnect() finds nothing once the slot is gone");
+		signal(0);
+		check(receiver.first == 0 && receiver.second == 1, "disconnect() removes that slot alone");
+		check(receiver.senderCount() == 1, "the receiver keeps the signal while another slot is connected");
+		check(signal.disconnect(&receiver, &Receiver::countSecond), "disconnect() finds the last slot");
+		check(receiver.senderCount() == 0, "the receiver forgets the signal with its last slot");
+	}
+	
+	void followsDisconnectAll() {
+		Signal signal;
+		Receiver receiver;
+		signal.connectUnique(&receiver, &Receiver::countFirst);
+		signal.disconnectAll();
+		check(signal.connectUnique(&receiver, &Receiver::countFirst), "connectUnique() connects again after disconnectAll()");
+		signal.disconnect(&receiver);
+		check(signal.connectUnique(&receiver, &Receiver::countFirst), "connectUnique() connects again after disconnect(receiver)");
+		signal(0);
+		check(receiver.first == 1, "a slot connected again is called once");
+	}
+	
+	void followsCopies() {
+		Signal signal;
+		Receiver receiver;
+		signal.connectUnique(&receiver, &Receiver::countFirst);
+		Signal copy(signal);
+		check(!copy.connectUnique(&receiver, &Receiver::countFirst), "a copied signal rejects the slots it copied");
+		check(copy.disconnect(&receiver, &Receiver::countFirst), "a copied signal disconnects the slots it copied");
+		check(!signal.connectUnique(&receiver, &Receiver::countFirst), "disconnecting from a copy leaves the original");
+		check(receiver.senderCount() == 1, "the receiver forgets the copy alone");
+		
+		Receiver duplicate(receiver);
+		duplicate.copyConnections(receiver);
+		check(!signal.connectUnique(&duplicate, &Receiver::countFirst), "a copied receiver has the slots of the original");
+		check(signal.disconnect(&duplicate, &Receiver::countFirst), "the slots of a copied receiver are disconnected alone");
+		signal(0);
+		check(receiver.first == 1 && duplicate.first == 0, "disconnecting a copied receiver leaves the original");
+	}
+	
+	void followsReordering() {
+		Signal signal;
+		Receiver a;
+		Receiver b;
+		signal.connect(&a, &Receiver::countFirst);
+		signal.connect(&b, &Receiver::countSecond);
+		signal.connect(&a, &Receiver::countSecond);
+		check(!signal.connectUnique(&a, &Receiver::countSecond), "connectUnique() rejects a connected slot");
+		signal.setDispatchOrder(sigly::GROUPED_ORDER);
+		check(signal.disconnect(&a, &Receiver::countSecond), "disconnect() finds a slot after the connections are grouped");
+		signal.setDispatchOrder(sigly::CONNECTION_ORDER);
+		check(!signal.connectUnique(&b, &Receiver::countSecond), "connectUnique() rejects a slot after the connections are ordered back");
+		signal(0);
+		check(a.first == 1 && a.second == 0 && b.second == 1, "reordering keeps the slots that stay");
+	}
+}
+
+int main() {
+	rejectsDuplicates();
+	disconnectsOneSlot();
+	followsDisconnectAll();
+	followsCopies();
+	followsReordering();
+	return g_failures != 0 ? 1 : 0;
+}